@@ -70,10 +70,9 @@ bool CIBoxBlurFilter::run (bool replace)
 	if (replace)
 	{
 		inputBitmap->setPlatformBitmap (outputBitmap);
-		return true;
+		return setOutputBitmap (inputBitmap);
 	}
-	return registerProperty (Standard::Property::kOutputBitmap,
-							 BitmapFilter::Property (owned (new CBitmap (outputBitmap))));
+	return setOutputBitmap (owned (new CBitmap (outputBitmap)));
 }
 
 //------------------------------------------------------------------------
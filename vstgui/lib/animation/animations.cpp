@@ -5,6 +5,9 @@
 #include "animations.h"
 #include "../cview.h"
 #include "../cframe.h"
+#include "../cbitmap.h"
+#include "../coffscreencontext.h"
+#include "../cgraphicstransform.h"
 #include "../controls/ccontrol.h"
 #include <cassert>
 #include <cmath>
@@ -17,6 +20,107 @@ namespace Animation {
  */
 //------------------------------------------------------------------------
 
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+/** shows a bitmap of a view instead of the view
+ *
+ *	The snapshot is inserted into the parent of the view in front of it, the view is hidden until
+ *	the snapshot is removed again.
+ */
+class SnapshotView : public CView
+{
+public:
+	static SnapshotView* create (CView* view)
+	{
+		auto frame = view->getFrame ();
+		auto parent = view->getParentView () ? view->getParentView ()->asViewContainer () : nullptr;
+		if (!frame || !parent || !hasVisibleFlag (view))
+			return nullptr;
+		const auto& viewSize = view->getViewSize ();
+		if (viewSize.getWidth () <= 0. || viewSize.getHeight () <= 0.)
+			return nullptr;
+		auto context = COffscreenContext::create (viewSize.getSize (), frame->getScaleFactor ());
+		if (!context)
+			return nullptr;
+		context->beginDraw ();
+		{
+			CDrawContext::Transform transform (
+				*context, CGraphicsTransform ().translate (-viewSize.left, -viewSize.top));
+			view->drawRect (context, viewSize);
+		}
+		context->endDraw ();
+		auto bitmap = context->getBitmap ();
+		if (!bitmap)
+			return nullptr;
+		auto snapshot = new SnapshotView (view, bitmap);
+		parent->addView (snapshot, view);
+		view->setVisible (false);
+		return snapshot;
+	}
+
+	/** move the snapshot, the bitmap is scaled to the rect */
+	void setSnapshotRect (const CRect& rect)
+	{
+		if (getViewSize () == rect)
+			return;
+		invalid ();
+		setViewSize (rect, false);
+		invalid ();
+	}
+
+	/** remove the snapshot and show the view again
+	 *
+	 *	@param applyToView if true, the view gets the size and alpha value of the snapshot
+	 */
+	void restore (bool applyToView)
+	{
+		if (applyToView)
+		{
+			if (view->getViewSize () != getViewSize ())
+			{
+				view->setViewSize (getViewSize ());
+				view->setMouseableArea (getViewSize ());
+			}
+			view->setAlphaValue (getAlphaValue ());
+		}
+		view->setVisible (true);
+		if (auto parent = getParentView ())
+			parent->asViewContainer ()->removeView (this);
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		const auto& rect = getViewSize ();
+		auto transform = CGraphicsTransform ()
+							 .scale (rect.getWidth () / bitmap->getWidth (),
+									 rect.getHeight () / bitmap->getHeight ())
+							 .translate (rect.left, rect.top);
+		CDrawContext::Transform t (*context, transform);
+		context->drawBitmap (bitmap, CRect (0., 0., bitmap->getWidth (), bitmap->getHeight ()));
+		setDirty (false);
+	}
+
+private:
+	// a view which is faded in has an alpha value of 0, so CView::isVisible can't be used
+	static bool hasVisibleFlag (const CView* view)
+	{
+		return (view->*&SnapshotView::hasViewFlag) (kVisible);
+	}
+
+	SnapshotView (CView* view, CBitmap* bitmap)
+	: CView (view->getViewSize ()), view (view), bitmap (bitmap)
+	{
+		setMouseEnabled (false);
+		setAlphaValue (view->getAlphaValue ());
+	}
+
+	SharedPointer<CView> view;
+	SharedPointer<CBitmap> bitmap;
+};
+
+} // Detail
+
 /** @class AlphaValueAnimation
 	see @ref page_animation Support */
 //-----------------------------------------------------------------------------
@@ -95,14 +199,80 @@ void ViewSizeAnimation::animationTick (CView* view, IdStringPtr name, float pos)
 	}
 }
 
+//-----------------------------------------------------------------------------
+/** @class SnapshotTransformAnimation
+	see @ref page_animation Support */
+//-----------------------------------------------------------------------------
+SnapshotTransformAnimation::SnapshotTransformAnimation (const CRect& inNewRect,
+														float endAlphaValue,
+														bool forceEndValueOnFinish)
+: newRect (inNewRect)
+, startAlphaValue (1.f)
+, endAlphaValue (endAlphaValue)
+, forceEndValueOnFinish (forceEndValueOnFinish)
+{
+}
+
+//-----------------------------------------------------------------------------
+SnapshotTransformAnimation::~SnapshotTransformAnimation () noexcept = default;
+
+//-----------------------------------------------------------------------------
+void SnapshotTransformAnimation::animationStart (CView* view, IdStringPtr name)
+{
+	startRect = view->getViewSize ();
+	startAlphaValue = view->getAlphaValue ();
+	snapshot = Detail::SnapshotView::create (view);
+}
+
+//-----------------------------------------------------------------------------
+void SnapshotTransformAnimation::animationTick (CView* view, IdStringPtr name, float pos)
+{
+	CRect r;
+	r.left = startRect.left + ((newRect.left - startRect.left) * pos);
+	r.right = startRect.right + ((newRect.right - startRect.right) * pos);
+	r.top = startRect.top + ((newRect.top - startRect.top) * pos);
+	r.bottom = startRect.bottom + ((newRect.bottom - startRect.bottom) * pos);
+	float alpha = startAlphaValue + (endAlphaValue - startAlphaValue) * pos;
+	if (snapshot)
+	{
+		snapshot->setSnapshotRect (r);
+		snapshot->setAlphaValue (alpha);
+		return;
+	}
+	if (view->getViewSize () != r)
+	{
+		view->invalid ();
+		view->setViewSize (r);
+		view->setMouseableArea (r);
+		view->invalid ();
+	}
+	view->setAlphaValue (alpha);
+}
+
+//-----------------------------------------------------------------------------
+void SnapshotTransformAnimation::animationFinished (CView* view, IdStringPtr name,
+													bool wasCanceled)
+{
+	bool applyEndValue = !wasCanceled || forceEndValueOnFinish;
+	if (applyEndValue)
+		animationTick (view, name, 1.f);
+	if (snapshot)
+	{
+		snapshot->restore (applyEndValue);
+		snapshot = nullptr;
+	}
+}
+
 //-----------------------------------------------------------------------------
 /** @class ExchangeViewAnimation
 	see @ref page_animation Support */
 //-----------------------------------------------------------------------------
-ExchangeViewAnimation::ExchangeViewAnimation (CView* oldView, CView* newView, AnimationStyle style)
+ExchangeViewAnimation::ExchangeViewAnimation (CView* oldView, CView* newView, AnimationStyle style,
+											  bool animateSnapshots)
 : newView (newView)
 , viewToRemove (oldView)
 , style (style)
+, animateSnapshots (animateSnapshots)
 {
 	vstgui_assert (newView->isAttached () == false);
 	vstgui_assert (viewToRemove->isAttached ());
@@ -118,9 +288,33 @@ ExchangeViewAnimation::~ExchangeViewAnimation () noexcept
 {
 }
 
+//-----------------------------------------------------------------------------
+Detail::SnapshotView* ExchangeViewAnimation::getSnapshot (CView* view) const
+{
+	if (view == newView)
+		return newViewSnapshot;
+	if (view == viewToRemove)
+		return viewToRemoveSnapshot;
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void ExchangeViewAnimation::updateAlphaValue (CView* view, float alpha)
+{
+	if (auto snapshot = getSnapshot (view))
+		snapshot->setAlphaValue (alpha);
+	else
+		view->setAlphaValue (alpha);
+}
+
 //-----------------------------------------------------------------------------
 void ExchangeViewAnimation::updateViewSize (CView* view, const CRect& rect)
 {
+	if (auto snapshot = getSnapshot (view))
+	{
+		snapshot->setSnapshotRect (rect);
+		return;
+	}
 	view->invalid ();
 	view->setViewSize (rect);
 	view->setMouseableArea (rect);
@@ -180,9 +374,9 @@ void ExchangeViewAnimation::init ()
 void ExchangeViewAnimation::doAlphaFade (float pos)
 {
 	float alpha = oldViewAlphaValueStart - (oldViewAlphaValueStart * pos);
-	viewToRemove->setAlphaValue (alpha);
+	updateAlphaValue (viewToRemove, alpha);
 	alpha = newViewAlphaValueEnd * pos;
-	newView->setAlphaValue (alpha);
+	updateAlphaValue (newView, alpha);
 }
 
 //-----------------------------------------------------------------------------
@@ -266,6 +460,11 @@ void ExchangeViewAnimation::animationStart (CView* view, IdStringPtr name)
 	CViewContainer* parent = viewToRemove->getParentView ()->asViewContainer ();
 	vstgui_assert (view == parent);
 	#endif
+	if (animateSnapshots)
+	{
+		newViewSnapshot = Detail::SnapshotView::create (newView);
+		viewToRemoveSnapshot = Detail::SnapshotView::create (viewToRemove);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -315,6 +514,16 @@ void ExchangeViewAnimation::animationTick (CView* view, IdStringPtr name, float
 void ExchangeViewAnimation::animationFinished (CView* view, IdStringPtr name, bool wasCanceled)
 {
 	animationTick (nullptr, nullptr, 1.f);
+	if (newViewSnapshot)
+	{
+		newViewSnapshot->restore (true);
+		newViewSnapshot = nullptr;
+	}
+	if (viewToRemoveSnapshot)
+	{
+		viewToRemoveSnapshot->restore (false);
+		viewToRemoveSnapshot = nullptr;
+	}
 	if (auto viewContainer = viewToRemove->getParentView ()->asViewContainer ())
 	{
 		viewContainer->removeView (viewToRemove);
@@ -10,6 +10,9 @@
 
 namespace VSTGUI {
 namespace Animation {
+namespace Detail {
+class SnapshotView;
+} // Detail
 
 //-----------------------------------------------------------------------------
 /// @brief animates the alpha value of the view
@@ -49,6 +52,36 @@ protected:
 	bool forceEndValueOnFinish;
 };
 
+//-----------------------------------------------------------------------------
+/// @brief animates the size, position and alpha value of a snapshot of the view
+/// @ingroup AnimationTargets
+///	@ingroup new_in_4_11
+///
+/// When the animation starts, the view and its subviews are drawn once into a bitmap which is shown
+/// instead of the view while the animation is running. Only the bitmap is moved, scaled and faded,
+/// the view is neither resized nor redrawn until the animation finishes. Use this instead of
+/// ViewSizeAnimation if the content of the view does not need to follow the animation.
+/// If the snapshot cannot be created, the view itself is animated.
+//-----------------------------------------------------------------------------
+class SnapshotTransformAnimation : public IAnimationTarget, public NonAtomicReferenceCounted
+{
+public:
+	SnapshotTransformAnimation (const CRect& newRect, float endAlphaValue = 1.f,
+								bool forceEndValueOnFinish = false);
+	~SnapshotTransformAnimation () noexcept override;
+
+	void animationStart (CView* view, IdStringPtr name) override;
+	void animationTick (CView* view, IdStringPtr name, float pos) override;
+	void animationFinished (CView* view, IdStringPtr name, bool wasCanceled) override;
+protected:
+	SharedPointer<Detail::SnapshotView> snapshot;
+	CRect startRect;
+	CRect newRect;
+	float startAlphaValue;
+	float endAlphaValue;
+	bool forceEndValueOnFinish;
+};
+
 //-----------------------------------------------------------------------------
 /// @brief exchange a view by another view with an animation
 /// @ingroup AnimationTargets
@@ -67,8 +100,12 @@ public:
 		kPushInOutFromRight
 	};
 
-	/** oldView must be a subview of the animation view */
-	ExchangeViewAnimation (CView* oldView, CView* newView, AnimationStyle style = kAlphaValueFade);
+	/** oldView must be a subview of the animation view.
+	 *	If animateSnapshots is true, both views are drawn once into bitmaps when the animation starts
+	 *	and only the bitmaps are moved and faded while the animation is running (new in 4.11).
+	 */
+	ExchangeViewAnimation (CView* oldView, CView* newView, AnimationStyle style = kAlphaValueFade,
+						   bool animateSnapshots = false);
 	~ExchangeViewAnimation () noexcept override;
 
 	void animationStart (CView* view, IdStringPtr name) override;
@@ -86,10 +123,15 @@ protected:
 	void doPushInOutFromRight (float pos);
 
 	void updateViewSize (CView* view, const CRect& rect);
+	void updateAlphaValue (CView* view, float alpha);
+	Detail::SnapshotView* getSnapshot (CView* view) const;
 
 	SharedPointer<CView> newView;
 	SharedPointer<CView> viewToRemove;
+	SharedPointer<Detail::SnapshotView> newViewSnapshot;
+	SharedPointer<Detail::SnapshotView> viewToRemoveSnapshot;
 	AnimationStyle style;
+	bool animateSnapshots;
 	float newViewAlphaValueEnd;
 	float oldViewAlphaValueStart;
 	CRect destinationRect;
@@ -46,6 +46,12 @@ the animation timing function maps elapsed time to a normalized position.
 
 see @link AnimationTimingFunctions included animation timing function classes @endlink
 
+@section value_animator The Value Animator
+For many simple animations of float values, e.g. fading every LED of a meter on its own, the
+@link VSTGUI::Animation::ValueAnimator ValueAnimator @endlink is a lighter alternative to the
+animator. It needs no target and timing function objects per animation, the animations are
+identified by a handle and all of them are advanced together on every tick.
+
 @section simple_example Simple Usage Example
 In this example the custom view animates it's alpha value when the mouse moves inside or outside the view.
 
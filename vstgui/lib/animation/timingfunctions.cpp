@@ -4,6 +4,7 @@
 
 #include "timingfunctions.h"
 #include "../vstguibase.h"
+#include <algorithm>
 #include <cmath>
 
 namespace VSTGUI {
@@ -98,32 +99,104 @@ float InterpolationTimingFunction::getPosition (uint32_t milliseconds)
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
-CubicBezierTimingFunction::CubicBezierTimingFunction (uint32_t milliseconds, CPoint p1, CPoint p2)
-: TimingFunctionBase (milliseconds), p1 (p1), p2 (p2)
+CubicBezierCurve::CubicBezierCurve (float x1, float y1, float x2, float y2)
 {
+	x1 = std::min (std::max (x1, 0.f), 1.f);
+	x2 = std::min (std::max (x2, 0.f), 1.f);
+	isLinear = x1 == y1 && x2 == y2;
+	cx = 3.f * x1;
+	bx = 3.f * (x2 - x1) - cx;
+	ax = 1.f - cx - bx;
+	cy = 3.f * y1;
+	by = 3.f * (y2 - y1) - cy;
+	ay = 1.f - cy - by;
+	for (auto i = 0u; i < kNumSamples; ++i)
+		samples[i] = sampleX (static_cast<float> (i) / static_cast<float> (kNumSamples - 1));
 }
 
 //-----------------------------------------------------------------------------
-CPoint CubicBezierTimingFunction::lerp (CPoint p1, CPoint p2, float pos)
+float CubicBezierCurve::solveX (float x) const
 {
-	return p1 * (1.f - pos) + p2 * pos;
+	constexpr auto stepSize = 1.f / static_cast<float> (kNumSamples - 1);
+	// the accepted error in t
+	constexpr auto epsilon = 1e-6f;
+	// x is monotonic in t, find the sample interval containing x and interpolate linearly
+	auto index = 0u;
+	while (index < kNumSamples - 2 && samples[index + 1] <= x)
+		++index;
+	auto intervalStart = static_cast<float> (index) * stepSize;
+	auto sampleRange = samples[index + 1] - samples[index];
+	auto t = intervalStart;
+	if (sampleRange > 0.f)
+		t += (x - samples[index]) / sampleRange * stepSize;
+
+	for (auto i = 0; i < 8; ++i)
+	{
+		auto derivative = sampleDerivativeX (t);
+		if (derivative < 0.001f)
+			break;
+		auto error = sampleX (t) - x;
+		// the error in t is about the error in x divided by the slope
+		if (std::abs (error) < epsilon * derivative)
+		{
+			if (t >= 0.f && t <= 1.f)
+				return t;
+			break;
+		}
+		t -= error / derivative;
+	}
+	// newton's method did not converge, i.e. near a point where the curve is flat in x. Use a
+	// bisection within the interval, it always converges as x is monotonic in t. 24 halvings of
+	// the interval are below the float precision of t. Near a flat point a small error in x is a
+	// large error in t, so x is calculated in double precision.
+	auto sampleXDouble = [this] (double t) { return ((ax * t + bx) * t + cx) * t; };
+	auto low = static_cast<double> (intervalStart);
+	auto high = low + stepSize;
+	auto middle = low;
+	for (auto i = 0; i < 24; ++i)
+	{
+		middle = low + (high - low) * 0.5;
+		auto error = sampleXDouble (middle) - x;
+		if (error == 0.)
+			break;
+		if (error > 0.)
+			high = middle;
+		else
+			low = middle;
+	}
+	return static_cast<float> (middle);
 }
 
 //-----------------------------------------------------------------------------
-float CubicBezierTimingFunction::getPosition (uint32_t milliseconds)
+float CubicBezierCurve::evaluate (float x) const
 {
-	constexpr CPoint p0 (0, 0);
-	constexpr CPoint p3 (1, 1);
+	if (x <= 0.f)
+		return 0.f;
+	if (x >= 1.f)
+		return 1.f;
+	if (isLinear)
+		return x;
+	return sampleY (solveX (x));
+}
 
-	auto t = static_cast<float> (milliseconds) / static_cast<float> (length);
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+CubicBezierTimingFunction::CubicBezierTimingFunction (uint32_t milliseconds, CPoint p1, CPoint p2)
+: TimingFunctionBase (milliseconds)
+, p1 (p1)
+, p2 (p2)
+, curve (static_cast<float> (p1.x), static_cast<float> (p1.y), static_cast<float> (p2.x),
+		 static_cast<float> (p2.y))
+{
+}
 
-	auto a = lerp (p0, p1, t);
-	auto b = lerp (p1, p2, t);
-	auto c = lerp (p2, p3, t);
-	auto d = lerp (a, b, t);
-	auto e = lerp (b, c, t);
-	auto result = lerp (d, e, t).y;
-	return static_cast<float> (result);
+//-----------------------------------------------------------------------------
+float CubicBezierTimingFunction::getPosition (uint32_t milliseconds)
+{
+	if (length == 0)
+		return 1.f;
+	return curve.evaluate (static_cast<float> (milliseconds) / static_cast<float> (length));
 }
 
 //-----------------------------------------------------------------------------
@@ -83,6 +83,37 @@ protected:
 	PointMap points;
 };
 
+//-----------------------------------------------------------------------------
+/// @brief CSS like cubic bezier curve from (0, 0) to (1, 1)
+///
+/// The curve maps x (the time) to y (the position). As x is not the curve parameter, the
+/// parameter for x is solved with a precomputed table of x values as first guess which is refined
+/// by newton's method or a bisection.
+///	@ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class CubicBezierCurve
+{
+public:
+	/** the x values of the control points are clamped to [0..1] */
+	CubicBezierCurve (float x1 = 0.f, float y1 = 0.f, float x2 = 1.f, float y2 = 1.f);
+
+	/** get y for x, x is clamped to [0..1] */
+	float evaluate (float x) const;
+
+private:
+	static constexpr uint32_t kNumSamples = 11;
+
+	float sampleX (float t) const { return ((ax * t + bx) * t + cx) * t; }
+	float sampleY (float t) const { return ((ay * t + by) * t + cy) * t; }
+	float sampleDerivativeX (float t) const { return (3.f * ax * t + 2.f * bx) * t + cx; }
+	float solveX (float x) const;
+
+	float ax, bx, cx;
+	float ay, by, cy;
+	float samples[kNumSamples];
+	bool isLinear;
+};
+
 //-----------------------------------------------------------------------------
 /// @ingroup AnimationTimingFunctions
 ///	@ingroup new_in_4_7
@@ -103,10 +134,9 @@ public:
 	static CubicBezierTimingFunction easyInOut (uint32_t time);
 
 private:
-	static CPoint lerp (CPoint p1, CPoint p2, float pos);
-
 	CPoint p1;
 	CPoint p2;
+	CubicBezierCurve curve;
 };
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,316 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "valueanimator.h"
+#include "timingfunctions.h"
+#include "../cvstguitimer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace VSTGUI {
+namespace Animation {
+
+//-----------------------------------------------------------------------------
+float Easing::evaluate (float time) const
+{
+	if (time <= 0.f)
+		return 0.f;
+	if (time >= 1.f)
+		return 1.f;
+	switch (type)
+	{
+		case Type::Linear:
+			return time;
+		case Type::Power:
+			return std::pow (time, params[0]);
+		case Type::CubicBezier:
+			return CubicBezierCurve (params[0], params[1], params[2], params[3]).evaluate (time);
+	}
+	return time;
+}
+
+//-----------------------------------------------------------------------------
+Easing Easing::linear ()
+{
+	return {};
+}
+
+//-----------------------------------------------------------------------------
+Easing Easing::power (float factor)
+{
+	Easing easing;
+	easing.type = Type::Power;
+	easing.params[0] = factor;
+	return easing;
+}
+
+//-----------------------------------------------------------------------------
+Easing Easing::cubicBezier (float x1, float y1, float x2, float y2)
+{
+	Easing easing;
+	easing.type = Type::CubicBezier;
+	easing.params[0] = x1;
+	easing.params[1] = y1;
+	easing.params[2] = x2;
+	easing.params[3] = y2;
+	return easing;
+}
+
+///@cond ignore
+//-----------------------------------------------------------------------------
+struct ValueAnimator::Impl
+{
+	static constexpr uint64_t kNotStarted = std::numeric_limits<uint64_t>::max ();
+
+	// the running animations, one entry per animation in every array
+	std::vector<Target> targets;
+	std::vector<uint64_t> startTimes;
+	std::vector<uint64_t> durations;
+	std::vector<float> startValues;
+	std::vector<float> valueRanges;
+	std::vector<Easing> easings;
+	// the precomputed curves of the cubic bezier easings
+	std::vector<CubicBezierCurve> curves;
+	std::vector<uint32_t> slots;
+	// scratch buffer for the positions of the current tick
+	std::vector<float> positions;
+
+	// the handles refer to slots, which map to the index of the animation in the arrays above
+	std::vector<uint32_t> slotToIndex;
+	std::vector<uint32_t> generations;
+	std::vector<uint32_t> freeSlots;
+
+	SharedPointer<CVSTGUITimer> timer;
+	uint32_t timerInterval {0};
+	bool inTick {false};
+
+	uint32_t allocateSlot (uint32_t index)
+	{
+		if (freeSlots.empty ())
+		{
+			slotToIndex.emplace_back (index);
+			generations.emplace_back (1);
+			return static_cast<uint32_t> (slotToIndex.size () - 1);
+		}
+		auto slot = freeSlots.back ();
+		freeSlots.pop_back ();
+		slotToIndex[slot] = index;
+		return slot;
+	}
+
+	void invalidateSlot (uint32_t slot)
+	{
+		if (++generations[slot] == 0)
+			generations[slot] = 1;
+	}
+
+	bool isValid (Handle handle) const
+	{
+		return handle.isValid () && handle.slot < generations.size () &&
+			   generations[handle.slot] == handle.generation;
+	}
+
+	/** mark the animation as removed, it is erased at the end of the current tick */
+	void markRemoved (uint32_t index)
+	{
+		targets[index].apply = nullptr;
+		invalidateSlot (slots[index]);
+	}
+
+	void erase (uint32_t index)
+	{
+		auto slot = slots[index];
+		invalidateSlot (slot);
+		freeSlots.emplace_back (slot);
+		auto last = static_cast<uint32_t> (targets.size () - 1);
+		if (index != last)
+		{
+			targets[index] = targets[last];
+			startTimes[index] = startTimes[last];
+			durations[index] = durations[last];
+			startValues[index] = startValues[last];
+			valueRanges[index] = valueRanges[last];
+			easings[index] = easings[last];
+			curves[index] = curves[last];
+			slots[index] = slots[last];
+			slotToIndex[slots[index]] = index;
+		}
+		targets.pop_back ();
+		startTimes.pop_back ();
+		durations.pop_back ();
+		startValues.pop_back ();
+		valueRanges.pop_back ();
+		easings.pop_back ();
+		curves.pop_back ();
+		slots.pop_back ();
+	}
+
+	void remove (uint32_t index)
+	{
+		if (inTick)
+			markRemoved (index);
+		else
+			erase (index);
+	}
+
+	bool isFinished (uint32_t index, uint64_t now) const
+	{
+		return startTimes[index] != kNotStarted && now >= startTimes[index] &&
+			   now - startTimes[index] >= durations[index];
+	}
+
+	void tick (uint64_t now)
+	{
+		inTick = true;
+		auto numAnimations = targets.size ();
+		positions.resize (numAnimations);
+		// pass 1: normalized time
+		for (auto i = 0u; i < numAnimations; ++i)
+		{
+			if (startTimes[i] == kNotStarted)
+				startTimes[i] = now;
+			auto elapsed = now > startTimes[i] ? now - startTimes[i] : 0u;
+			positions[i] = elapsed >= durations[i] ? 1.f
+												   : static_cast<float> (elapsed) /
+														 static_cast<float> (durations[i]);
+		}
+		// pass 2: easing
+		for (auto i = 0u; i < numAnimations; ++i)
+		{
+			switch (easings[i].type)
+			{
+				case Easing::Type::Linear:
+					break;
+				case Easing::Type::CubicBezier:
+					positions[i] = curves[i].evaluate (positions[i]);
+					break;
+				default:
+					positions[i] = easings[i].evaluate (positions[i]);
+					break;
+			}
+		}
+		// pass 3: values, the targets may add or remove animations
+		for (auto i = 0u; i < numAnimations; ++i)
+		{
+			// a copy, as the arrays may grow while the target is called
+			auto target = targets[i];
+			if (target.apply)
+				target.apply (target.object, target.tag, startValues[i] + valueRanges[i] * positions[i]);
+		}
+		inTick = false;
+		// pass 4: erase finished and removed animations
+		for (auto i = static_cast<uint32_t> (targets.size ()); i > 0; --i)
+		{
+			auto index = i - 1;
+			if (targets[index].apply == nullptr || isFinished (index, now))
+				erase (index);
+		}
+	}
+};
+///@endcond
+
+//-----------------------------------------------------------------------------
+ValueAnimator::ValueAnimator (uint32_t timerInterval)
+{
+	impl = std::unique_ptr<Impl> (new Impl ());
+	impl->timerInterval = timerInterval;
+}
+
+//-----------------------------------------------------------------------------
+ValueAnimator::~ValueAnimator () noexcept
+{
+	if (impl->timer)
+		impl->timer->stop ();
+}
+
+//-----------------------------------------------------------------------------
+auto ValueAnimator::add (const Target& target, float startValue, float endValue, uint64_t duration,
+						 const Easing& easing) -> Handle
+{
+	vstgui_assert (target.apply);
+	auto index = static_cast<uint32_t> (impl->targets.size ());
+	auto slot = impl->allocateSlot (index);
+	impl->targets.emplace_back (target);
+	impl->startTimes.emplace_back (Impl::kNotStarted);
+	impl->durations.emplace_back (duration);
+	impl->startValues.emplace_back (startValue);
+	impl->valueRanges.emplace_back (endValue - startValue);
+	impl->easings.emplace_back (easing);
+	if (easing.type == Easing::Type::CubicBezier)
+		impl->curves.emplace_back (easing.params[0], easing.params[1], easing.params[2],
+								   easing.params[3]);
+	else
+		impl->curves.emplace_back ();
+	impl->slots.emplace_back (slot);
+	if (impl->timerInterval)
+	{
+		if (!impl->timer)
+			impl->timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { tick (getTime ()); },
+												   impl->timerInterval);
+		else
+			impl->timer->start ();
+	}
+	return {slot, impl->generations[slot]};
+}
+
+//-----------------------------------------------------------------------------
+bool ValueAnimator::remove (Handle handle)
+{
+	if (!impl->isValid (handle))
+		return false;
+	impl->remove (impl->slotToIndex[handle.slot]);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void ValueAnimator::removeAll (void* object)
+{
+	for (auto i = static_cast<uint32_t> (impl->targets.size ()); i > 0; --i)
+	{
+		const auto& target = impl->targets[i - 1];
+		if (target.object == object && target.apply)
+			impl->remove (i - 1);
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool ValueAnimator::isRunning (Handle handle) const
+{
+	return impl->isValid (handle);
+}
+
+//-----------------------------------------------------------------------------
+size_t ValueAnimator::getNumAnimations () const
+{
+	// removed animations are only kept until the end of the tick
+	if (!impl->inTick)
+		return impl->targets.size ();
+	return static_cast<size_t> (std::count_if (impl->targets.begin (), impl->targets.end (),
+											   [] (const Target& t) { return t.apply != nullptr; }));
+}
+
+//-----------------------------------------------------------------------------
+void ValueAnimator::tick (uint64_t microseconds)
+{
+	if (impl->inTick)
+		return;
+	auto guard = shared (this);
+	impl->tick (microseconds);
+	if (impl->targets.empty () && impl->timer)
+		impl->timer->stop ();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t ValueAnimator::getTime ()
+{
+	using namespace std::chrono;
+	return static_cast<uint64_t> (
+		duration_cast<microseconds> (steady_clock::now ().time_since_epoch ()).count ());
+}
+
+} // Animation
+} // VSTGUI
@@ -0,0 +1,116 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../vstguibase.h"
+#include <memory>
+
+namespace VSTGUI {
+namespace Animation {
+
+//-----------------------------------------------------------------------------
+/// @brief Easing curve of a value animation
+///	@ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+struct Easing
+{
+	enum class Type : uint32_t
+	{
+		Linear,
+		/** pos ^ params[0] */
+		Power,
+		/** CSS like cubic bezier curve from (0, 0) to (1, 1) with the control points
+		 *	(params[0], params[1]) and (params[2], params[3])
+		 */
+		CubicBezier
+	};
+
+	Type type {Type::Linear};
+	float params[4] {};
+
+	/** map the normalized time to the normalized position */
+	float evaluate (float time) const;
+
+	static Easing linear ();
+	static Easing power (float factor);
+	static Easing cubicBezier (float x1, float y1, float x2, float y2);
+};
+
+//-----------------------------------------------------------------------------
+/// @brief Runs many simple value animations
+///
+/// A value animation interpolates a float value from a start to an end value and passes the
+/// current value on every tick to its target. In contrast to the Animator, the animations are no
+/// objects but are stored in contiguous arrays and all animations are advanced together in a few
+/// passes over these arrays, so that thousands of animations can run at the same time (i.e. fading
+/// every LED of a meter on its own). Animations are identified by a Handle instead of a view and a
+/// name.
+///
+/// The time is measured in microseconds of a monotonic clock, see getTime ().
+///	@ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class ValueAnimator : public NonAtomicReferenceCounted
+{
+public:
+	/** called with the current value of an animation */
+	using ApplyFunction = void (*) (void* object, uint32_t tag, float value);
+
+	struct Target
+	{
+		ApplyFunction apply {nullptr};
+		void* object {nullptr};
+		/** passed to the apply function to identify the animated value of the object */
+		uint32_t tag {0};
+	};
+
+	struct Handle
+	{
+		uint32_t slot {0};
+		uint32_t generation {0};
+
+		bool isValid () const { return generation != 0; }
+	};
+
+	/** the animator advances the animations every timerInterval milliseconds while animations are
+	 *	running. If timerInterval is zero, tick () must be called by the owner.
+	 */
+	explicit ValueAnimator (uint32_t timerInterval = 1000 / 60);
+	~ValueAnimator () noexcept override;
+
+	/** add an animation which starts with the next tick.
+	 *
+	 *	@param target the target of the animation
+	 *	@param startValue the value at the start of the animation
+	 *	@param endValue the value at the end of the animation
+	 *	@param duration the duration in microseconds
+	 *	@param easing the easing curve
+	 *	@return a handle to the animation
+	 */
+	Handle add (const Target& target, float startValue, float endValue, uint64_t duration,
+				const Easing& easing = Easing::linear ());
+	/** stop an animation, the target keeps its current value. Returns false if the animation
+	 *	has already finished.
+	 */
+	bool remove (Handle handle);
+	/** stop all animations of an object */
+	void removeAll (void* object);
+	/** returns true if the animation has not finished */
+	bool isRunning (Handle handle) const;
+	/** number of running animations */
+	size_t getNumAnimations () const;
+
+	/** advance all animations to the time */
+	void tick (uint64_t microseconds);
+
+	/** current time of the monotonic clock in microseconds */
+	static uint64_t getTime ();
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+} // Animation
+} // VSTGUI
@@ -3,14 +3,132 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cbitmap.h"
+#include "cbitmapcache.h"
 #include "cdrawcontext.h"
 #include "ccolor.h"
 #include "platform/iplatformbitmap.h"
 #include "platform/platformfactory.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <mutex>
 
 namespace VSTGUI {
 
+namespace {
+
+//-----------------------------------------------------------------------------
+constexpr double kScaleFactorEpsilon = 0.001;
+
+//-----------------------------------------------------------------------------
+std::mutex gScaledBitmapsMutex;
+
+//-----------------------------------------------------------------------------
+/** the source pixels covered by each destination pixel and their coverage */
+struct AreaWeights
+{
+	struct Span
+	{
+		uint32_t first;
+		uint32_t count;
+		uint32_t weightOffset;
+	};
+	std::vector<Span> spans;
+	std::vector<float> weights;
+
+	AreaWeights (uint32_t srcSize, uint32_t dstSize, double ratio)
+	{
+		spans.resize (dstSize);
+		for (uint32_t i = 0; i < dstSize; ++i)
+		{
+			auto start = i * ratio;
+			auto end = std::min ((i + 1) * ratio, static_cast<double> (srcSize));
+			auto first = static_cast<uint32_t> (start);
+			auto last = std::min (static_cast<uint32_t> (std::ceil (end)), srcSize);
+			spans[i] = {first, last - first, static_cast<uint32_t> (weights.size ())};
+			for (auto j = first; j < last; ++j)
+			{
+				auto coverage = std::min (end, j + 1.) - std::max (start, static_cast<double> (j));
+				weights.emplace_back (static_cast<float> (coverage / ratio));
+			}
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+/** scale premultiplied 32 bit pixels down, every destination pixel is the average of the source
+ *	area it covers */
+void scaleDownArea (const uint8_t* src, uint32_t srcBytesPerRow, uint32_t srcWidth,
+					uint32_t srcHeight, uint8_t* dst, uint32_t dstBytesPerRow, uint32_t dstWidth,
+					uint32_t dstHeight, double ratio)
+{
+	AreaWeights xWeights (srcWidth, dstWidth, ratio);
+	AreaWeights yWeights (srcHeight, dstHeight, ratio);
+	auto rowSize = dstWidth * 4u;
+	std::vector<float> rows (rowSize * srcHeight);
+	for (uint32_t y = 0; y < srcHeight; ++y)
+	{
+		auto srcRow = src + y * srcBytesPerRow;
+		auto row = rows.data () + y * rowSize;
+		for (uint32_t x = 0; x < dstWidth; ++x, row += 4)
+		{
+			const auto& span = xWeights.spans[x];
+			auto pixel = srcRow + span.first * 4u;
+			auto weight = xWeights.weights.data () + span.weightOffset;
+			for (uint32_t i = 0; i < span.count; ++i, pixel += 4)
+			{
+				for (auto c = 0; c < 4; ++c)
+					row[c] += pixel[c] * weight[i];
+			}
+		}
+	}
+	std::vector<float> sum (rowSize);
+	for (uint32_t y = 0; y < dstHeight; ++y)
+	{
+		const auto& span = yWeights.spans[y];
+		std::fill (sum.begin (), sum.end (), 0.f);
+		for (uint32_t i = 0; i < span.count; ++i)
+		{
+			auto row = rows.data () + (span.first + i) * rowSize;
+			auto weight = yWeights.weights[span.weightOffset + i];
+			for (uint32_t x = 0; x < rowSize; ++x)
+				sum[x] += row[x] * weight;
+		}
+		auto dstRow = dst + y * dstBytesPerRow;
+		for (uint32_t x = 0; x < rowSize; ++x)
+			dstRow[x] = static_cast<uint8_t> (std::min (sum[x] + 0.5f, 255.f));
+	}
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr createScaledPlatformBitmap (IPlatformBitmap* source, double scaleFactor)
+{
+	auto ratio = source->getScaleFactor () / scaleFactor;
+	auto srcWidth = static_cast<uint32_t> (source->getSize ().x);
+	auto srcHeight = static_cast<uint32_t> (source->getSize ().y);
+	// the last pixel is only partly covered if the size is not a multiple of the ratio
+	CPoint size (std::ceil (srcWidth / ratio - kScaleFactorEpsilon),
+				 std::ceil (srcHeight / ratio - kScaleFactorEpsilon));
+	if (size.x < 1. || size.y < 1.)
+		return nullptr;
+	auto result = getPlatformFactory ().createBitmap (size);
+	if (!result)
+		return nullptr;
+	{
+		auto srcAccess = source->lockPixels (true);
+		auto dstAccess = result->lockPixels (true);
+		if (!srcAccess || !dstAccess || srcAccess->getPixelFormat () != dstAccess->getPixelFormat ())
+			return nullptr;
+		scaleDownArea (srcAccess->getAddress (), srcAccess->getBytesPerRow (), srcWidth, srcHeight,
+					   dstAccess->getAddress (), dstAccess->getBytesPerRow (),
+					   static_cast<uint32_t> (size.x), static_cast<uint32_t> (size.y), ratio);
+	}
+	result->setScaleFactor (scaleFactor);
+	return result;
+}
+
+} // anonymous
+
 //-----------------------------------------------------------------------------
 // CBitmap Implementation
 //-----------------------------------------------------------------------------
@@ -45,8 +163,11 @@ CBitmap::CBitmap ()
 CBitmap::CBitmap (const CResourceDescription& desc)
 : resourceDesc (desc)
 {
-	if (auto platformBitmap = getPlatformFactory ().createBitmap (desc))
+	if (auto platformBitmap = CBitmapCache::instance ().loadBitmap (desc))
+	{
 		bitmaps.emplace_back (platformBitmap);
+		updateCacheRegistration ();
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -73,6 +194,14 @@ CBitmap::CBitmap (CPoint size, double scaleFactor)
 CBitmap::CBitmap (const PlatformBitmapPtr& platformBitmap)
 {
 	bitmaps.emplace_back (platformBitmap);
+	updateCacheRegistration ();
+}
+
+//-----------------------------------------------------------------------------
+CBitmap::~CBitmap () noexcept
+{
+	if (cacheState)
+		CBitmapCache::instance ().unregisterBitmap (this);
 }
 
 //-----------------------------------------------------------------------------
@@ -86,23 +215,21 @@ void CBitmap::draw (CDrawContext* context, const CRect& rect, const CPoint& offs
 //-----------------------------------------------------------------------------
 CCoord CBitmap::getWidth () const
 {
-	if (auto pb = getPlatformBitmap ())
-		return pb->getSize ().x / pb->getScaleFactor ();
-	return 0;
+	return getSize ().x;
 }
 
 //-----------------------------------------------------------------------------
 CCoord CBitmap::getHeight () const
 {
-	if (auto pb = getPlatformBitmap ())
-		return pb->getSize ().y / pb->getScaleFactor ();
-	return 0;
+	return getSize ().y;
 }
 
 //------------------------------------------------------------------------
 CPoint CBitmap::getSize () const
 {
 	CPoint p;
+	if (cacheState && CBitmapCache::instance ().getUnloadedSize (this, p))
+		return p;
 	if (auto pb = getPlatformBitmap ())
 	{
 		auto scaleFactor = pb->getScaleFactor ();
@@ -113,19 +240,49 @@ CPoint CBitmap::getSize () const
 	return p;
 }
 
+//-----------------------------------------------------------------------------
+bool CBitmap::isLoaded () const
+{
+	CPoint size;
+	if (cacheState && CBitmapCache::instance ().getUnloadedSize (this, size))
+		return true;
+	return getPlatformBitmap () ? true : false;
+}
+
 //-----------------------------------------------------------------------------
 auto CBitmap::getPlatformBitmap () const -> PlatformBitmapPtr
 {
+	if (cacheState)
+		return CBitmapCache::instance ().getPlatformBitmap (this);
 	return bitmaps.empty () ? nullptr : bitmaps[0];
 }
 
 //-----------------------------------------------------------------------------
 void CBitmap::setPlatformBitmap (const PlatformBitmapPtr& bitmap)
 {
+	CachePin pin (this);
 	if (bitmaps.empty ())
 		bitmaps.emplace_back (bitmap);
-	else
+	else if (bitmaps[0] != bitmap)
+	{
+		releaseScaledPlatformBitmaps ();
+		auto previous = std::move (bitmaps[0]);
 		bitmaps[0] = bitmap;
+		if (cacheState)
+			CBitmapCache::instance ().releaseIfUnused (std::move (previous));
+	}
+	updateCacheRegistration ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::setPlatformBitmapScaleFactor (double scaleFactor)
+{
+	CachePin pin (this);
+	if (bitmaps.empty () || bitmaps[0]->getScaleFactor () == scaleFactor)
+		return;
+	releaseScaledPlatformBitmaps ();
+	if (!cacheState || !CBitmapCache::instance ().setScaleFactor (this, scaleFactor))
+		bitmaps[0]->setScaleFactor (scaleFactor);
 }
 
 //-----------------------------------------------------------------------------
@@ -141,6 +298,7 @@ bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 		vstgui_assert (size == bitmapSize, "wrong bitmap size");
 		return false;
 	}
+	CachePin pin (this);
 	for (const auto& bitmap : bitmaps)
 	{
 		if (bitmap->getScaleFactor () == scaleFactor || bitmap == platformBitmap)
@@ -150,11 +308,22 @@ bool CBitmap::addBitmap (const PlatformBitmapPtr& platformBitmap)
 		}
 	}
 	bitmaps.emplace_back (platformBitmap);
+	updateCacheRegistration ();
+	// the new bitmap may be a better source for the scaled copies
+	releaseScaledPlatformBitmaps ();
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 auto CBitmap::getBestPlatformBitmapForScaleFactor (double scaleFactor) const -> PlatformBitmapPtr
+{
+	if (cacheState)
+		return CBitmapCache::instance ().getBestPlatformBitmap (this, scaleFactor);
+	return findBestPlatformBitmap (scaleFactor);
+}
+
+//-----------------------------------------------------------------------------
+auto CBitmap::findBestPlatformBitmap (double scaleFactor) const -> PlatformBitmapPtr
 {
 	if (bitmaps.empty ())
 		return nullptr;
@@ -174,6 +343,93 @@ auto CBitmap::getBestPlatformBitmapForScaleFactor (double scaleFactor) const ->
 	return bestBitmap;
 }
 
+//-----------------------------------------------------------------------------
+auto CBitmap::getScaledPlatformBitmap (double scaleFactor) -> PlatformBitmapPtr
+{
+	auto bestBitmap = getBestPlatformBitmapForScaleFactor (scaleFactor);
+	if (!bestBitmap || scaleFactor <= 0. ||
+		bestBitmap->getScaleFactor () <= scaleFactor + kScaleFactorEpsilon)
+		return bestBitmap;
+	auto findScaledBitmap = [&] () -> ScaledPlatformBitmap* {
+		for (auto& scaled : scaledBitmaps)
+		{
+			if (scaled.source == bestBitmap.get () &&
+				std::abs (scaled.bitmap->getScaleFactor () - scaleFactor) < kScaleFactorEpsilon)
+				return &scaled;
+		}
+		return nullptr;
+	};
+	{
+		std::lock_guard<std::mutex> guard (gScaledBitmapsMutex);
+		if (auto scaled = findScaledBitmap ())
+		{
+			scaled->lastUse = CBitmapCache::nextUseStamp ();
+			return scaled->bitmap;
+		}
+	}
+	// scaling takes a while, so it is done without holding the lock
+	auto scaledBitmap = createScaledPlatformBitmap (bestBitmap, scaleFactor);
+	if (!scaledBitmap)
+		return bestBitmap;
+	std::lock_guard<std::mutex> guard (gScaledBitmapsMutex);
+	if (auto scaled = findScaledBitmap ())
+		return scaled->bitmap;
+	scaledBitmaps.push_back ({scaledBitmap, bestBitmap.get (), CBitmapCache::nextUseStamp ()});
+	if (scaledBitmaps.size () > kMaxScaledPlatformBitmaps)
+	{
+		auto leastRecentlyUsed = std::min_element (
+			scaledBitmaps.begin (), scaledBitmaps.end (),
+			[] (const auto& lhs, const auto& rhs) { return lhs.lastUse < rhs.lastUse; });
+		scaledBitmaps.erase (leastRecentlyUsed);
+	}
+	return scaledBitmap;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::releaseScaledPlatformBitmaps ()
+{
+	std::lock_guard<std::mutex> guard (gScaledBitmapsMutex);
+	scaledBitmaps.clear ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::ensureLoaded () const
+{
+	if (cacheState)
+		CBitmapCache::instance ().reloadBitmap (const_cast<CBitmap*> (this));
+}
+
+//-----------------------------------------------------------------------------
+CBitmap::CachePin::CachePin (CBitmap* bitmap)
+: bitmap (bitmap->cacheState ? bitmap : nullptr)
+{
+	if (this->bitmap)
+		CBitmapCache::instance ().pinBitmap (this->bitmap);
+}
+
+//-----------------------------------------------------------------------------
+CBitmap::CachePin::~CachePin () noexcept
+{
+	if (bitmap)
+		CBitmapCache::instance ().unpinBitmap (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+void CBitmap::updateCacheRegistration ()
+{
+	if (cacheState)
+		return;
+	auto& cache = CBitmapCache::instance ();
+	for (const auto& bitmap : bitmaps)
+	{
+		if (cache.isCached (bitmap))
+		{
+			cache.registerBitmap (this);
+			return;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 // CNinePartTiledBitmap Implementation
 //-----------------------------------------------------------------------------
@@ -224,6 +480,87 @@ void CNinePartTiledBitmap::draw (CDrawContext* inContext, const CRect& inDestRec
 	inContext->drawBitmapNinePartTiled (this, inDestRect, offsets, inAlpha);
 }
 
+//-----------------------------------------------------------------------------
+// CMultiFrameBitmap Implementation
+//-----------------------------------------------------------------------------
+/*! @class CMultiFrameBitmap
+A multi frame bitmap holds a sequence of frames of the same size, for example the images of a knob
+animation. The frames are laid out in a grid with getNumFramesPerRow () columns:
+
+@verbatim
+|---------|---------|---------|---------|
+| Frame 0 | Frame 1 | Frame 2 | Frame 3 |
+|---------|---------|---------|---------|
+| Frame 4 | Frame 5 | Frame 6 |
+|---------|---------|---------|
+@endverbatim
+
+A classic vertical filmstrip is a multi frame bitmap with one frame per row.
+Controls implementing IMultiBitmapControl take the frame size and the number of frames from a
+multi frame bitmap when it is used as their background.
+*/
+//-----------------------------------------------------------------------------
+CMultiFrameBitmap::CMultiFrameBitmap (const CResourceDescription& desc,
+									  const CMultiFrameBitmapDescription& multiFrameDesc)
+: CBitmap (desc)
+{
+	setMultiFrameDesc (multiFrameDesc);
+}
+
+//-----------------------------------------------------------------------------
+CMultiFrameBitmap::CMultiFrameBitmap (const PlatformBitmapPtr& platformBitmap,
+									  const CMultiFrameBitmapDescription& multiFrameDesc)
+: CBitmap (platformBitmap)
+{
+	setMultiFrameDesc (multiFrameDesc);
+}
+
+//-----------------------------------------------------------------------------
+bool CMultiFrameBitmap::setMultiFrameDesc (const CMultiFrameBitmapDescription& multiFrameDesc)
+{
+	if (multiFrameDesc.numFrames == 0 || multiFrameDesc.framesPerRow == 0 ||
+		multiFrameDesc.frameSize.x <= 0. || multiFrameDesc.frameSize.y <= 0.)
+		return false;
+	auto numRows = (multiFrameDesc.numFrames + multiFrameDesc.framesPerRow - 1u) /
+				   multiFrameDesc.framesPerRow;
+	auto numColumns = std::min (multiFrameDesc.numFrames, multiFrameDesc.framesPerRow);
+	auto size = getSize ();
+	if (multiFrameDesc.frameSize.x * numColumns > size.x ||
+		multiFrameDesc.frameSize.y * numRows > size.y)
+		return false;
+	description = multiFrameDesc;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+CPoint CMultiFrameBitmap::calcFrameOffset (uint16_t frameIndex) const
+{
+	if (description.numFrames == 0)
+		return {};
+	frameIndex = std::min<uint16_t> (frameIndex, description.numFrames - 1);
+	auto column = frameIndex % description.framesPerRow;
+	auto row = frameIndex / description.framesPerRow;
+	return {description.frameSize.x * column, description.frameSize.y * row};
+}
+
+//-----------------------------------------------------------------------------
+void CMultiFrameBitmap::drawFrame (CDrawContext* context, uint16_t frameIndex, const CRect& rect,
+								   const CPoint& offset, float alpha)
+{
+	if (description.numFrames == 0)
+	{
+		draw (context, rect, offset, alpha);
+		return;
+	}
+	// never draw parts of the neighbouring frames
+	CRect r (rect);
+	r.setWidth (std::min (r.getWidth (), description.frameSize.x - offset.x));
+	r.setHeight (std::min (r.getHeight (), description.frameSize.y - offset.y));
+	if (r.isEmpty ())
+		return;
+	draw (context, r, calcFrameOffset (frameIndex) + offset, alpha);
+}
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
@@ -260,6 +597,11 @@ template <int32_t redPosition, int32_t greenPosition, int32_t bluePosition, int3
 class CBitmapPixelAccessOrder : public CBitmapPixelAccess
 {
 public:
+	CBitmapPixelAccessOrder ()
+	{
+		componentOrder = {redPosition, greenPosition, bluePosition, alphaPosition};
+	}
+
 	void getColor (CColor& c) const override
 	{
 		c.red = currentPos[redPosition];
@@ -282,6 +624,11 @@ CBitmapPixelAccess* CBitmapPixelAccess::create (CBitmap* bitmap, bool alphaPremu
 {
 	if (bitmap == nullptr || bitmap->getPlatformBitmap () == nullptr)
 		return nullptr;
+	// the scaled copies do not follow the changes to the pixels
+	bitmap->releaseScaledPlatformBitmaps ();
+	// never write into a decoded bitmap which is shared with other bitmaps
+	if (bitmap->cacheState && !CBitmapCache::instance ().makeBitmapWritable (bitmap))
+		return nullptr;
 	auto pixelAccess = bitmap->getPlatformBitmap ()->lockPixels (alphaPremultiplied);
 	if (pixelAccess == nullptr)
 		return nullptr;
@@ -294,7 +641,10 @@ CBitmapPixelAccess* CBitmapPixelAccess::create (CBitmap* bitmap, bool alphaPremu
 		case IPlatformBitmapPixelAccess::kBGRA: result = new CBitmapPixelAccessOrder<2,1,0,3> (); break;
 	}
 	if (result)
+	{
 		result->init (bitmap, pixelAccess);
+		result->alphaPremultiplied = alphaPremultiplied;
+	}
 	return result;
 }
 
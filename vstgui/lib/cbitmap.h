@@ -10,6 +10,7 @@
 #include "cresourcedescription.h"
 #include "pixelbuffer.h"
 #include "platform/iplatformbitmap.h"
+#include <memory>
 #include <vector>
 
 namespace VSTGUI {
@@ -31,7 +32,7 @@ public:
 	/** Create an image with a given size and scale factor */
 	CBitmap (CPoint size, double scaleFactor = 1.);
 	explicit CBitmap (const PlatformBitmapPtr& platformBitmap);
-	~CBitmap () noexcept override = default;
+	~CBitmap () noexcept override;
 
 	//-----------------------------------------------------------------------------
 	/// @name CBitmap Methods
@@ -46,18 +47,39 @@ public:
 	/** get size of image */
 	CPoint getSize () const;
 
-	/** check if image is loaded */
-	bool isLoaded () const { return getPlatformBitmap () ? true : false; }
+	/** check if image is loaded. A bitmap released by the CBitmapCache counts as loaded, it is
+	 *	decoded again on its next use */
+	bool isLoaded () const;
 
 	const CResourceDescription& getResourceDescription () const { return resourceDesc; }
 
 	PlatformBitmapPtr getPlatformBitmap () const;
 	void setPlatformBitmap (const PlatformBitmapPtr& bitmap);
+	/** set the scale factor of the platform bitmap. A platform bitmap shared via the CBitmapCache
+	 *	is not changed, the bitmap uses the cached platform bitmap with the scale factor instead.
+	 *	@ingroup new_in_4_11
+	 */
+	void setPlatformBitmapScaleFactor (double scaleFactor);
 
 	bool addBitmap (const PlatformBitmapPtr& platformBitmap);
 	PlatformBitmapPtr getBestPlatformBitmapForScaleFactor (double scaleFactor) const;
 
-	const_iterator begin () const { return bitmaps.begin (); }
+	/** get a platform bitmap to draw this bitmap at the scale factor.
+	 *
+	 *	If the best platform bitmap has a higher scale factor, a copy of it scaled down with an
+	 *	area filter is created the first time and returned on later calls. The copies of the
+	 *	kMaxScaledPlatformBitmaps most recently used scale factors are kept.
+	 *	@ingroup new_in_4_11
+	 */
+	PlatformBitmapPtr getScaledPlatformBitmap (double scaleFactor);
+	/** release the copies created by getScaledPlatformBitmap
+	 *	@ingroup new_in_4_11
+	 */
+	void releaseScaledPlatformBitmaps ();
+
+	static constexpr uint32_t kMaxScaledPlatformBitmaps = 2;
+
+	const_iterator begin () const { ensureLoaded (); return bitmaps.begin (); }
 	const_iterator end () const { return bitmaps.end (); }
 	//@}
 
@@ -67,6 +89,35 @@ protected:
 
 	CResourceDescription resourceDesc;
 	BitmapVector bitmaps;
+
+private:
+	friend class CBitmapCache;
+	friend class CBitmapPixelAccess;
+
+	void ensureLoaded () const;
+	void updateCacheRegistration ();
+	PlatformBitmapPtr findBestPlatformBitmap (double scaleFactor) const;
+
+	/** keeps the platform bitmaps of a cached bitmap loaded while they are changed, so that the
+	 *	cache does not release them on another thread at the same time */
+	struct CachePin
+	{
+		explicit CachePin (CBitmap* bitmap);
+		~CachePin () noexcept;
+
+		CBitmap* bitmap;
+	};
+
+	struct CacheState;
+	std::unique_ptr<CacheState> cacheState;
+
+	struct ScaledPlatformBitmap
+	{
+		PlatformBitmapPtr bitmap;
+		const IPlatformBitmap* source {nullptr};
+		uint64_t lastUse {0};
+	};
+	std::vector<ScaledPlatformBitmap> scaledBitmaps;
 };
 
 //-----------------------------------------------------------------------------
@@ -146,6 +197,57 @@ protected:
 	CNinePartTiledDescription offsets;
 };
 
+//-----------------------------------------------------------------------------
+struct CMultiFrameBitmapDescription
+{
+	/** size of one frame */
+	CPoint frameSize;
+	/** number of frames */
+	uint16_t numFrames {0};
+	/** number of frames in one row, 1 for a vertical filmstrip */
+	uint16_t framesPerRow {1};
+};
+
+//-----------------------------------------------------------------------------
+// CMultiFrameBitmap Declaration
+/// @brief a bitmap containing multiple frames of the same size
+///
+/// The frames are ordered from left to right and from top to bottom. Laying out the frames in a
+/// grid instead of one tall filmstrip keeps the platform bitmaps small enough for all backends
+/// and keeps the frames drawn one after another close in memory.
+/// @ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class CMultiFrameBitmap : public CBitmap
+{
+public:
+	CMultiFrameBitmap (const CResourceDescription& desc, const CMultiFrameBitmapDescription& multiFrameDesc);
+	CMultiFrameBitmap (const PlatformBitmapPtr& platformBitmap, const CMultiFrameBitmapDescription& multiFrameDesc);
+	~CMultiFrameBitmap () noexcept override = default;
+
+	//-----------------------------------------------------------------------------
+	/// @name Frames
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the frame layout, fails if the frames do not fit into the bitmap */
+	bool setMultiFrameDesc (const CMultiFrameBitmapDescription& multiFrameDesc);
+	const CMultiFrameBitmapDescription& getMultiFrameDesc () const { return description; }
+
+	CPoint getFrameSize () const { return description.frameSize; }
+	uint16_t getNumFrames () const { return description.numFrames; }
+	uint16_t getNumFramesPerRow () const { return description.framesPerRow; }
+
+	/** returns the top left position of a frame inside the bitmap */
+	CPoint calcFrameOffset (uint16_t frameIndex) const;
+	/** draw one frame into rect, offset is relative to the top left of the frame */
+	void drawFrame (CDrawContext* context, uint16_t frameIndex, const CRect& rect,
+					const CPoint& offset = CPoint (0, 0), float alpha = 1.f);
+	//@}
+
+//-----------------------------------------------------------------------------
+protected:
+	CMultiFrameBitmapDescription description;
+};
+
 //------------------------------------------------------------------------
 /** Convert between Platform Pixel Accessor pixel format and PixelBuffer format */
 template<typename T1, typename T2,
@@ -195,6 +297,33 @@ public:
 	inline uint32_t getBitmapWidth () const { return maxX+1; }
 	inline uint32_t getBitmapHeight () const { return maxY+1; }
 
+	//-----------------------------------------------------------------------------
+	/// @name Row Access
+	//-----------------------------------------------------------------------------
+	//@{
+	/** byte positions of the components within a pixel */
+	struct ComponentOrder
+	{
+		uint8_t red;
+		uint8_t green;
+		uint8_t blue;
+		uint8_t alpha;
+	};
+	/** @ingroup new_in_4_11 */
+	inline ComponentOrder getComponentOrder () const { return componentOrder; }
+	/** true if the color components are premultiplied with the alpha component
+	 *	@ingroup new_in_4_11
+	 */
+	inline bool isAlphaPremultiplied () const { return alphaPremultiplied; }
+	/** @ingroup new_in_4_11 */
+	inline uint32_t getBytesPerRow () const { return bytesPerRow; }
+	/** get the pixels of a row, every pixel is one uint32_t with its components in the order of
+	 *	getComponentOrder (). y must be smaller than getBitmapHeight ().
+	 *	@ingroup new_in_4_11
+	 */
+	inline uint32_t* getRow (uint32_t y) const;
+	//@}
+
 	inline IPlatformBitmapPixelAccess* getPlatformBitmapPixelAccess () const { return pixelAccess; }
 	/** create an accessor.
 		can return 0 if platform implementation does not support this.
@@ -215,6 +344,8 @@ protected:
 	uint32_t maxY;
 	uint32_t x;
 	uint32_t y;
+	ComponentOrder componentOrder {};
+	bool alphaPremultiplied {true};
 };
 
 //------------------------------------------------------------------------
@@ -247,6 +378,12 @@ inline bool CBitmapPixelAccess::setPosition (uint32_t _x, uint32_t _y)
 	return true;
 }
 
+//------------------------------------------------------------------------
+inline uint32_t* CBitmapPixelAccess::getRow (uint32_t row) const
+{
+	return reinterpret_cast<uint32_t*> (address + row * bytesPerRow);
+}
+
 //------------------------------------------------------------------------
 inline void CBitmapPixelAccess::getValue (uint32_t& value)
 {
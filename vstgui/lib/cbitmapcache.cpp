@@ -0,0 +1,664 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cbitmapcache.h"
+#include "platform/iplatformbitmap.h"
+#include "platform/platformfactory.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CBitmapCache Implementation
+//-----------------------------------------------------------------------------
+/*! @class CBitmapCache
+All bitmaps loaded via a CResourceDescription, and the bitmaps of the UIDescription, are decoded
+through the cache. Bitmaps with the same source (resource, file path or encoded memory content)
+share one decoded platform bitmap.
+
+Without a memory budget a decoded bitmap is released as soon as no CBitmap uses it anymore. With a
+memory budget unused bitmaps stay decoded as long as they fit into the budget, and if the budget is
+exceeded the platform bitmaps of the CBitmaps which were not drawn for the longest time are released.
+Those CBitmaps keep their size and decode their bitmaps again when they are used the next time.
+
+Only CBitmaps whose platform bitmaps are all owned by the cache can be released. Creating a
+CBitmapPixelAccess for a shared bitmap gives the CBitmap its own copy first.
+
+Any thread which loads or decodes a bitmap again may release the platform bitmaps of other
+CBitmaps. This only happens while the cache lock is held, and a CBitmap gets its platform bitmaps
+for drawing under the same lock. A CBitmap is pinned while its platform bitmaps are changed, so
+they are not released at the same time.
+*/
+
+//-----------------------------------------------------------------------------
+struct CBitmapCache::Impl
+{
+	enum class SourceType
+	{
+		Resource,
+		ResourceID,
+		Path,
+		Memory
+	};
+
+	struct Entry
+	{
+		std::string key;
+		/** the key without the scale factor */
+		std::string sourceKey;
+		/** the scale factor set on the decoded bitmap, 0 to keep the one of the decoder */
+		double scaleFactor {0.};
+		SourceType type {SourceType::Resource};
+		std::string name;
+		int32_t id {0};
+		std::vector<uint8_t> data;
+
+		PlatformBitmapPtr bitmap;
+		uint64_t bytes {0};
+		uint64_t lastUse {0};
+		uint32_t unloadedUsers {0};
+	};
+
+	using EntryMap = std::unordered_map<std::string, Entry>;
+
+	EntryMap entries;
+	std::unordered_map<const IPlatformBitmap*, Entry*> residentEntries;
+	std::unordered_set<CBitmap*> bitmaps;
+	Statistics statistics;
+	uint64_t budget {0};
+	std::atomic<bool> enabled {true};
+	mutable std::mutex mutex;
+
+	//-----------------------------------------------------------------------------
+	static PlatformBitmapPtr decode (const Entry& entry)
+	{
+		const auto& factory = getPlatformFactory ();
+		switch (entry.type)
+		{
+			case SourceType::Resource:
+				return factory.createBitmap (CResourceDescription (entry.name.data ()));
+			case SourceType::ResourceID:
+				return factory.createBitmap (CResourceDescription (entry.id));
+			case SourceType::Path: return factory.createBitmapFromPath (entry.name.data ());
+			case SourceType::Memory:
+				return factory.createBitmapFromMemory (entry.data.data (),
+													   static_cast<uint32_t> (entry.data.size ()));
+		}
+		return nullptr;
+	}
+
+	//-----------------------------------------------------------------------------
+	static std::string makeKey (const std::string& sourceKey, double scaleFactor)
+	{
+		if (scaleFactor <= 0.)
+			return sourceKey;
+		return sourceKey + "@" + std::to_string (scaleFactor);
+	}
+
+	//-----------------------------------------------------------------------------
+	static uint64_t calcBytes (IPlatformBitmap* bitmap)
+	{
+		const auto& size = bitmap->getSize ();
+		return static_cast<uint64_t> (size.x) * static_cast<uint64_t> (size.y) * 4u;
+	}
+
+	//-----------------------------------------------------------------------------
+	bool makeResident (Entry& entry)
+	{
+		++statistics.misses;
+		entry.bitmap = decode (entry);
+		if (!entry.bitmap)
+			return false;
+		// the bitmap is not shared yet
+		if (entry.scaleFactor > 0.)
+			entry.bitmap->setScaleFactor (entry.scaleFactor);
+		entry.bytes = calcBytes (entry.bitmap);
+		entry.lastUse = nextUseStamp ();
+		residentEntries.emplace (entry.bitmap.get (), &entry);
+		statistics.residentBytes += entry.bytes;
+		statistics.peakResidentBytes =
+			std::max (statistics.peakResidentBytes, statistics.residentBytes);
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------
+	/** releases the decoded bitmap of the entry, the entry itself may be deleted */
+	void release (Entry& entry, bool isEviction)
+	{
+		if (entry.bitmap)
+		{
+			residentEntries.erase (entry.bitmap.get ());
+			statistics.residentBytes -= entry.bytes;
+			entry.bitmap = nullptr;
+			if (isEviction)
+				++statistics.evictions;
+		}
+		if (entry.unloadedUsers == 0)
+		{
+			auto key = entry.key;
+			entries.erase (key);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	bool isUnused (const Entry& entry) const
+	{
+		return entry.bitmap && entry.bitmap->getNbReference () == 1;
+	}
+
+	//-----------------------------------------------------------------------------
+	void releaseIfUnused (PlatformBitmapPtr&& platformBitmap)
+	{
+		auto it = residentEntries.find (platformBitmap.get ());
+		platformBitmap = nullptr;
+		if (it == residentEntries.end ())
+			return;
+		auto& entry = *it->second;
+		if (!isUnused (entry))
+			return;
+		if (budget == 0)
+			release (entry, false);
+		else
+			entry.lastUse = nextUseStamp ();
+	}
+
+	//-----------------------------------------------------------------------------
+	PlatformBitmapPtr load (std::string&& sourceKey, double scaleFactor,
+							const std::function<void (Entry&)>& initEntry)
+	{
+		if (!enabled)
+		{
+			Entry entry;
+			initEntry (entry);
+			auto platformBitmap = decode (entry);
+			if (platformBitmap && scaleFactor > 0.)
+				platformBitmap->setScaleFactor (scaleFactor);
+			return platformBitmap;
+		}
+		std::lock_guard<std::mutex> guard (mutex);
+		return loadLocked (std::move (sourceKey), scaleFactor, initEntry);
+	}
+
+	//-----------------------------------------------------------------------------
+	PlatformBitmapPtr loadLocked (std::string&& sourceKey, double scaleFactor,
+								  const std::function<void (Entry&)>& initEntry,
+								  const CBitmap* keep = nullptr)
+	{
+		auto key = makeKey (sourceKey, scaleFactor);
+		auto it = entries.find (key);
+		if (it == entries.end ())
+		{
+			it = entries.emplace (key, Entry ()).first;
+			it->second.key = std::move (key);
+			it->second.sourceKey = std::move (sourceKey);
+			it->second.scaleFactor = scaleFactor;
+			initEntry (it->second);
+		}
+		auto& entry = it->second;
+		if (entry.bitmap)
+		{
+			++statistics.hits;
+			entry.lastUse = nextUseStamp ();
+			return entry.bitmap;
+		}
+		if (!makeResident (entry))
+		{
+			release (entry, false);
+			return nullptr;
+		}
+		PlatformBitmapPtr result = entry.bitmap;
+		trimToBudget (keep);
+		return result;
+	}
+
+	//-----------------------------------------------------------------------------
+	bool isEvictable (CBitmap* bitmap, const CBitmap* keep) const
+	{
+		// a pinned bitmap may be changed while the lock is not held, its platform bitmaps are not
+		// accessed
+		if (bitmap == keep || bitmap->cacheState->pinCount > 0 ||
+			!bitmap->cacheState->unloaded.empty () || bitmap->bitmaps.empty ())
+			return false;
+		for (const auto& platformBitmap : bitmap->bitmaps)
+		{
+			if (residentEntries.find (platformBitmap.get ()) == residentEntries.end ())
+				return false;
+		}
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------
+	void unload (CBitmap* bitmap)
+	{
+		auto& state = *bitmap->cacheState;
+		// CBitmap::getSize would take the lock again
+		const auto& firstBitmap = bitmap->bitmaps[0];
+		state.size = firstBitmap->getSize ();
+		state.size.x /= firstBitmap->getScaleFactor ();
+		state.size.y /= firstBitmap->getScaleFactor ();
+		std::vector<Entry*> usedEntries;
+		for (const auto& platformBitmap : bitmap->bitmaps)
+		{
+			auto entry = residentEntries[platformBitmap.get ()];
+			++entry->unloadedUsers;
+			state.unloaded.push_back (entry->key);
+			usedEntries.emplace_back (entry);
+		}
+		bitmap->bitmaps.clear ();
+		bitmap->releaseScaledPlatformBitmaps ();
+		for (auto entry : usedEntries)
+		{
+			if (isUnused (*entry))
+				release (*entry, true);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	void trim (uint64_t maxResidentBytes, const CBitmap* keep = nullptr)
+	{
+		if (statistics.residentBytes <= maxResidentBytes)
+			return;
+
+		std::vector<Entry*> unusedEntries;
+		for (const auto& it : residentEntries)
+		{
+			if (isUnused (*it.second))
+				unusedEntries.emplace_back (it.second);
+		}
+		std::sort (unusedEntries.begin (), unusedEntries.end (),
+				   [] (const Entry* lhs, const Entry* rhs) { return lhs->lastUse < rhs->lastUse; });
+		for (auto entry : unusedEntries)
+		{
+			if (statistics.residentBytes <= maxResidentBytes)
+				return;
+			release (*entry, true);
+		}
+
+		std::vector<CBitmap*> candidates;
+		for (auto bitmap : bitmaps)
+		{
+			if (isEvictable (bitmap, keep))
+				candidates.emplace_back (bitmap);
+		}
+		std::sort (candidates.begin (), candidates.end (),
+				   [] (const CBitmap* lhs, const CBitmap* rhs) {
+					   return lhs->cacheState->lastUse.load () < rhs->cacheState->lastUse.load ();
+				   });
+		for (auto bitmap : candidates)
+		{
+			if (statistics.residentBytes <= maxResidentBytes)
+				return;
+			unload (bitmap);
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	void reload (CBitmap* bitmap)
+	{
+		auto& state = *bitmap->cacheState;
+		if (state.unloaded.empty ())
+			return;
+		auto unloadedBitmaps = std::move (state.unloaded);
+		state.unloaded.clear ();
+		for (const auto& key : unloadedBitmaps)
+		{
+			auto it = entries.find (key);
+			if (it == entries.end ())
+				continue;
+			auto& entry = it->second;
+			--entry.unloadedUsers;
+			if (entry.bitmap)
+			{
+				++statistics.hits;
+				entry.lastUse = nextUseStamp ();
+			}
+			else if (!makeResident (entry))
+			{
+				release (entry, false);
+				continue;
+			}
+			bitmap->bitmaps.emplace_back (entry.bitmap);
+		}
+		state.lastUse = nextUseStamp ();
+		trimToBudget (bitmap);
+	}
+
+	//-----------------------------------------------------------------------------
+	void trimToBudget (const CBitmap* keep = nullptr)
+	{
+		if (budget > 0)
+			trim (budget, keep);
+	}
+};
+
+//-----------------------------------------------------------------------------
+CBitmapCache::CBitmapCache ()
+{
+	impl = std::unique_ptr<Impl> (new Impl);
+}
+
+//-----------------------------------------------------------------------------
+CBitmapCache::~CBitmapCache () noexcept = default;
+
+//-----------------------------------------------------------------------------
+CBitmapCache& CBitmapCache::instance ()
+{
+	static CBitmapCache gInstance;
+	return gInstance;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CBitmapCache::nextUseStamp ()
+{
+	static std::atomic<uint64_t> gUseStamp {0};
+	return ++gUseStamp;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::setMemoryBudget (uint64_t bytes)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->budget = bytes;
+	if (bytes > 0)
+	{
+		impl->trim (bytes);
+		return;
+	}
+	std::vector<Impl::Entry*> unusedEntries;
+	for (const auto& it : impl->residentEntries)
+	{
+		if (impl->isUnused (*it.second))
+			unusedEntries.emplace_back (it.second);
+	}
+	for (auto entry : unusedEntries)
+		impl->release (*entry, false);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CBitmapCache::getMemoryBudget () const
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	return impl->budget;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::trim (uint64_t maxResidentBytes)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->trim (maxResidentBytes);
+}
+
+//-----------------------------------------------------------------------------
+auto CBitmapCache::getStatistics () const -> Statistics
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	auto result = impl->statistics;
+	result.numEntries = static_cast<uint32_t> (impl->entries.size ());
+	result.numResidentEntries = static_cast<uint32_t> (impl->residentEntries.size ());
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::resetStatistics ()
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->statistics.hits = 0;
+	impl->statistics.misses = 0;
+	impl->statistics.evictions = 0;
+	impl->statistics.peakResidentBytes = impl->statistics.residentBytes;
+}
+
+//-----------------------------------------------------------------------------
+static PlatformBitmapPtr withScaleFactor (PlatformBitmapPtr&& platformBitmap, double scaleFactor)
+{
+	if (platformBitmap && scaleFactor > 0.)
+		platformBitmap->setScaleFactor (scaleFactor);
+	return std::move (platformBitmap);
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr CBitmapCache::loadBitmap (const CResourceDescription& desc, double scaleFactor)
+{
+	if (desc.type == CResourceDescription::kStringType && desc.u.name)
+	{
+		return impl->load (std::string ("r:") + desc.u.name, scaleFactor, [&] (Impl::Entry& entry) {
+			entry.type = Impl::SourceType::Resource;
+			entry.name = desc.u.name;
+		});
+	}
+	if (desc.type == CResourceDescription::kIntegerType)
+	{
+		return impl->load ("i:" + std::to_string (desc.u.id), scaleFactor, [&] (Impl::Entry& entry) {
+			entry.type = Impl::SourceType::ResourceID;
+			entry.id = desc.u.id;
+		});
+	}
+	return withScaleFactor (getPlatformFactory ().createBitmap (desc), scaleFactor);
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr CBitmapCache::loadBitmapFromPath (UTF8StringPtr absolutePath, double scaleFactor)
+{
+	if (absolutePath == nullptr)
+		return nullptr;
+	return impl->load (std::string ("p:") + absolutePath, scaleFactor, [&] (Impl::Entry& entry) {
+		entry.type = Impl::SourceType::Path;
+		entry.name = absolutePath;
+	});
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr CBitmapCache::loadBitmapFromMemory (const void* ptr, uint32_t memSize,
+													  double scaleFactor)
+{
+	if (ptr == nullptr || memSize == 0)
+		return nullptr;
+	// FNV-1a
+	auto bytes = static_cast<const uint8_t*> (ptr);
+	uint64_t hash = 14695981039346656037ull;
+	for (uint32_t i = 0; i < memSize; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	auto key = "m:" + std::to_string (hash) + ":" + std::to_string (memSize);
+	{
+		std::lock_guard<std::mutex> guard (impl->mutex);
+		auto it = impl->entries.find (Impl::makeKey (key, scaleFactor));
+		if (it != impl->entries.end () && std::memcmp (it->second.data.data (), ptr, memSize) != 0)
+		{
+			// hash collision, don't share the bitmap
+			return withScaleFactor (getPlatformFactory ().createBitmapFromMemory (ptr, memSize),
+									scaleFactor);
+		}
+	}
+	return impl->load (std::move (key), scaleFactor, [&] (Impl::Entry& entry) {
+		entry.type = Impl::SourceType::Memory;
+		entry.data.assign (bytes, bytes + memSize);
+	});
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::setEnabled (bool state)
+{
+	impl->enabled = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapCache::isEnabled () const
+{
+	return impl->enabled;
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapCache::isCached (IPlatformBitmap* platformBitmap) const
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	return impl->residentEntries.find (platformBitmap) != impl->residentEntries.end ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::registerBitmap (CBitmap* bitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	bitmap->cacheState = std::unique_ptr<CBitmap::CacheState> (new CBitmap::CacheState);
+	bitmap->cacheState->lastUse = nextUseStamp ();
+	impl->bitmaps.emplace (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::unregisterBitmap (CBitmap* bitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->bitmaps.erase (bitmap);
+	for (const auto& key : bitmap->cacheState->unloaded)
+	{
+		auto it = impl->entries.find (key);
+		if (it == impl->entries.end ())
+			continue;
+		--it->second.unloadedUsers;
+		if (!it->second.bitmap)
+			impl->release (it->second, false);
+	}
+	bitmap->cacheState->unloaded.clear ();
+	auto platformBitmaps = std::move (bitmap->bitmaps);
+	bitmap->bitmaps.clear ();
+	for (auto& platformBitmap : platformBitmaps)
+		impl->releaseIfUnused (std::move (platformBitmap));
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::releaseIfUnused (PlatformBitmapPtr&& platformBitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->releaseIfUnused (std::move (platformBitmap));
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::reloadBitmap (CBitmap* bitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->reload (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr CBitmapCache::getPlatformBitmap (const CBitmap* bitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->reload (const_cast<CBitmap*> (bitmap));
+	return bitmap->bitmaps.empty () ? nullptr : bitmap->bitmaps[0];
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr CBitmapCache::getBestPlatformBitmap (const CBitmap* bitmap, double scaleFactor)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	impl->reload (const_cast<CBitmap*> (bitmap));
+	bitmap->cacheState->lastUse = nextUseStamp ();
+	return bitmap->findBestPlatformBitmap (scaleFactor);
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapCache::getUnloadedSize (const CBitmap* bitmap, CPoint& size) const
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	if (bitmap->cacheState->unloaded.empty ())
+		return false;
+	size = bitmap->cacheState->size;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::pinBitmap (CBitmap* bitmap)
+{
+	if (!bitmap->cacheState)
+		return;
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	++bitmap->cacheState->pinCount;
+	impl->reload (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapCache::unpinBitmap (CBitmap* bitmap)
+{
+	if (!bitmap->cacheState)
+		return;
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	vstgui_assert (bitmap->cacheState->pinCount > 0);
+	--bitmap->cacheState->pinCount;
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapCache::setScaleFactor (CBitmap* bitmap, double scaleFactor)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	auto& platformBitmap = bitmap->bitmaps[0];
+	auto it = impl->residentEntries.find (platformBitmap.get ());
+	if (it == impl->residentEntries.end ())
+		return false;
+	auto& entry = *it->second;
+	auto key = Impl::makeKey (entry.sourceKey, scaleFactor);
+	if (entry.bitmap->getNbReference () == 2 && entry.unloadedUsers == 0 &&
+		impl->entries.find (key) == impl->entries.end ())
+	{
+		// the bitmap is the only user, the entry is moved to the key of the scale factor
+		auto node = impl->entries.extract (entry.key);
+		node.key () = key;
+		node.mapped ().key = key;
+		node.mapped ().scaleFactor = scaleFactor;
+		node.mapped ().bitmap->setScaleFactor (scaleFactor);
+		impl->entries.insert (std::move (node));
+		return true;
+	}
+	auto scaledBitmap = impl->loadLocked (
+		std::string (entry.sourceKey), scaleFactor,
+		[&] (Impl::Entry& newEntry) {
+			newEntry.type = entry.type;
+			newEntry.name = entry.name;
+			newEntry.id = entry.id;
+			newEntry.data = entry.data;
+		},
+		bitmap);
+	if (!scaledBitmap)
+		return true;
+	auto previous = std::move (platformBitmap);
+	platformBitmap = scaledBitmap;
+	impl->releaseIfUnused (std::move (previous));
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapCache::makeBitmapWritable (CBitmap* bitmap)
+{
+	std::lock_guard<std::mutex> guard (impl->mutex);
+	if (bitmap->bitmaps.empty ())
+		return false;
+	auto& platformBitmap = bitmap->bitmaps[0];
+	auto it = impl->residentEntries.find (platformBitmap.get ());
+	if (it == impl->residentEntries.end ())
+		return true;
+	auto& entry = *it->second;
+	if (entry.bitmap->getNbReference () == 2 && entry.unloadedUsers == 0)
+	{
+		// the bitmap is the only user, it takes over the decoded bitmap
+		impl->release (entry, false);
+		return true;
+	}
+	auto copy = Impl::decode (entry);
+	if (!copy)
+		return false;
+	copy->setScaleFactor (platformBitmap->getScaleFactor ());
+	auto previous = std::move (platformBitmap);
+	platformBitmap = copy;
+	impl->releaseIfUnused (std::move (previous));
+	return true;
+}
+
+} // VSTGUI
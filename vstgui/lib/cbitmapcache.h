@@ -0,0 +1,146 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cbitmap.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CBitmapCache Declaration
+/// @brief process wide cache of decoded platform bitmaps
+/// @ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class CBitmapCache
+{
+public:
+	struct Statistics
+	{
+		/** bytes of all decoded platform bitmaps owned by the cache */
+		uint64_t residentBytes {0};
+		/** the maximum of residentBytes since the last reset */
+		uint64_t peakResidentBytes {0};
+		/** number of loads which could use an already decoded bitmap */
+		uint64_t hits {0};
+		/** number of loads which had to decode the bitmap */
+		uint64_t misses {0};
+		/** number of decoded bitmaps released to stay in the memory budget */
+		uint64_t evictions {0};
+		/** number of bitmaps known to the cache */
+		uint32_t numEntries {0};
+		/** number of bitmaps currently decoded */
+		uint32_t numResidentEntries {0};
+	};
+
+	static CBitmapCache& instance ();
+
+	//-----------------------------------------------------------------------------
+	/// @name Memory Budget
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the memory budget in bytes. If the resident bytes exceed the budget, unused bitmaps
+	 *	and the platform bitmaps of CBitmaps that were not drawn recently are released. Released
+	 *	bitmaps are decoded again on their next use. A budget of 0 (the default) disables
+	 *	eviction and unused bitmaps are released immediately.
+	 */
+	void setMemoryBudget (uint64_t bytes);
+	uint64_t getMemoryBudget () const;
+
+	/** release decoded bitmaps until the resident bytes are below maxResidentBytes */
+	void trim (uint64_t maxResidentBytes);
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Statistics
+	//-----------------------------------------------------------------------------
+	//@{
+	Statistics getStatistics () const;
+	void resetStatistics ();
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Loading
+	//-----------------------------------------------------------------------------
+	//@{
+	/** load a bitmap or share an already decoded one with the same resource description.
+	 *
+	 *	The shared platform bitmaps must not be changed. A scaleFactor greater than 0 is set on the
+	 *	decoded bitmap, bitmaps are only shared with loads of the same scale factor.
+	 */
+	PlatformBitmapPtr loadBitmap (const CResourceDescription& desc, double scaleFactor = 0.);
+	/** load a bitmap or share an already decoded one with the same path */
+	PlatformBitmapPtr loadBitmapFromPath (UTF8StringPtr absolutePath, double scaleFactor = 0.);
+	/** load a bitmap or share an already decoded one with the same encoded content */
+	PlatformBitmapPtr loadBitmapFromMemory (const void* ptr, uint32_t memSize,
+											double scaleFactor = 0.);
+
+	/** check if the platform bitmap is owned by the cache */
+	bool isCached (IPlatformBitmap* platformBitmap) const;
+
+	/** enable or disable sharing. While disabled every load decodes a new platform bitmap which
+	 *	is not owned by the cache, i.e. when the bitmaps are used by several threads which each
+	 *	have their own views. Enabled by default.
+	 */
+	void setEnabled (bool state);
+	bool isEnabled () const;
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Pinning
+	//-----------------------------------------------------------------------------
+	//@{
+	/** decode the platform bitmaps of the bitmap if they were released and keep them decoded
+	 *	until unpinBitmap is called. A pinned bitmap can be drawn on another thread. */
+	void pinBitmap (CBitmap* bitmap);
+	void unpinBitmap (CBitmap* bitmap);
+	//@}
+
+//-----------------------------------------------------------------------------
+private:
+	CBitmapCache ();
+	~CBitmapCache () noexcept;
+
+	friend class CBitmap;
+	friend class CBitmapPixelAccess;
+
+	static uint64_t nextUseStamp ();
+
+	void registerBitmap (CBitmap* bitmap);
+	void unregisterBitmap (CBitmap* bitmap);
+	void releaseIfUnused (PlatformBitmapPtr&& platformBitmap);
+	void reloadBitmap (CBitmap* bitmap);
+	/** the first platform bitmap of the bitmap, decoded again if it was released */
+	PlatformBitmapPtr getPlatformBitmap (const CBitmap* bitmap);
+	/** the best platform bitmap of the bitmap for the scale factor, decoded again if it was
+	 *	released */
+	PlatformBitmapPtr getBestPlatformBitmap (const CBitmap* bitmap, double scaleFactor);
+	/** returns false if the platform bitmaps of the bitmap are loaded */
+	bool getUnloadedSize (const CBitmap* bitmap, CPoint& size) const;
+	bool makeBitmapWritable (CBitmap* bitmap);
+	bool setScaleFactor (CBitmap* bitmap, double scaleFactor);
+
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+/// @cond ignore
+//-----------------------------------------------------------------------------
+struct CBitmap::CacheState
+{
+	/** the keys of the platform bitmaps released by the cache, empty if the bitmap is loaded */
+	std::vector<std::string> unloaded;
+	/** the size of the bitmap while it is unloaded */
+	CPoint size;
+	std::atomic<uint64_t> lastUse {0};
+	/** the bitmap is not released while pinned */
+	uint32_t pinCount {0};
+};
+/// @endcond
+
+} // VSTGUI
@@ -14,6 +14,13 @@
 #include <memory>
 #include <climits>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VSTGUI_BITMAPFILTER_SSE2 1
+#include <emmintrin.h>
+#else
+#define VSTGUI_BITMAPFILTER_SSE2 0
+#endif
+
 namespace VSTGUI {
 
 namespace BitmapFilter {
@@ -374,6 +381,13 @@ bool FilterBase::registerProperty (IdStringPtr name, const Property& defaultProp
 	return properties.emplace (name, defaultProperty).second;
 }
 
+//----------------------------------------------------------------------------------------------------
+bool FilterBase::setOutputBitmap (CBitmap* bitmap)
+{
+	properties[Standard::Property::kOutputBitmap] = Property (bitmap);
+	return true;
+}
+
 //----------------------------------------------------------------------------------------------------
 CBitmap* FilterBase::getInputBitmap () const
 {
@@ -386,6 +400,107 @@ CBitmap* FilterBase::getInputBitmap () const
 	return nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------
+namespace {
+
+//----------------------------------------------------------------------------------------------------
+SharedPointer<CBitmap> copyBitmap (CBitmap* bitmap)
+{
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	if (platformBitmap == nullptr)
+		return nullptr;
+	auto copy = makeOwned<CBitmap> (CPoint (bitmap->getWidth (), bitmap->getHeight ()),
+									platformBitmap->getScaleFactor ());
+	auto inputAccessor = owned (CBitmapPixelAccess::create (bitmap));
+	auto outputAccessor = owned (CBitmapPixelAccess::create (copy));
+	if (inputAccessor == nullptr || outputAccessor == nullptr)
+		return nullptr;
+	auto inputOrder = inputAccessor->getComponentOrder ();
+	auto outputOrder = outputAccessor->getComponentOrder ();
+	if (memcmp (&inputOrder, &outputOrder, sizeof (inputOrder)) == 0)
+	{
+		auto width = std::min (inputAccessor->getBitmapWidth (), outputAccessor->getBitmapWidth ());
+		auto height = std::min (inputAccessor->getBitmapHeight (), outputAccessor->getBitmapHeight ());
+		for (auto y = 0u; y < height; ++y)
+			memcpy (outputAccessor->getRow (y), inputAccessor->getRow (y), width * sizeof (uint32_t));
+	}
+	else
+	{
+		CColor color;
+		do
+		{
+			inputAccessor->getColor (color);
+			outputAccessor->setColor (color);
+		} while (++(*inputAccessor) && ++(*outputAccessor));
+	}
+	return copy;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool processPixels (CBitmap* bitmap, IPixelFilter* const* filters, size_t numFilters)
+{
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	if (accessor == nullptr)
+		return false;
+	auto order = accessor->getComponentOrder ();
+	auto width = accessor->getBitmapWidth ();
+	// all filters process a row before the next row is processed, so that the pixels are only
+	// loaded once into the cache
+	for (auto y = 0u; y < accessor->getBitmapHeight (); ++y)
+	{
+		auto row = accessor->getRow (y);
+		for (auto i = 0u; i < numFilters; ++i)
+			filters[i]->processRow (row, width, order);
+	}
+	return true;
+}
+
+} // anonymous
+
+//----------------------------------------------------------------------------------------------------
+bool runFilters (CBitmap* bitmap, const FilterList& filters)
+{
+	if (bitmap == nullptr)
+		return false;
+	SharedPointer<CBitmap> current (bitmap);
+	std::vector<IPixelFilter*> pixelFilters;
+	auto result = true;
+	auto processPixelFilters = [&] () {
+		if (pixelFilters.empty ())
+			return;
+		if (!processPixels (current, pixelFilters.data (), pixelFilters.size ()))
+			result = false;
+		pixelFilters.clear ();
+	};
+	for (const auto& filter : filters)
+	{
+		if (auto pixelFilter = dynamic_cast<IPixelFilter*> (filter.get ()))
+		{
+			if (pixelFilter->prepareProcessing ())
+				pixelFilters.emplace_back (pixelFilter);
+			else
+				result = false;
+			continue;
+		}
+		processPixelFilters ();
+		filter->setProperty (Standard::Property::kInputBitmap, current.get ());
+		if (!filter->run (true) && !filter->run (false))
+		{
+			result = false;
+			continue;
+		}
+		const auto& outputProperty = filter->getProperty (Standard::Property::kOutputBitmap);
+		if (outputProperty.getType () != Property::kObject)
+			continue;
+		if (auto outputBitmap = dynamic_cast<CBitmap*> (outputProperty.getObject ()))
+			current = outputBitmap;
+	}
+	processPixelFilters ();
+	if (current != bitmap)
+		bitmap->setPlatformBitmap (current->getPlatformBitmap ());
+	return result;
+}
+
 ///@cond ignore
 namespace Standard {
 
@@ -425,7 +540,7 @@ private:
 		if (radius < 2)
 		{
 			if (replace)
-				return true;
+				return setOutputBitmap (inputBitmap);
 			return false; // TODO: We should just copy the input bitmap to the output bitmap
 		}
 		const auto& alphaChannelOnlyProp = getProperty (Property::kAlphaChannelOnly);
@@ -438,7 +553,7 @@ private:
 			if (inputAccessor == nullptr)
 				return false;
 			run (*inputAccessor, *inputAccessor, radius, alphaChannelOnly);
-			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (inputBitmap));
+			return setOutputBitmap (inputBitmap);
 		}
 		SharedPointer<CBitmap> outputBitmap = owned (new CBitmap (inputBitmap->getWidth (), inputBitmap->getHeight ()));
 		if (outputBitmap)
@@ -449,7 +564,7 @@ private:
 				return false;
 
 			run (*inputAccessor, *outputAccessor, radius, alphaChannelOnly);
-			return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
+			return setOutputBitmap (outputBitmap);
 		}
 		return false;
 	}
@@ -707,7 +822,7 @@ protected:
 		if (inputAccessor == nullptr || outputAccessor == nullptr)
 			return false;
 		process (*inputAccessor, *outputAccessor);
-		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
+		return setOutputBitmap (outputBitmap);
 	}
 	
 	virtual void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) = 0;
@@ -834,82 +949,80 @@ private:
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-using SimpleFilterProcessFunction = void (*) (CColor& color, FilterBase* self);
-
-template<typename SimpleFilterProcessFunction>
-class SimpleFilter : public FilterBase
+class SimpleFilter : public FilterBase, public IPixelFilter
 {
 protected:
-	SimpleFilter (UTF8StringPtr description, SimpleFilterProcessFunction function)
+	SimpleFilter (UTF8StringPtr description)
 	: FilterBase (description)
-	, processFunction (function)
 	{
 		registerProperty (Property::kInputBitmap, BitmapFilter::Property (BitmapFilter::Property::kObject));
 	}
 
 	bool run (bool replace) override
 	{
+		if (!prepareProcessing ())
+			return false;
 		SharedPointer<CBitmap> inputBitmap = getInputBitmap ();
 		if (inputBitmap == nullptr)
 			return false;
-		SharedPointer<CBitmapPixelAccess> inputAccessor = owned (CBitmapPixelAccess::create (inputBitmap));
-		if (inputAccessor == nullptr)
+		SharedPointer<CBitmap> outputBitmap = replace ? inputBitmap : copyBitmap (inputBitmap);
+		if (outputBitmap == nullptr)
 			return false;
-		SharedPointer<CBitmap> outputBitmap;
-		SharedPointer<CBitmapPixelAccess> outputAccessor;
-		if (replace == false)
-		{
-			outputBitmap = owned (new CBitmap (inputBitmap->getWidth (), inputBitmap->getHeight ()));
-			if (outputBitmap == nullptr)
-				return false;
-			outputAccessor = owned (CBitmapPixelAccess::create (outputBitmap));
-			if (outputAccessor == nullptr)
-				return false;
-		}
-		else
-		{
-			outputBitmap = inputBitmap;
-			outputAccessor = inputAccessor;
-		}
-		run (*inputAccessor, *outputAccessor);
-		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
+		IPixelFilter* filter = this;
+		if (!processPixels (outputBitmap, &filter, 1))
+			return false;
+		return setOutputBitmap (outputBitmap);
 	}
+};
+
+//----------------------------------------------------------------------------------------------------
+inline uint32_t packPixel (const CColor& color, const IPixelFilter::ComponentOrder& order)
+{
+	uint8_t components[4];
+	components[order.red] = color.red;
+	components[order.green] = color.green;
+	components[order.blue] = color.blue;
+	components[order.alpha] = color.alpha;
+	uint32_t pixel;
+	memcpy (&pixel, components, sizeof (pixel));
+	return pixel;
+}
+
+//----------------------------------------------------------------------------------------------------
+inline uint32_t alphaMask (const IPixelFilter::ComponentOrder& order)
+{
+	return packPixel (CColor (0, 0, 0, 255), order);
+}
 
-	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
+#if VSTGUI_BITMAPFILTER_SSE2
+//----------------------------------------------------------------------------------------------------
+template<typename VectorProc, typename ScalarProc>
+inline void forEachPixel (uint32_t* pixels, uint32_t numPixels, VectorProc vectorProc,
+						  ScalarProc scalarProc)
+{
+	uint32_t i = 0;
+	for (; i + 4 <= numPixels; i += 4)
 	{
-		inputAccessor.setPosition (0, 0);
-		outputAccessor.setPosition (0, 0);
-		CColor color;
-		if (&inputAccessor == &outputAccessor)
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-			}
-			while (++inputAccessor);
-		}
-		else
-		{
-			do
-			{
-				inputAccessor.getColor (color);
-				processFunction (color, this);
-				outputAccessor.setColor (color);
-				++outputAccessor;
-			}
-			while (++inputAccessor);
-		}
+		auto p = reinterpret_cast<__m128i*> (pixels + i);
+		_mm_storeu_si128 (p, vectorProc (_mm_loadu_si128 (p)));
 	}
-
-	SimpleFilterProcessFunction processFunction;
-};
+	for (; i < numPixels; ++i)
+		pixels[i] = scalarProc (pixels[i]);
+}
+#else
+//----------------------------------------------------------------------------------------------------
+template<typename ScalarProc>
+inline void forEachPixel (uint32_t* pixels, uint32_t numPixels, ScalarProc scalarProc)
+{
+	for (uint32_t i = 0; i < numPixels; ++i)
+		pixels[i] = scalarProc (pixels[i]);
+}
+#endif
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class SetColor : public SimpleFilter<SimpleFilterProcessFunction>
+class SetColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr _name)
@@ -919,24 +1032,16 @@ public:
 
 private:
 	SetColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Set Color Filter", processSetColor)
+	: SimpleFilter ("A Set Color Filter")
 	{
 		registerProperty (Property::kIgnoreAlphaColorValue, BitmapFilter::Property ((int32_t)1));
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 	}
 
-	static void processSetColor (CColor& color, FilterBase* obj)
-	{
-		SetColor* filter = static_cast<SetColor*> (obj);
-		if (filter->ignoreAlpha)
-			filter->inputColor.alpha = color.alpha;
-		color = filter->inputColor;
-	}
-
 	bool ignoreAlpha;
 	CColor inputColor;
 
-	bool run (bool replace) override
+	bool prepareProcessing () override
 	{
 		const auto& inputColorProp = getProperty (Property::kInputColor);
 		const auto& ignoreAlphaProp = getProperty (Property::kIgnoreAlphaColorValue);
@@ -945,14 +1050,32 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		ignoreAlpha = ignoreAlphaProp.getInteger () > 0;
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return true;
+	}
+
+	void processRow (uint32_t* pixels, uint32_t numPixels, const ComponentOrder& order) const override
+	{
+		// keep the bits of the mask from the pixel, take all others from the color
+		auto keepMask = ignoreAlpha ? alphaMask (order) : 0u;
+		auto color = packPixel (inputColor, order) & ~keepMask;
+		auto scalarProc = [&] (uint32_t pixel) { return (pixel & keepMask) | color; };
+#if VSTGUI_BITMAPFILTER_SSE2
+		auto keepMask4 = _mm_set1_epi32 (static_cast<int32_t> (keepMask));
+		auto color4 = _mm_set1_epi32 (static_cast<int32_t> (color));
+		auto vectorProc = [&] (__m128i pixel) {
+			return _mm_or_si128 (_mm_and_si128 (pixel, keepMask4), color4);
+		};
+		forEachPixel (pixels, numPixels, vectorProc, scalarProc);
+#else
+		forEachPixel (pixels, numPixels, scalarProc);
+#endif
 	}
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class Grayscale : public SimpleFilter<SimpleFilterProcessFunction>
+class Grayscale : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -962,21 +1085,59 @@ public:
 
 private:
 	Grayscale ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Grayscale Filter", processGrayscale)
+	: SimpleFilter ("A Grayscale Filter")
 	{
 	}
 
-	static void processGrayscale (CColor& color, FilterBase* obj)
+	bool prepareProcessing () override { return true; }
+
+	void processRow (uint32_t* pixels, uint32_t numPixels, const ComponentOrder& order) const override
 	{
-		color.red = color.green = color.blue = color.getLuma ();
+		// same computation as CColor::getLuma ()
+		auto scalarProc = [&] (uint32_t pixel) {
+			uint8_t components[4];
+			memcpy (components, &pixel, sizeof (pixel));
+			auto luma = static_cast<uint8_t> (static_cast<float> (components[order.red]) * 0.3f +
+											  static_cast<float> (components[order.green]) * 0.59f +
+											  static_cast<float> (components[order.blue]) * 0.11f);
+			components[order.red] = components[order.green] = components[order.blue] = luma;
+			memcpy (&pixel, components, sizeof (pixel));
+			return pixel;
+		};
+#if VSTGUI_BITMAPFILTER_SSE2
+		// SSE2 is only available on little endian CPUs, so the byte position is the shift / 8
+		auto redShift = _mm_cvtsi32_si128 (order.red * 8);
+		auto greenShift = _mm_cvtsi32_si128 (order.green * 8);
+		auto blueShift = _mm_cvtsi32_si128 (order.blue * 8);
+		auto alphaMask4 = _mm_set1_epi32 (static_cast<int32_t> (alphaMask (order)));
+		auto byteMask = _mm_set1_epi32 (0xff);
+		auto redFactor = _mm_set1_ps (0.3f);
+		auto greenFactor = _mm_set1_ps (0.59f);
+		auto blueFactor = _mm_set1_ps (0.11f);
+		auto vectorProc = [&] (__m128i pixel) {
+			auto component = [&] (__m128i shift) {
+				return _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (pixel, shift), byteMask));
+			};
+			auto lumaF = _mm_add_ps (_mm_add_ps (_mm_mul_ps (component (redShift), redFactor),
+												 _mm_mul_ps (component (greenShift), greenFactor)),
+									 _mm_mul_ps (component (blueShift), blueFactor));
+			auto luma = _mm_cvttps_epi32 (lumaF);
+			auto result = _mm_and_si128 (pixel, alphaMask4);
+			result = _mm_or_si128 (result, _mm_sll_epi32 (luma, redShift));
+			result = _mm_or_si128 (result, _mm_sll_epi32 (luma, greenShift));
+			return _mm_or_si128 (result, _mm_sll_epi32 (luma, blueShift));
+		};
+		forEachPixel (pixels, numPixels, vectorProc, scalarProc);
+#else
+		forEachPixel (pixels, numPixels, scalarProc);
+#endif
 	}
-
 };
 
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
-class ReplaceColor : public SimpleFilter<SimpleFilterProcessFunction>
+class ReplaceColor : public SimpleFilter
 {
 public:
 	static IFilter* CreateFunction (IdStringPtr name)
@@ -986,23 +1147,16 @@ public:
 
 private:
 	ReplaceColor ()
-	: SimpleFilter<SimpleFilterProcessFunction> ("A Replace Color Filter", processReplace)
+	: SimpleFilter ("A Replace Color Filter")
 	{
 		registerProperty (Property::kInputColor, BitmapFilter::Property (kWhiteCColor));
 		registerProperty (Property::kOutputColor, BitmapFilter::Property (kTransparentCColor));
 	}
 
-	static void processReplace (CColor& color, FilterBase* obj)
-	{
-		ReplaceColor* filter = static_cast<ReplaceColor*> (obj);
-		if (color == filter->inputColor)
-			color = filter->outputColor;
-	}
-
 	CColor inputColor;
 	CColor outputColor;
 
-	bool run (bool replace) override
+	bool prepareProcessing () override
 	{
 		const auto& inputColorProp = getProperty (Property::kInputColor);
 		const auto& outputColorProp = getProperty (Property::kOutputColor);
@@ -1011,7 +1165,25 @@ private:
 			return false;
 		inputColor = inputColorProp.getColor ();
 		outputColor = outputColorProp.getColor ();
-		return SimpleFilter<SimpleFilterProcessFunction>::run (replace);
+		return true;
+	}
+
+	void processRow (uint32_t* pixels, uint32_t numPixels, const ComponentOrder& order) const override
+	{
+		auto input = packPixel (inputColor, order);
+		auto output = packPixel (outputColor, order);
+		auto scalarProc = [&] (uint32_t pixel) { return pixel == input ? output : pixel; };
+#if VSTGUI_BITMAPFILTER_SSE2
+		auto input4 = _mm_set1_epi32 (static_cast<int32_t> (input));
+		auto output4 = _mm_set1_epi32 (static_cast<int32_t> (output));
+		auto vectorProc = [&] (__m128i pixel) {
+			auto match = _mm_cmpeq_epi32 (pixel, input4);
+			return _mm_or_si128 (_mm_and_si128 (match, output4), _mm_andnot_si128 (match, pixel));
+		};
+		forEachPixel (pixels, numPixels, vectorProc, scalarProc);
+#else
+		forEachPixel (pixels, numPixels, scalarProc);
+#endif
 	}
 };
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "vstguifwd.h"
+#include "cbitmap.h"
 #include <vector>
 #include <string>
 #include <map>
@@ -85,6 +86,45 @@ public:
 	using CreateFunction = IFilter* (*) (IdStringPtr name);
 };
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Pixel Filter Interface
+/// @ingroup new_in_4_11
+/// @details Filters which compute every pixel only from its own value can implement this interface
+/// in addition to IFilter. runFilters executes consecutive pixel filters in one pass over the
+/// pixels.
+//----------------------------------------------------------------------------------------------------
+class IPixelFilter
+{
+public:
+	using ComponentOrder = CBitmapPixelAccess::ComponentOrder;
+
+	virtual ~IPixelFilter () noexcept = default;
+
+	/** read the properties of the filter, returns false if they are not valid */
+	virtual bool prepareProcessing () = 0;
+	/** process the pixels of a row in place, the pixels are alpha premultiplied */
+	virtual void processRow (uint32_t* pixels, uint32_t numPixels,
+							 const ComponentOrder& order) const = 0;
+};
+
+using FilterList = std::vector<SharedPointer<IFilter>>;
+
+//----------------------------------------------------------------------------------------------------
+/** run filters one after the other on a bitmap
+ *
+ *	Every filter gets the output of the previous filter as input bitmap. Consecutive filters
+ *	implementing IPixelFilter are executed together in one pass over the pixels, all other filters
+ *	are run in place if they support it. At the end the bitmap gets the platform bitmap of the
+ *	output of the last filter.
+ *	A filter which fails is skipped.
+ *
+ *	@param bitmap the bitmap to process
+ *	@param filters the filters to run
+ *	@return true if all filters succeeded
+ *	@ingroup new_in_4_11
+ */
+bool runFilters (CBitmap* bitmap, const FilterList& filters);
+
 //----------------------------------------------------------------------------------------------------
 /// @brief Bitmap Filter Factory.
 /// @ingroup new_in_4_1
@@ -215,6 +255,8 @@ protected:
 
 	bool registerProperty (IdStringPtr name, const Property& defaultProperty);
 	CBitmap* getInputBitmap () const;
+	/** set the Standard::Property::kOutputBitmap property, registers it if needed */
+	bool setOutputBitmap (CBitmap* bitmap);
 
 	UTF8StringPtr getDescription () const override;
 	bool setProperty (IdStringPtr name, const Property& property) override;
@@ -120,6 +120,7 @@ void CDataBrowser::setViewSize (const CRect& size, bool invalid)
 {
 	if (getViewSize () != size)
 	{
+		invalidateColumnLayout ();
 		CScrollView::setViewSize (size, invalid);
 		recalculateLayout (true);
 	}
@@ -224,6 +225,8 @@ void CDataBrowser::valueChanged (CControl *pControl)
 void CDataBrowser::recalculateSubViews ()
 {
 	CScrollView::recalculateSubViews ();
+	// the column widths may depend on the visibility of the scrollbars
+	invalidateColumnLayout ();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -238,15 +241,11 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 	CCoord rowHeight = db->dbGetRowHeight (this);
 	CCoord headerHeight = db->dbGetHeaderHeight (this);
 	int32_t numRows = db->dbGetNumRows (this);
-	int32_t numColumns = db->dbGetNumColumns (this);
 	CCoord allRowsHeight = rowHeight * numRows;
 	if (style & kDrawRowLines)
 		allRowsHeight += numRows * lineWidth;
-	CCoord allColumnsWidth = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-		allColumnsWidth += db->dbGetCurrentColumnWidth (i, this);
-	if (style & kDrawColumnLines)
-		allColumnsWidth += numColumns * lineWidth;
+	updateColumnLayout ();
+	CCoord allColumnsWidth = columnOffsets.back ();
 	CRect newContainerSize (0, 0, allColumnsWidth, allRowsHeight);
 	if (style & kDrawHeader)
 	{
@@ -289,6 +288,8 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 		if (newContainerSize != getContainerSize ())
 			setContainerSize (newContainerSize, true);
 	}
+	// the column widths may depend on the size of the container and on the scrollbars it shows
+	updateColumnLayout ();
 	newContainerSize.offset (getScrollOffset ().x, -getScrollOffset ().y);
 	dbView->setViewSize (newContainerSize);
 	dbView->setMouseableArea (newContainerSize);
@@ -302,7 +303,7 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 
 	if (style & kDrawHeader)
 	{
-		for (const auto& pV : getChildren ())
+		for (const auto& pV : getChildViews ())
 		{
 			CRect viewSize = pV->getViewSize ();
 			if (pV != dbHeaderContainer && viewSize.top < headerHeight+lineWidth)
@@ -334,6 +335,51 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 		unselectAll ();
 }
 
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::updateColumnLayout ()
+{
+	CCoord lineWidth = 0;
+	if (style & kDrawColumnLines)
+	{
+		CColor lineColor;
+		db->dbGetLineWidthAndColor (lineWidth, lineColor, this);
+	}
+	auto numColumns = static_cast<size_t> (std::max<int32_t> (0, db->dbGetNumColumns (this)));
+	columnWidths.resize (numColumns);
+	columnOffsets.resize (numColumns + 1);
+	columnOffsets[0] = 0.;
+	for (size_t i = 0; i < numColumns; i++)
+	{
+		columnWidths[i] = db->dbGetCurrentColumnWidth (static_cast<int32_t> (i), this);
+		columnOffsets[i + 1] = columnOffsets[i] + columnWidths[i] + lineWidth;
+	}
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::validateColumnLayout ()
+{
+	auto numColumns = static_cast<size_t> (std::max<int32_t> (0, db->dbGetNumColumns (this)));
+	if (columnOffsets.empty () || columnWidths.size () != numColumns)
+		updateColumnLayout ();
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::invalidateColumnLayout ()
+{
+	columnOffsets.clear ();
+	columnWidths.clear ();
+}
+
+//-----------------------------------------------------------------------------------------------
+int32_t CDataBrowser::getColumnAt (CCoord x)
+{
+	validateColumnLayout ();
+	if (columnWidths.empty () || x < 0 || x >= columnOffsets.back ())
+		return -1;
+	auto it = std::upper_bound (columnOffsets.begin () + 1, columnOffsets.end (), x);
+	return static_cast<int32_t> (std::distance (columnOffsets.begin () + 1, it));
+}
+
 //-----------------------------------------------------------------------------------------------
 /**
  * @param cell cell to invalidate
@@ -379,24 +425,22 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 		index = numRows-1;
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
-	{
-		selection.erase (alreadySelected);
-		hasChanged = !selection.empty ();
-	}
+	if (isRowSelected (index))
+		hasChanged = selection.size () - numUnselectedEntries > 1;
 	else
-	{
 		invalidateRow (index);
-	}
 	
 	for (auto row : selection)
 	{
-		dbView->invalidateRow (row);
+		if (row != index && isRowSelected (row))
+			dbView->invalidateRow (row);
 	}
 	selection.clear ();
+	selectedRows.clear ();
+	numUnselectedEntries = 0;
 	
 	selection.emplace_back (index);
+	setRowSelectedState (index, true);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -407,22 +451,75 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 //-----------------------------------------------------------------------------------------------
 int32_t CDataBrowser::getSelectedRow () const
 {
+	compactSelection ();
 	if (!selection.empty ())
 		return selection[0];
 	return kNoSelection;
 }
 
+//-----------------------------------------------------------------------------------------------
+const CDataBrowser::Selection& CDataBrowser::getSelection () const
+{
+	compactSelection ();
+	return selection;
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::compactSelection () const
+{
+	if (numUnselectedEntries == 0)
+		return;
+	// a row which was unselected and selected again has more than one entry, only its last entry
+	// is kept. The membership bits of kept rows are cleared while walking back to skip the earlier
+	// entries and are restored afterwards.
+	Selection compacted;
+	compacted.reserve (selection.size () - numUnselectedEntries);
+	for (auto it = selection.rbegin (); it != selection.rend (); ++it)
+	{
+		auto row = *it;
+		if (isRowSelected (row))
+		{
+			selectedRows[row] = false;
+			compacted.emplace_back (row);
+		}
+	}
+	for (auto row : compacted)
+		selectedRows[row] = true;
+	selection.assign (compacted.rbegin (), compacted.rend ());
+	numUnselectedEntries = 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+bool CDataBrowser::isRowSelected (int32_t row) const
+{
+	return row >= 0 && static_cast<size_t> (row) < selectedRows.size () && selectedRows[row];
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setRowSelectedState (int32_t row, bool state)
+{
+	if (row < 0)
+		return;
+	if (static_cast<size_t> (row) >= selectedRows.size ())
+	{
+		if (!state)
+			return;
+		selectedRows.resize (static_cast<size_t> (row) + 1, false);
+	}
+	selectedRows[row] = state;
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::selectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
 			selection.emplace_back (row);
+			setRowSelectedState (row, true);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -438,12 +535,15 @@ void CDataBrowser::unselectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			setRowSelectedState (row, false);
+			// the entry is removed later, unless the stale entries outnumber the selected ones
+			++numUnselectedEntries;
+			if (numUnselectedEntries > selection.size () / 2)
+				compactSelection ();
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -457,13 +557,16 @@ void CDataBrowser::unselectRow (int32_t row)
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::unselectAll ()
 {
-	if (!selection.empty ())
+	if (hasSelectedRows ())
 	{
 		for (auto row : selection)
 		{
-			dbView->invalidateRow (row);
+			if (isRowSelected (row))
+				dbView->invalidateRow (row);
 		}
 		selection.clear ();
+		selectedRows.clear ();
+		numUnselectedEntries = 0;
 		db->dbSelectionChanged (this);
 	}
 }
@@ -471,20 +574,14 @@ void CDataBrowser::unselectAll ()
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
-	bool selectionChanged = false;
 	int32_t numRows = db->dbGetNumRows (this);
-	for (Selection::iterator it = selection.begin (); it != selection.end ();)
-	{
-		if (*it >= numRows)
-		{
-			it = selection.erase (it);
-			selectionChanged = true;
-		}
-		else
-		{
-			++it;
-		}
-	}
+	compactSelection ();
+	auto it = std::remove_if (selection.begin (), selection.end (),
+							  [numRows] (int32_t row) { return row >= numRows; });
+	bool selectionChanged = it != selection.end ();
+	selection.erase (it, selection.end ());
+	if (selectedRows.size () > static_cast<size_t> (std::max<int32_t> (0, numRows)))
+		selectedRows.resize (static_cast<size_t> (std::max<int32_t> (0, numRows)));
 	if (selectionChanged)
 		db->dbSelectionChanged (this);
 }
@@ -506,16 +603,11 @@ CRect CDataBrowser::getCellBounds (const Cell& cell)
 	if (style & kDrawRowLines)
 		rowHeight += lineWidth;
 	CRect result (0, rowHeight * cell.row, 0, rowHeight * (cell.row+1));
-	for (int32_t i = 0; i <= cell.column; i++)
+	validateColumnLayout ();
+	if (cell.column >= 0 && static_cast<size_t> (cell.column) < columnWidths.size ())
 	{
-		CCoord colWidth = db->dbGetCurrentColumnWidth (i, this);
-		if (i != cell.column)
-		{
-			result.offset (colWidth, 0);
-			if (style & kDrawColumnLines)
-				result.offset (lineWidth, 0);
-		}
-		result.setWidth (colWidth);
+		result.left = columnOffsets[cell.column];
+		result.setWidth (columnWidths[cell.column]);
 	}
 	CRect viewSize = dbView->getViewSize ();
 	result.offset (viewSize.left, viewSize.top);
@@ -608,23 +700,24 @@ void CDataBrowserHeader::drawRect (CDrawContext* context, const CRect& updateRec
 	CCoord headerHeight = db->dbGetHeaderHeight (browser);
 	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
 		headerHeight += lineWidth;
-	int32_t numColumns = db->dbGetNumColumns (browser);
+	browser->validateColumnLayout ();
+	const auto& columnOffsets = browser->columnOffsets;
+	auto numColumns = static_cast<int32_t> (browser->columnWidths.size ());
 
 	CRect r (getViewSize ().left, getViewSize ().top, 0, 0);
 	r.setHeight (headerHeight);
 	for (int32_t col = 0; col < numColumns; col++)
 	{
-		CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-		r.setWidth (columnWidth);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			r.right += lineWidth;
+		r.left = getViewSize ().left + columnOffsets[col];
+		if (r.left >= updateRect.right)
+			break;
+		r.right = getViewSize ().left + columnOffsets[col + 1];
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (!testRect.isEmpty ())
 		{
 			db->dbDrawHeader (context, r, col, 0, browser);
 		}
-		r.offset (r.getWidth (), 0);
 	}
 	setDirty (false);
 }
@@ -632,31 +725,13 @@ void CDataBrowserHeader::drawRect (CDrawContext* context, const CRect& updateRec
 //-----------------------------------------------------------------------------------------------
 int32_t CDataBrowserHeader::getColumnAtPoint (CPoint& where)
 {
-	// calculate column at point
-	CCoord lineWidth = 0;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
-	{
-		CColor lineColor;
-		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
-	}
-	int32_t col = -1;
-	int32_t numColumns = db->dbGetNumColumns (browser);
-	CRect r (getViewSize ().left, getViewSize ().top, 0, getViewSize ().bottom);
-	for (int32_t c = 0; c < numColumns; c++)
-	{
-		CCoord columnWidth = db->dbGetCurrentColumnWidth (c, browser);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			columnWidth += lineWidth;
-		r.setWidth (columnWidth);
-		if (r.pointInside (where))
-		{
-			if (r.right - where.x < 5)
-				col = c;
-			break;
-		}
-		r.offset (columnWidth, 0);
-	}
-	return col;
+	// calculate column at point, only the right edge of a column is sensitive
+	if (where.y < getViewSize ().top || where.y >= getViewSize ().bottom)
+		return -1;
+	auto col = browser->getColumnAt (where.x - getViewSize ().left);
+	if (col >= 0 && getViewSize ().left + browser->columnOffsets[col + 1] - where.x < 5)
+		return col;
+	return -1;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -792,25 +867,40 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 	if (drawRowLines)
 		rowHeight += lineWidth;
 	int32_t numRows = db->dbGetNumRows (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
-
-	const CDataBrowser::Selection& selection = browser->getSelection ();
+	browser->validateColumnLayout ();
+	const auto& columnOffsets = browser->columnOffsets;
+	const auto& columnWidths = browser->columnWidths;
+	auto numColumns = static_cast<int32_t> (columnWidths.size ());
+
+	// only the rows intersecting the update rect are drawn
+	int32_t firstRow = 0;
+	int32_t lastRow = 0;
+	if (rowHeight > 0.)
+	{
+		auto top = std::floor ((updateRect.top - getViewSize ().top) / rowHeight);
+		auto bottom = std::ceil ((updateRect.bottom - getViewSize ().top) / rowHeight);
+		firstRow = static_cast<int32_t> (std::max (0., std::min<double> (top, numRows)));
+		lastRow = static_cast<int32_t> (std::max (0., std::min<double> (bottom, numRows)));
+	}
 
 	CDrawContext::LineList lines;
 
 	CRect r (getViewSize ());
 	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	r.offset (0, rowHeight * firstRow);
+	for (int32_t row = firstRow; row < lastRow; row++)
 	{
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (testRect.isEmpty () == false)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
+			bool isSelected = browser->isRowSelected (row);
 			for (int32_t col = 0; col < numColumns; col++)
 			{
-				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-				r.setWidth (columnWidth);
+				r.left = getViewSize ().left + columnOffsets[col];
+				if (r.left >= updateRect.right)
+					break;
+				r.setWidth (columnWidths[col]);
 				testRect = r;
 				testRect.bound (updateRect);
 				if (testRect.isEmpty () == false)
@@ -821,9 +911,6 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 					cellSize.right++;
 					db->dbDrawCell (context, cellSize, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
 				}
-				r.offset (columnWidth, 0);
-				if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-					r.offset (lineWidth, 0);
 			}
 		}
 		r.left = getViewSize ().left;
@@ -843,7 +930,7 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 			p2 (getViewSize ().left - lineWidth, getViewSize ().bottom);
 			for (int32_t col = 0; col < numColumns - 1; col++)
 			{
-				p1.x = p2.x = p1.x + db->dbGetCurrentColumnWidth (col, browser) + lineWidth;
+				p1.x = p2.x = getViewSize ().left + columnOffsets[col + 1] - lineWidth;
 				lines.emplace_back (p1, p2);
 			}
 		}
@@ -875,27 +962,18 @@ bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
 	}
 	CCoord rowHeight = db->dbGetRowHeight (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
 
 	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
 		rowHeight += lineWidth;
 	int32_t rowNum = (int32_t)(_where.y / rowHeight);
-	int32_t colNum = 0;
-	CCoord cw = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-	{
-		cw += db->dbGetCurrentColumnWidth (i, browser);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			cw += lineWidth;
-		if (_where.x < cw && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
-		{
-			colNum = i;
-			cell.row = rowNum;
-			cell.column = colNum;
-			return true;
-		}
-	}
-	return false;
+	if (rowNum >= db->dbGetNumRows (browser))
+		return false;
+	auto colNum = browser->getColumnAt (_where.x);
+	if (colNum < 0)
+		return false;
+	cell.row = rowNum;
+	cell.column = colNum;
+	return true;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -906,7 +984,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
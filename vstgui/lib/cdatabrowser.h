@@ -66,7 +66,7 @@ public:
 	/// @name CDataBrowser Methods
 	//-----------------------------------------------------------------------------
 	//@{
-	/** trigger recalculation, call if numRows or numColumns changed */
+	/** trigger recalculation, call if numRows, numColumns or the column widths changed */
 	virtual void recalculateLayout (bool rememberSelection = false);
 	/** invalidates an individual cell */
 	virtual void invalidate (const Cell& cell);
@@ -86,7 +86,9 @@ public:
 	virtual void setSelectedRow (int32_t row, bool makeVisible = false);
 
 	/** get all selected rows */
-	const Selection& getSelection () const { return selection; }
+	const Selection& getSelection () const;
+	/** check if a row is selected, in constant time */
+	bool isRowSelected (int32_t row) const;
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -122,7 +124,32 @@ protected:
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
-	Selection selection;
+
+private:
+	friend class CDataBrowserView;
+	friend class CDataBrowserHeader;
+
+	void setRowSelectedState (int32_t row, bool state);
+	/** removes the entries of unselected rows from selection */
+	void compactSelection () const;
+	bool hasSelectedRows () const { return selection.size () > numUnselectedEntries; }
+	void updateColumnLayout ();
+	void validateColumnLayout ();
+	void invalidateColumnLayout ();
+	/** returns the column at x (relative to the data view) or -1 */
+	int32_t getColumnAt (CCoord x);
+
+	/** membership of the selection, indexed by row. This is the source of truth, selection only
+	 *	keeps the order in which the rows were selected */
+	mutable std::vector<bool> selectedRows;
+	/** selected rows in selection order. Unselecting a row does not remove its entry right away,
+	 *	so it may contain entries of unselected rows until compactSelection is called */
+	mutable Selection selection;
+	/** number of entries in selection which belong to unselected rows */
+	mutable size_t numUnselectedEntries {0};
+	/** left edge of every column including the column lines and the total width at the end */
+	std::vector<CCoord> columnOffsets;
+	std::vector<CCoord> columnWidths;
 };
 
 //-----------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include "cdrawcontext.h"
 #include "cgraphicspath.h"
 #include "cbitmap.h"
+#include "cdrawprofiler.h"
 #include "cstring.h"
 #include "platform/iplatformfont.h"
 #include <cassert>
@@ -36,6 +37,8 @@ CDrawContext::CDrawContextState& CDrawContext::CDrawContextState::operator= (CDr
 	lineStyle = std::move (state.lineStyle);
 	drawMode = std::move (state.drawMode);
 	globalAlpha = std::move (state.globalAlpha);
+	bitmapQuality = std::move (state.bitmapQuality);
+	antialiasQuality = std::move (state.antialiasQuality);
 	return *this;
 }
 
@@ -115,6 +118,12 @@ void CDrawContext::setBitmapInterpolationQuality(BitmapInterpolationQuality qual
 	currentState.bitmapQuality = quality;
 }
 
+//-----------------------------------------------------------------------------
+void CDrawContext::setAntialiasQuality (AntialiasQuality quality)
+{
+	currentState.antialiasQuality = quality;
+}
+
 //-----------------------------------------------------------------------------
 void CDrawContext::setLineStyle (const CLineStyle& style)
 {
@@ -223,6 +232,7 @@ CCoord CDrawContext::getStringWidth (IPlatformString* string)
 	if (currentState.font == nullptr || string == nullptr)
 		return result;
 	
+	CDrawProfiler::Scope profilerScope (drawProfiler, CDrawProfiler::Category::Text);
 	if (auto painter = currentState.font->getFontPainter ())
 		result = painter->getStringWidth (this, string, true);
 	
@@ -238,6 +248,7 @@ void CDrawContext::drawString (IPlatformString* string, const CRect& _rect, cons
 	if (painter == nullptr)
 		return;
 	
+	CDrawProfiler::Scope profilerScope (drawProfiler, CDrawProfiler::Category::Text);
 	CRect rect (_rect);
 	
 	double capHeight = -1;
@@ -267,6 +278,7 @@ void CDrawContext::drawString (IPlatformString* string, const CPoint& point, boo
 	if (string == nullptr || currentState.font == nullptr)
 		return;
 	
+	CDrawProfiler::Scope profilerScope (drawProfiler, CDrawProfiler::Category::Text);
 	if (auto painter = currentState.font->getFontPainter ())
 		painter->drawString (this, string, point, antialias);
 }
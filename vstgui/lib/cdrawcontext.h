@@ -82,6 +82,21 @@ public:
 
 	//@}
 
+	//-----------------------------------------------------------------------------
+	// @name Antialiasing Quality
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the quality used when the draw mode is kAntiAliasing. Only a hint, platforms without
+	 *	different antialiasing levels ignore it.
+	 *	@ingroup new_in_4_11
+	 */
+	virtual void setAntialiasQuality (AntialiasQuality quality);
+	/** get the current antialiasing quality
+	 *	@ingroup new_in_4_11
+	 */
+	AntialiasQuality getAntialiasQuality () const { return currentState.antialiasQuality; }
+	//@}
+
 	//-----------------------------------------------------------------------------
 	/// @name Line Mode
 	//-----------------------------------------------------------------------------
@@ -201,6 +216,17 @@ public:
 	CCoord getHairlineSize () const;
 	//@}
 
+	//-----------------------------------------------------------------------------
+	/// @name Profiling
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the profiler which records text and bitmap draw times, set by CFrame while drawing
+	 *	@ingroup new_in_4_11
+	 */
+	void setDrawProfiler (CDrawProfiler* profiler) { drawProfiler = profiler; }
+	CDrawProfiler* getDrawProfiler () const { return drawProfiler; }
+	//@}
+
 	//-----------------------------------------------------------------------------
 	/// @name Graphics Paths
 	//-----------------------------------------------------------------------------
@@ -257,6 +283,7 @@ protected:
 		CDrawMode drawMode {kAntiAliasing};
 		float globalAlpha {1.f};
 		BitmapInterpolationQuality bitmapQuality {BitmapInterpolationQuality::kDefault};
+		AntialiasQuality antialiasQuality {AntialiasQuality::kDefault};
 
 		CDrawContextState () = default;
 		CDrawContextState (const CDrawContextState& state);
@@ -271,6 +298,7 @@ protected:
 
 private:
 	UTF8String* drawStringHelper {nullptr};
+	CDrawProfiler* drawProfiler {nullptr};
 	CRect surfaceRect;
 
 	CDrawContextState currentState;
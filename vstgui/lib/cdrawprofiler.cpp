@@ -0,0 +1,346 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cdrawprofiler.h"
+#include "cdrawcontext.h"
+#include "cfont.h"
+#include "cvstguitimer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <typeinfo>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace VSTGUI {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+std::string demangleClassName (const std::type_index& type)
+{
+#if defined(__GNUC__)
+	int status = 0;
+	if (auto demangled = abi::__cxa_demangle (type.name (), nullptr, nullptr, &status))
+	{
+		std::string result (demangled);
+		std::free (demangled);
+		if (status == 0)
+			return result;
+	}
+#endif
+	std::string result (type.name ());
+	// MSVC names are prefixed with "class " or "struct "
+	for (auto prefix : {"class ", "struct "})
+	{
+		auto len = strlen (prefix);
+		if (result.compare (0, len, prefix) == 0)
+			return result.substr (len);
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+double durationToSeconds (CDrawProfiler::Clock::duration d)
+{
+	return std::chrono::duration<double> (d).count ();
+}
+
+//-----------------------------------------------------------------------------
+std::string escapeJSON (const std::string& str)
+{
+	std::string result;
+	for (auto c : str)
+	{
+		if (c == '"' || c == '\\')
+			result += '\\';
+		else if (static_cast<unsigned char> (c) < 0x20)
+			continue;
+		result += c;
+	}
+	return result;
+}
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+CDrawProfiler::CDrawProfiler (uint32_t historySize)
+: frames (std::max<uint32_t> (historySize, 1u)), creationTime (Clock::now ())
+{
+}
+
+//-----------------------------------------------------------------------------
+const CDrawProfiler::FrameRecord& CDrawProfiler::getFrame (uint32_t index) const
+{
+	assert (index < numFrames);
+	auto historySize = getHistorySize ();
+	return frames[(nextFrame + historySize - numFrames + index) % historySize];
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::clear ()
+{
+	numFrames = nextFrame = 0;
+	for (auto& frame : frames)
+		frame = {};
+}
+
+//-----------------------------------------------------------------------------
+double CDrawProfiler::toSeconds (Clock::time_point t) const
+{
+	return durationToSeconds (t - creationTime);
+}
+
+//-----------------------------------------------------------------------------
+const std::string& CDrawProfiler::getClassName (const std::type_index& type)
+{
+	auto it = classNames.find (type);
+	if (it == classNames.end ())
+		it = classNames.emplace (type, demangleClassName (type)).first;
+	return it->second;
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::beginFrame (const CRect& updateRect)
+{
+	if (frameDepth++ > 0)
+		return;
+	current.viewEvents.clear ();
+	current.viewClassTimes.clear ();
+	current.index = frameCounter++;
+	current.updateRect = updateRect;
+	current.numInvalidations = pendingInvalidations;
+	current.invalidArea = pendingInvalidArea;
+	current.numViewsDrawn = 0;
+	current.textDuration = current.bitmapDuration = 0.;
+	current.numTextCalls = current.numBitmapCalls = 0;
+	pendingInvalidations = 0;
+	pendingInvalidArea = 0.;
+	viewStack.clear ();
+	classTimes.clear ();
+	frameStart = Clock::now ();
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::endFrame ()
+{
+	assert (frameDepth > 0);
+	if (frameDepth == 0 || --frameDepth > 0)
+		return;
+	auto now = Clock::now ();
+	current.start = toSeconds (frameStart);
+	current.duration = durationToSeconds (now - frameStart);
+	for (auto& entry : classTimes)
+	{
+		current.viewClassTimes.push_back (
+			{getClassName (entry.first), entry.second.count, durationToSeconds (entry.second.duration)});
+	}
+	std::sort (current.viewClassTimes.begin (), current.viewClassTimes.end (),
+			   [] (const auto& a, const auto& b) { return a.duration > b.duration; });
+
+	// swap instead of copy to reuse the vector storage of the oldest record
+	std::swap (frames[nextFrame], current);
+	nextFrame = (nextFrame + 1) % getHistorySize ();
+	numFrames = std::min (numFrames + 1, getHistorySize ());
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::onInvalidRect (const CRect& rect)
+{
+	++pendingInvalidations;
+	pendingInvalidArea += std::max (0., rect.getWidth ()) * std::max (0., rect.getHeight ());
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::beginView (CView* view)
+{
+	if (frameDepth == 0)
+		return;
+	++current.numViewsDrawn;
+	viewStack.push_back ({view, Clock::now ()});
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::endView ()
+{
+	if (frameDepth == 0 || viewStack.empty ())
+		return;
+	auto now = Clock::now ();
+	auto entry = viewStack.back ();
+	viewStack.pop_back ();
+	auto inclusive = now - entry.start;
+	std::type_index type (typeid (*entry.view));
+	auto& acc = classTimes[type];
+	++acc.count;
+	acc.duration += inclusive - entry.childDuration;
+	if (!viewStack.empty ())
+		viewStack.back ().childDuration += inclusive;
+	if (current.viewEvents.size () < maxViewEvents)
+	{
+		current.viewEvents.push_back (
+			{getClassName (type), toSeconds (entry.start), durationToSeconds (inclusive)});
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfiler::addOperation (Category category, Clock::duration duration)
+{
+	if (frameDepth == 0)
+		return;
+	switch (category)
+	{
+		case Category::Text:
+		{
+			current.textDuration += durationToSeconds (duration);
+			++current.numTextCalls;
+			break;
+		}
+		case Category::Bitmap:
+		{
+			current.bitmapDuration += durationToSeconds (duration);
+			++current.numBitmapCalls;
+			break;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+std::string CDrawProfiler::createChromeTrace () const
+{
+	constexpr auto toMicroSeconds = 1000000.;
+	std::ostringstream stream;
+	stream.precision (15);
+	stream << "{\"traceEvents\":[";
+	bool first = true;
+	auto addEvent = [&] (const std::string& name, double start, double duration) {
+		stream << (first ? "\n" : ",\n");
+		first = false;
+		stream << "{\"name\":\"" << escapeJSON (name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+			   << start * toMicroSeconds << ",\"dur\":" << duration * toMicroSeconds;
+	};
+	for (auto i = 0u; i < numFrames; ++i)
+	{
+		const auto& frame = getFrame (i);
+		addEvent ("Frame " + std::to_string (frame.index), frame.start, frame.duration);
+		stream << ",\"args\":{\"invalidations\":" << frame.numInvalidations
+			   << ",\"invalidArea\":" << frame.invalidArea << ",\"views\":" << frame.numViewsDrawn
+			   << ",\"textMs\":" << frame.textDuration * 1000.
+			   << ",\"bitmapMs\":" << frame.bitmapDuration * 1000. << "}}";
+		for (const auto& event : frame.viewEvents)
+		{
+			addEvent (event.className, event.start, event.duration);
+			stream << "}";
+		}
+	}
+	stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return stream.str ();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+CDrawProfilerOverlay::CDrawProfilerOverlay (const CRect& size, CDrawProfiler* profiler,
+											double frameBudget)
+: CView (size), profiler (profiler), frameBudget (frameBudget)
+{
+	setMouseEnabled (false);
+}
+
+//-----------------------------------------------------------------------------
+CDrawProfilerOverlay::~CDrawProfilerOverlay () noexcept = default;
+
+//-----------------------------------------------------------------------------
+bool CDrawProfilerOverlay::attached (CView* parent)
+{
+	if (CView::attached (parent))
+	{
+		// the overlay is refreshed by a timer and not per frame, otherwise it would
+		// keep the frame busy redrawing itself
+		timer = makeOwned<CVSTGUITimer> (
+			[this] (CVSTGUITimer*) {
+				if (profiler->getNumFrames () &&
+					profiler->getLastFrame ().index != lastDrawnFrame)
+					invalid ();
+			},
+			250);
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool CDrawProfilerOverlay::removed (CView* parent)
+{
+	timer = nullptr;
+	return CView::removed (parent);
+}
+
+//-----------------------------------------------------------------------------
+void CDrawProfilerOverlay::draw (CDrawContext* context)
+{
+	auto r = getViewSize ();
+	context->setDrawMode (kAliasing);
+	context->setFillColor (CColor (0, 0, 0, 180));
+	context->drawRect (r, kDrawFilled);
+	setDirty (false);
+
+	auto numFrames = profiler->getNumFrames ();
+	if (numFrames == 0)
+		return;
+	lastDrawnFrame = profiler->getLastFrame ().index;
+
+	constexpr CCoord kTextHeight = 12.;
+	constexpr uint32_t kNumClassLines = 3;
+	auto graphRect = r;
+	graphRect.inset (4, 4);
+	graphRect.bottom -= kTextHeight * (kNumClassLines + 1);
+	if (graphRect.getHeight () <= 0. || graphRect.getWidth () <= 0.)
+		return;
+
+	// one bar per frame, the full height equals twice the frame budget
+	auto maxDuration = frameBudget * 2.;
+	auto numBars = std::min<uint32_t> (numFrames, static_cast<uint32_t> (graphRect.getWidth ()));
+	auto barWidth = graphRect.getWidth () / numBars;
+	for (auto i = 0u; i < numBars; ++i)
+	{
+		const auto& frame = profiler->getFrame (numFrames - numBars + i);
+		auto height = std::min (frame.duration / maxDuration, 1.) * graphRect.getHeight ();
+		CRect bar (graphRect.left + i * barWidth, graphRect.bottom - height,
+				   graphRect.left + (i + 1) * barWidth, graphRect.bottom);
+		context->setFillColor (frame.duration > frameBudget ? kRedCColor : kGreenCColor);
+		context->drawRect (bar, kDrawFilled);
+	}
+	auto budgetY = graphRect.bottom - graphRect.getHeight () / 2.;
+	context->setFrameColor (kWhiteCColor);
+	context->setLineWidth (1.);
+	context->drawLine (CPoint (graphRect.left, budgetY), CPoint (graphRect.right, budgetY));
+
+	// the text drawn here is not part of the recorded frame times, as the overlay is drawn
+	// during the frame it slightly increases the text time of the frame itself
+	const auto& last = profiler->getLastFrame ();
+	char text[256];
+	snprintf (text, sizeof (text), "%.2f ms  views %u  text %.2f ms  bitmaps %.2f ms",
+			  last.duration * 1000., last.numViewsDrawn, last.textDuration * 1000.,
+			  last.bitmapDuration * 1000.);
+	context->setFont (kNormalFontVerySmall);
+	context->setFontColor (kWhiteCColor);
+	CRect textRect (graphRect.left, graphRect.bottom, graphRect.right,
+					graphRect.bottom + kTextHeight);
+	context->drawString (text, textRect, kLeftText);
+	for (auto i = 0u; i < kNumClassLines && i < last.viewClassTimes.size (); ++i)
+	{
+		const auto& classTime = last.viewClassTimes[i];
+		snprintf (text, sizeof (text), "%s (%u) %.3f ms", classTime.className.data (),
+				  classTime.count, classTime.duration * 1000.);
+		textRect.offset (0., kTextHeight);
+		context->drawString (text, textRect, kLeftText);
+	}
+}
+
+} // VSTGUI
@@ -0,0 +1,190 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cview.h"
+#include "ccolor.h"
+#include <chrono>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CDrawProfiler Declaration
+/// @brief records timing information of the frame drawing
+/// @ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class CDrawProfiler : public NonAtomicReferenceCounted
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Category
+	{
+		Text,
+		Bitmap
+	};
+
+	struct ViewClassTime
+	{
+		std::string className;
+		/** number of views of this class drawn */
+		uint32_t count {0};
+		/** exclusive draw time of all views of this class in seconds */
+		double duration {0.};
+	};
+
+	/** a single draw event for the trace export */
+	struct ViewEvent
+	{
+		std::string className;
+		/** start in seconds since the creation of the profiler */
+		double start {0.};
+		/** inclusive duration in seconds */
+		double duration {0.};
+	};
+
+	struct FrameRecord
+	{
+		uint64_t index {0};
+		/** start in seconds since the creation of the profiler */
+		double start {0.};
+		/** duration in seconds */
+		double duration {0.};
+		CRect updateRect;
+		/** number of invalidations since the previous frame */
+		uint32_t numInvalidations {0};
+		/** area of all invalidated rectangles since the previous frame */
+		double invalidArea {0.};
+		uint32_t numViewsDrawn {0};
+		double textDuration {0.};
+		uint32_t numTextCalls {0};
+		double bitmapDuration {0.};
+		uint32_t numBitmapCalls {0};
+		/** sorted by duration, longest first */
+		std::vector<ViewClassTime> viewClassTimes;
+		std::vector<ViewEvent> viewEvents;
+	};
+
+	/** @param historySize number of frames kept in the ring buffer */
+	explicit CDrawProfiler (uint32_t historySize = 240);
+	~CDrawProfiler () noexcept override = default;
+
+	//-----------------------------------------------------------------------------
+	/// @name Recorded Frames
+	//-----------------------------------------------------------------------------
+	//@{
+	uint32_t getHistorySize () const { return static_cast<uint32_t> (frames.size ()); }
+	/** number of recorded frames, at most the history size */
+	uint32_t getNumFrames () const { return numFrames; }
+	/** get a recorded frame, index 0 is the oldest one */
+	const FrameRecord& getFrame (uint32_t index) const;
+	/** get the most recent frame, only valid if getNumFrames () > 0 */
+	const FrameRecord& getLastFrame () const { return getFrame (numFrames - 1); }
+	void clear ();
+
+	/** maximum number of view events stored per frame for the trace export (default 10000) */
+	void setMaxViewEventsPerFrame (uint32_t maxEvents) { maxViewEvents = maxEvents; }
+
+	/** create a JSON document in the Chrome trace event format (chrome://tracing, Perfetto) */
+	std::string createChromeTrace () const;
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Recording
+	//-----------------------------------------------------------------------------
+	//@{
+	void beginFrame (const CRect& updateRect);
+	void endFrame ();
+	void onInvalidRect (const CRect& rect);
+	void beginView (CView* view);
+	void endView ();
+
+	/** measures the time of a text or bitmap operation */
+	struct Scope
+	{
+		Scope (CDrawProfiler* profiler, Category category)
+		: profiler (profiler), category (category)
+		{
+			if (profiler)
+				start = Clock::now ();
+		}
+		~Scope () noexcept
+		{
+			if (profiler)
+				profiler->addOperation (category, Clock::now () - start);
+		}
+
+	private:
+		CDrawProfiler* profiler;
+		Category category;
+		Clock::time_point start;
+	};
+	//@}
+
+//-----------------------------------------------------------------------------
+private:
+	struct ViewStackEntry
+	{
+		CView* view;
+		Clock::time_point start;
+		Clock::duration childDuration {};
+	};
+
+	struct ClassAccumulator
+	{
+		uint32_t count {0};
+		Clock::duration duration {};
+	};
+
+	double toSeconds (Clock::time_point t) const;
+	const std::string& getClassName (const std::type_index& type);
+	void addOperation (Category category, Clock::duration duration);
+
+	std::vector<FrameRecord> frames;
+	uint32_t numFrames {0};
+	uint32_t nextFrame {0};
+	uint64_t frameCounter {0};
+	uint32_t maxViewEvents {10000};
+	uint32_t frameDepth {0};
+
+	Clock::time_point creationTime;
+	Clock::time_point frameStart;
+	FrameRecord current;
+	uint32_t pendingInvalidations {0};
+	double pendingInvalidArea {0.};
+	std::vector<ViewStackEntry> viewStack;
+	std::unordered_map<std::type_index, ClassAccumulator> classTimes;
+	/** demangled class names, so that each class is only demangled once */
+	std::unordered_map<std::type_index, std::string> classNames;
+};
+
+//-----------------------------------------------------------------------------
+// CDrawProfilerOverlay Declaration
+/// @brief a view showing the frame times of a CDrawProfiler
+/// @ingroup new_in_4_11
+//-----------------------------------------------------------------------------
+class CDrawProfilerOverlay : public CView
+{
+public:
+	/** @param frameBudget the frame time in seconds, drawn as a line */
+	CDrawProfilerOverlay (const CRect& size, CDrawProfiler* profiler, double frameBudget = 1. / 60.);
+	~CDrawProfilerOverlay () noexcept override;
+
+	void draw (CDrawContext* context) override;
+	bool attached (CView* parent) override;
+	bool removed (CView* parent) override;
+
+private:
+	SharedPointer<CDrawProfiler> profiler;
+	SharedPointer<CVSTGUITimer> timer;
+	double frameBudget;
+	uint64_t lastDrawnFrame {0};
+};
+
+} // VSTGUI
@@ -3,11 +3,14 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "cframe.h"
+#include "cbitmap.h"
+#include "cbitmapcache.h"
 #include "events.h"
 #include "finally.h"
 #include "coffscreencontext.h"
 #include "ctooltipsupport.h"
 #include "cinvalidrectlist.h"
+#include "cdrawprofiler.h"
 #include "itouchevent.h"
 #include "iscalefactorchangedlistener.h"
 #include "idatapackage.h"
@@ -15,6 +18,9 @@
 #include "controls/ctextedit.h"
 #include "platform/platformfactory.h"
 #include "platform/iplatformframe.h"
+#include "platform/common/headlessframe.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <vector>
 #include <queue>
@@ -66,6 +72,7 @@ struct CFrame::Impl
 	IViewAddedRemovedObserver* viewAddedRemovedObserver {nullptr};
 	SharedPointer<CTooltipSupport> tooltips;
 	SharedPointer<Animation::Animator> animator;
+	SharedPointer<CDrawProfiler> drawProfiler;
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
 	Optional<ModalViewSessionID> legacyModalViewSessionID;
 #endif
@@ -88,8 +95,14 @@ struct CFrame::Impl
 	bool active {false};
 	bool windowActive {false};
 	bool inEventHandling {false};
+	bool eventDrivenIdle {false};
+	std::atomic<bool> dirtyViewsPending {true};
 	BitmapInterpolationQuality bitmapQuality {BitmapInterpolationQuality::kDefault};
 
+	// the state of the last platformPrepareConcurrentDraw call
+	std::vector<CRect> concurrentDrawRects;
+	std::vector<SharedPointer<CBitmap>> concurrentDrawBitmaps;
+
 	struct PostEventHandler
 	{
 		PostEventHandler (Impl& impl) : impl (impl)
@@ -223,6 +236,32 @@ bool CFrame::open (void* systemWin, PlatformType systemWindowType, IPlatformFram
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool CFrame::openHeadless (double scaleFactor)
+{
+	if (isAttached ())
+		return false;
+
+	pImpl->platformFrame = makeOwned<HeadlessFrame> (this, getViewSize ());
+	pImpl->platformScaleFactor = scaleFactor;
+
+	attached (this);
+
+	setParentView (nullptr);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<CBitmap> CFrame::renderOffscreen ()
+{
+	auto size = getViewSize ();
+	if (size.isEmpty ())
+		return nullptr;
+	return renderBitmapOffscreen (size.getSize (), getScaleFactor (),
+								  [&] (CDrawContext& context) { drawRect (&context, size); });
+}
+
 //-----------------------------------------------------------------------------
 bool CFrame::attached (CView* parent)
 {
@@ -233,7 +272,7 @@ bool CFrame::attached (CView* parent)
 	{
 		setParentView (nullptr);
 
-		for (const auto& pV : getChildren ())
+		for (const auto& pV : getChildViews ())
 			pV->attached (this);
 		
 		return true;
@@ -295,6 +334,23 @@ BitmapInterpolationQuality CFrame::getBitmapInterpolationQuality () const
 	return BitmapInterpolationQuality::kDefault;
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::setDrawProfilingEnabled (bool state, uint32_t historySize)
+{
+	if (!pImpl)
+		return;
+	if (!state)
+		pImpl->drawProfiler = nullptr;
+	else if (!pImpl->drawProfiler || pImpl->drawProfiler->getHistorySize () != historySize)
+		pImpl->drawProfiler = makeOwned<CDrawProfiler> (historySize);
+}
+
+//-----------------------------------------------------------------------------
+CDrawProfiler* CFrame::getDrawProfiler () const
+{
+	return pImpl ? pImpl->drawProfiler.get () : nullptr;
+}
+
 //-----------------------------------------------------------------------------
 double CFrame::getScaleFactor () const
 {
@@ -332,6 +388,21 @@ void CFrame::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	if (pImpl)
 		pContext->setBitmapInterpolationQuality (pImpl->bitmapQuality);
 
+	auto profiler = pImpl ? pImpl->drawProfiler : nullptr;
+	auto previousProfiler = pContext->getDrawProfiler ();
+	if (profiler)
+	{
+		pContext->setDrawProfiler (profiler);
+		profiler->beginFrame (updateRect);
+	}
+	auto finalAction = finally ([&] () {
+		if (profiler)
+		{
+			profiler->endFrame ();
+			pContext->setDrawProfiler (previousProfiler);
+		}
+	});
+
 	drawClipped (pContext, updateRect, [&] () {
 		// draw the background and the children
 		CViewContainer::drawRect (pContext, updateRect);
@@ -625,6 +696,18 @@ void CFrame::dispatchMouseMoveEvent (MouseMoveEvent& event)
 	auto transformedMousePosition = event.mousePosition;
 	getTransform ().inverse ().transform (transformedMousePosition);
 
+	std::vector<CPoint> transformedCoalescedPositions;
+	if (event.numCoalescedPositions && !getTransform ().isInvariant ())
+	{
+		transformedCoalescedPositions.assign (event.coalescedPositions,
+											  event.coalescedPositions +
+												  event.numCoalescedPositions);
+		auto inverseTransform = getTransform ().inverse ();
+		for (auto& position : transformedCoalescedPositions)
+			inverseTransform.transform (position);
+		event.coalescedPositions = transformedCoalescedPositions.data ();
+	}
+
 	if (auto tooltips = pImpl->tooltips)
 		tooltips->onMouseMoved (transformedMousePosition);
 
@@ -791,9 +874,51 @@ void CFrame::idle ()
 {
 	if (CView::kDirtyCallAlwaysOnMainThread)
 		return;
+	if (pImpl->eventDrivenIdle)
+	{
+		// views set dirty while the views are checked are handled with the next idle
+		if (pImpl->dirtyViewsPending.exchange (false))
+		{
+			++CView::getIdleCounters ().dirtyViewChecks;
+			invalidateDirtyViews ();
+		}
+		else if (hasDirtyDescendant ())
+		{
+			++CView::getIdleCounters ().dirtyViewChecks;
+			invalidateDirtyDescendants ();
+		}
+		return;
+	}
+	++CView::getIdleCounters ().dirtyViewChecks;
 	invalidateDirtyViews ();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * In the event driven mode idle () only visits the containers with a view which was set dirty or a
+ * control whose value changed since the last call, see CViewContainer::invalidateDirtyDescendants.
+ * Views which are dirty without calling setDirty () (i.e. because they override isDirty ()) must
+ * call CView::markDirtyInParents () when they become dirty, or onViewDirty () to check all views
+ * with the next idle ().
+ */
+void CFrame::setEventDrivenIdle (bool state)
+{
+	pImpl->eventDrivenIdle = state;
+	pImpl->dirtyViewsPending = true;
+}
+
+//-----------------------------------------------------------------------------
+bool CFrame::isEventDrivenIdle () const
+{
+	return pImpl->eventDrivenIdle;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::onViewDirty ()
+{
+	pImpl->dirtyViewsPending = true;
+}
+
 //-----------------------------------------------------------------------------
 Animation::Animator* CFrame::getAnimator ()
 {
@@ -1495,7 +1620,7 @@ void CFrame::scrollRect (const CRect& src, const CPoint& distance)
 //-----------------------------------------------------------------------------
 void CFrame::invalidate (const CRect &rect)
 {
-	for (const auto& pV : getChildren ())
+	for (const auto& pV : getChildViews ())
 	{
 		CRect rectView = pV->getViewSize ();
 		if (rect.rectOverlap (rectView))
@@ -1512,6 +1637,8 @@ void CFrame::invalidRect (const CRect& rect)
 	CRect _rect (rect);
 	getTransform ().transform (_rect);
 	_rect.makeIntegral ();
+	if (pImpl->drawProfiler)
+		pImpl->drawProfiler->onInvalidRect (_rect);
 	if (pImpl->collectInvalidRects)
 		pImpl->collectInvalidRects->addRect (_rect);
 	else
@@ -1661,6 +1788,173 @@ bool CFrame::platformDrawRect (CDrawContext* context, const CRect& rect)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+namespace {
+
+//-----------------------------------------------------------------------------
+CRect toChildCoordinates (const CViewContainer* container, CRect rect)
+{
+	rect.bound (container->getViewSize ());
+	rect.offset (-container->getViewSize ().left, -container->getViewSize ().top);
+	container->getTransform ().inverse ().transform (rect);
+	return rect;
+}
+
+//-----------------------------------------------------------------------------
+/** groups the rects drawn at the same time, so that every view is only drawn in the rects of one
+ *	group and never on two threads */
+struct ConcurrentDrawGroups
+{
+	using RectList = std::vector<CRect>;
+
+	std::vector<size_t> parents;
+	std::vector<uint8_t> mainThreadOnly;
+	std::vector<CBitmap*> bitmaps;
+
+	explicit ConcurrentDrawGroups (size_t numRects) : parents (numRects), mainThreadOnly (numRects)
+	{
+		for (size_t index = 0; index < numRects; ++index)
+			parents[index] = index;
+	}
+
+	size_t findGroup (size_t index)
+	{
+		while (parents[index] != index)
+			index = parents[index] = parents[parents[index]];
+		return index;
+	}
+
+	void join (size_t index1, size_t index2) { parents[findGroup (index1)] = findGroup (index2); }
+
+	/** rects are in the coordinates of the parent of view, empty rects are not drawn there */
+	void addView (CView* view, const RectList& rects)
+	{
+		if (!view->isVisible ())
+			return;
+		auto container = view->asViewContainer ();
+		auto threadSafe = view->isThreadSafeDrawing ();
+		auto firstRect = rects.size ();
+		RectList childRects;
+		for (size_t index = 0; index < rects.size (); ++index)
+		{
+			if (rects[index].isEmpty () || !view->checkUpdate (rects[index]))
+				continue;
+			if (!threadSafe)
+				mainThreadOnly[index] = true;
+			// a container only draws its background in each rect, the rects are joined by the
+			// views it contains
+			if (container)
+			{
+				childRects.resize (rects.size ());
+				childRects[index] = toChildCoordinates (container, rects[index]);
+			}
+			else if (firstRect == rects.size ())
+				firstRect = index;
+			else
+				join (firstRect, index);
+		}
+		if (childRects.empty () && firstRect == rects.size ())
+			return;
+		view->getDrawBitmaps (bitmaps);
+		// the children of a container which is drawn on the main thread are too
+		if (container && threadSafe)
+			container->forEachChild ([&] (CView* child) { addView (child, childRects); });
+	}
+
+	uint32_t assignGroups (std::vector<int32_t>& groups)
+	{
+		// a group is drawn on the main thread if one of its rects must be
+		for (size_t index = 0; index < parents.size (); ++index)
+		{
+			if (mainThreadOnly[index])
+				mainThreadOnly[findGroup (index)] = true;
+		}
+		std::vector<int32_t> groupIndices (parents.size (), -1);
+		uint32_t numGroups = 0;
+		groups.assign (parents.size (), -1);
+		for (size_t index = 0; index < parents.size (); ++index)
+		{
+			auto group = findGroup (index);
+			if (mainThreadOnly[group])
+				continue;
+			if (groupIndices[group] < 0)
+				groupIndices[group] = static_cast<int32_t> (numGroups++);
+			groups[index] = groupIndices[group];
+		}
+		return numGroups;
+	}
+};
+
+//-----------------------------------------------------------------------------
+void resetDirtyState (CView* view, const CRect& rect)
+{
+	view->setDirty (false);
+	if (auto container = view->asViewContainer ())
+	{
+		auto childRect = toChildCoordinates (container, rect);
+		container->forEachChild ([&] (CView* child) {
+			if (child->isVisible () && child->checkUpdate (childRect))
+				resetDirtyState (child, childRect);
+		});
+	}
+}
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+uint32_t CFrame::platformPrepareConcurrentDraw (const std::vector<CRect>& rects,
+												std::vector<int32_t>& groups)
+{
+	groups.assign (rects.size (), -1);
+	// the draw profiler and the focus drawing are not thread safe
+	if (!pImpl || pImpl->drawProfiler)
+		return 0;
+	if (focusDrawingEnabled () && getFocusView ())
+		return 0;
+	ConcurrentDrawGroups drawGroups (rects.size ());
+	drawGroups.addView (this, rects);
+	auto numGroups = drawGroups.assignGroups (groups);
+	if (numGroups == 0)
+		return 0;
+	for (size_t index = 0; index < rects.size (); ++index)
+	{
+		if (groups[index] >= 0)
+			pImpl->concurrentDrawRects.emplace_back (rects[index]);
+	}
+	// the bitmaps must neither be loaded, scaled nor released by the cache while the worker
+	// threads draw them
+	auto& bitmaps = drawGroups.bitmaps;
+	std::sort (bitmaps.begin (), bitmaps.end ());
+	bitmaps.erase (std::unique (bitmaps.begin (), bitmaps.end ()), bitmaps.end ());
+	auto scaleFactor = getScaleFactor ();
+	for (auto bitmap : bitmaps)
+	{
+		CBitmapCache::instance ().pinBitmap (bitmap);
+		bitmap->getScaledPlatformBitmap (scaleFactor);
+		pImpl->concurrentDrawBitmaps.emplace_back (bitmap);
+	}
+	return numGroups;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::platformDrawRectConcurrently (CDrawContext* context, const CRect& rect)
+{
+	setDrawingConcurrently (true);
+	auto guard = finally ([] () { setDrawingConcurrently (false); });
+	drawRect (context, rect);
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::platformDidDrawConcurrently ()
+{
+	for (const auto& rect : pImpl->concurrentDrawRects)
+		resetDirtyState (this, rect);
+	pImpl->concurrentDrawRects.clear ();
+	for (const auto& bitmap : pImpl->concurrentDrawBitmaps)
+		CBitmapCache::instance ().unpinBitmap (bitmap);
+	pImpl->concurrentDrawBitmaps.clear ();
+}
+
 //-----------------------------------------------------------------------------
 void CFrame::platformOnEvent (Event& event)
 {
@@ -43,6 +43,18 @@ public:
 	bool open (void* pSystemWindow, PlatformType systemWindowType = PlatformType::kDefaultNative, IPlatformFrameConfig* = nullptr);
 	/** closes the frame and calls forget */
 	void close ();
+	/** opens the frame without a platform window
+	 *
+	 *	The frame does not receive any events and is only drawn via renderOffscreen, this can be
+	 *	used to render views to bitmaps on machines without a window system.
+	 *	@param scaleFactor the platform scale factor, used to choose the bitmap representations
+	 *	@ingroup new_in_4_11
+	 */
+	bool openHeadless (double scaleFactor = 1.);
+	/** draws the frame into a new bitmap using the scale factor of the frame
+	 *	@ingroup new_in_4_11
+	 */
+	SharedPointer<CBitmap> renderOffscreen ();
 
 	/** set zoom factor */
 	bool setZoom (double zoomFactor);
@@ -52,9 +64,29 @@ public:
 	void setBitmapInterpolationQuality (BitmapInterpolationQuality quality);	///< set interpolation quality for bitmaps
 	BitmapInterpolationQuality getBitmapInterpolationQuality () const;			///< get interpolation quality for bitmaps
 
+	/** enable recording of draw timings, see CDrawProfiler
+	 *	@param historySize number of frames kept
+	 *	@ingroup new_in_4_11
+	 */
+	void setDrawProfilingEnabled (bool state, uint32_t historySize = 240);
+	/** returns the draw profiler if profiling is enabled, otherwise nullptr
+	 *	@ingroup new_in_4_11
+	 */
+	CDrawProfiler* getDrawProfiler () const;
+
 	double getScaleFactor () const;
 
 	void idle ();
+	/** only visit the containers with dirty views in idle ()
+	 *	@ingroup new_in_4_11
+	 */
+	void setEventDrivenIdle (bool state);
+	/** @ingroup new_in_4_11 */
+	bool isEventDrivenIdle () const;
+	/** check all views in the next idle (), thread safe
+	 *	@ingroup new_in_4_11
+	 */
+	void onViewDirty ();
 
 	/** get the current time (in ms) */
 	uint64_t getTicks () const;
@@ -246,6 +278,10 @@ protected:
 
 	// platform frame
 	bool platformDrawRect (CDrawContext* context, const CRect& rect) override;
+	uint32_t platformPrepareConcurrentDraw (const std::vector<CRect>& rects,
+											std::vector<int32_t>& groups) override;
+	void platformDrawRectConcurrently (CDrawContext* context, const CRect& rect) override;
+	void platformDidDrawConcurrently () override;
 	void platformOnEvent (Event& event) override;
 	DragOperation platformOnDragEnter (DragEventData data) override;
 	DragOperation platformOnDragMove (DragEventData data) override;
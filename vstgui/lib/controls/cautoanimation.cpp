@@ -31,8 +31,11 @@ CAutoAnimation::CAutoAnimation (const CRect& size, IControlListener* listener, i
 , offset (offset)
 , bWindowOpened (false)
 {
-	heightOfOneImage = size.getHeight ();
-	setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		heightOfOneImage = size.getHeight ();
+		setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	}
 
 	totalHeightOfBitmap = heightOfOneImage * getNumSubPixmaps ();
 }
@@ -77,13 +80,14 @@ void CAutoAnimation::draw (CDrawContext *pContext)
 {
 	if (isWindowOpened ())
 	{	
-		CPoint where;
-		where.y = (int32_t)value + offset.y;
-		where.x = offset.x;
+		int32_t frameIndex = 0;
+		if (heightOfOneImage > 0.)
+			frameIndex = static_cast<int32_t> (value / heightOfOneImage);
+		CPoint where (offset.x, offset.y + (int32_t)value - frameIndex * heightOfOneImage);
 		
 		if (getDrawBackground ())
 		{
-			getDrawBackground ()->draw (pContext, getViewSize (), where);
+			drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), frameIndex, where);
 		}
 	}
 	setDirty (false);
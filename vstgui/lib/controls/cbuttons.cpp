@@ -156,7 +156,8 @@ CKickButton::CKickButton (const CRect& size, IControlListener* listener, int32_t
 : CControl (size, listener, tag, background)
 , offset (offset)
 {
-	heightOfOneImage = size.getHeight ();
+	if (!updateFromMultiFrameBitmap (background))
+		heightOfOneImage = size.getHeight ();
 	setWantsFocus (true);
 }
 
@@ -191,16 +192,13 @@ CKickButton::CKickButton (const CKickButton& v)
 //------------------------------------------------------------------------
 void CKickButton::draw (CDrawContext *pContext)
 {
-	CPoint where (offset.x, offset.y);
-
 	bounceValue ();
 
-	if (value == getMax ())
-		where.y += heightOfOneImage;
+	int32_t frameIndex = (value == getMax ()) ? 1 : 0;
 
 	if (getDrawBackground ())
 	{
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), frameIndex, offset);
 	}
 	setDirty (false);
 }
@@ -298,7 +296,7 @@ bool CKickButton::sizeToFit ()
 	{
 		CRect vs (getViewSize ());
 		vs.setHeight (heightOfOneImage);
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		setViewSize (vs, true);
 		setMouseableArea (vs);
 		return true;
@@ -891,6 +889,16 @@ bool CTextButton::sizeToFit ()
 	return false;
 }
 
+//------------------------------------------------------------------------
+void CTextButton::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	CControl::getDrawBitmaps (bitmaps);
+	if (icon)
+		bitmaps.emplace_back (icon);
+	if (iconHighlighted)
+		bitmaps.emplace_back (iconHighlighted);
+}
+
 //------------------------------------------------------------------------
 void CTextButton::draw (CDrawContext* context)
 {
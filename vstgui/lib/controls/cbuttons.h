@@ -228,6 +228,7 @@ public:
 
 	// overrides
 	void draw (CDrawContext* context) override;
+	void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 	bool drawFocusOnTop () override;
 	void setViewSize (const CRect& rect, bool invalid = true) override;
@@ -4,6 +4,7 @@
 
 #include "ccontrol.h"
 #include "icontrollistener.h"
+#include "../cbitmap.h"
 #include "../cframe.h"
 #include "../cgraphicspath.h"
 #include "../cvstguitimer.h"
@@ -203,6 +204,8 @@ void CControl::setValue (float val)
 	if (val != value)
 	{
 		value = val;
+		// the control is dirty until the new value is drawn, see isDirty ()
+		markDirtyInParents ();
 	}
 }
 
@@ -244,6 +247,8 @@ bool CControl::isDirty () const
 //------------------------------------------------------------------------
 void CControl::setDirty (bool val)
 {
+	if (isDrawingConcurrently ())
+		return;
 	CView::setDirty (val);
 	if (val)
 	{
@@ -347,11 +352,55 @@ void IMultiBitmapControl::autoComputeHeightOfOneImage ()
 	auto* view = dynamic_cast<CView*>(this);
 	if (view)
 	{
+		if (updateFromMultiFrameBitmap (view->getDrawBackground ()))
+			return;
 		const CRect& viewSize = view->getViewSize ();
 		heightOfOneImage = viewSize.getHeight ();
 	}
 }
 
+//------------------------------------------------------------------------
+bool IMultiBitmapControl::updateFromMultiFrameBitmap (CBitmap* bitmap)
+{
+	auto multiFrameBitmap = dynamic_cast<CMultiFrameBitmap*> (bitmap);
+	if (!multiFrameBitmap || multiFrameBitmap->getNumFrames () == 0)
+		return false;
+	heightOfOneImage = multiFrameBitmap->getFrameSize ().y;
+	subPixmaps = multiFrameBitmap->getNumFrames ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+void IMultiBitmapControl::drawBitmapFrame (CDrawContext* context, CBitmap* bitmap,
+										   const CRect& rect, int32_t frameIndex,
+										   const CPoint& offset) const
+{
+	if (!bitmap)
+		return;
+	if (frameIndex < 0)
+		frameIndex = 0;
+	if (auto multiFrameBitmap = dynamic_cast<CMultiFrameBitmap*> (bitmap))
+	{
+		if (multiFrameBitmap->getNumFrames () > 0)
+		{
+			multiFrameBitmap->drawFrame (context, static_cast<uint16_t> (frameIndex), rect, offset);
+			return;
+		}
+	}
+	bitmap->draw (context, rect, CPoint (offset.x, offset.y + heightOfOneImage * frameIndex));
+}
+
+//------------------------------------------------------------------------
+CCoord IMultiBitmapControl::getBitmapFrameWidth (CBitmap* bitmap)
+{
+	if (auto multiFrameBitmap = dynamic_cast<CMultiFrameBitmap*> (bitmap))
+	{
+		if (multiFrameBitmap->getNumFrames () > 0)
+			return multiFrameBitmap->getFrameSize ().x;
+	}
+	return bitmap ? bitmap->getWidth () : 0.;
+}
+
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
 //------------------------------------------------------------------------
@@ -139,6 +139,16 @@ public:
 	virtual void autoComputeHeightOfOneImage ();
 protected:
 	IMultiBitmapControl () : heightOfOneImage (0), subPixmaps (0) {}
+
+	/** take over the frame height and the number of frames if bitmap is a CMultiFrameBitmap */
+	bool updateFromMultiFrameBitmap (CBitmap* bitmap);
+	/** draw the frame at frameIndex of bitmap into rect. Uses the frame layout of a
+	 *	CMultiFrameBitmap, otherwise the frames are expected to be stacked vertically */
+	void drawBitmapFrame (CDrawContext* context, CBitmap* bitmap, const CRect& rect,
+						  int32_t frameIndex, const CPoint& offset = CPoint (0, 0)) const;
+	/** width of one frame of bitmap */
+	static CCoord getBitmapFrameWidth (CBitmap* bitmap);
+
 	CCoord heightOfOneImage;
 	int32_t subPixmaps;
 };
@@ -481,6 +481,14 @@ bool CKnob::getFocusPath (CGraphicsPath &outPath)
 	return CKnobBase::getFocusPath (outPath);
 }
 
+//------------------------------------------------------------------------
+void CKnob::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	CKnobBase::getDrawBitmaps (bitmaps);
+	if (pHandle)
+		bitmaps.emplace_back (pHandle);
+}
+
 //------------------------------------------------------------------------
 void CKnob::draw (CDrawContext *pContext)
 {
@@ -767,8 +775,11 @@ CAnimKnob::CAnimKnob (const CRect& size, IControlListener* listener, int32_t tag
 : CKnobBase (size, listener, tag, background)
 , bInverseBitmap (false)
 {
-	heightOfOneImage = size.getHeight ();
-	setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		heightOfOneImage = size.getHeight ();
+		setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	}
 	inset = 0;
 }
 
@@ -808,7 +819,7 @@ bool CAnimKnob::sizeToFit ()
 	if (getDrawBackground ())
 	{
 		CRect vs (getViewSize ());
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		vs.setHeight (getHeightOfOneImage ());
 		setViewSize (vs);
 		setMouseableArea (vs);
@@ -821,6 +832,8 @@ bool CAnimKnob::sizeToFit ()
 void CAnimKnob::setHeightOfOneImage (const CCoord& height)
 {
 	IMultiBitmapControl::setHeightOfOneImage (height);
+	if (dynamic_cast<CMultiFrameBitmap*> (getDrawBackground ()))
+		return;
 	if (getDrawBackground () && heightOfOneImage > 0)
 		setNumSubPixmaps ((int32_t)(getDrawBackground ()->getHeight () / heightOfOneImage));
 }
@@ -829,6 +842,8 @@ void CAnimKnob::setHeightOfOneImage (const CCoord& height)
 void CAnimKnob::setBackground (CBitmap *background)
 {
 	CKnobBase::setBackground (background);
+	if (updateFromMultiFrameBitmap (background))
+		return;
 	if (heightOfOneImage == 0)
 		heightOfOneImage = getViewSize ().getHeight ();
 	if (background && heightOfOneImage > 0)
@@ -840,19 +855,20 @@ void CAnimKnob::draw (CDrawContext *pContext)
 {
 	if (getDrawBackground ())
 	{
-		CPoint where (0, 0);
+		int32_t frameIndex = 0;
 		float val = getValueNormalized ();
 		if (val >= 0.f && heightOfOneImage > 0.)
 		{
 			CCoord tmp = heightOfOneImage * (getNumSubPixmaps () - 1);
+			CCoord y;
 			if (bInverseBitmap)
-				where.y = floor ((1. - val) * tmp);
+				y = floor ((1. - val) * tmp);
 			else
-				where.y = floor (val * tmp);
-			where.y -= (int32_t)where.y % (int32_t)heightOfOneImage;
+				y = floor (val * tmp);
+			frameIndex = (int32_t)y / (int32_t)heightOfOneImage;
 		}
 
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), frameIndex);
 	}
 	setDirty (false);
 }
@@ -121,6 +121,7 @@ public:
 
 	// overrides
 	void draw (CDrawContext* pContext) override;
+	void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
 	bool drawFocusOnTop () override;
 
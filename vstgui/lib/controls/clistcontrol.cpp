@@ -9,6 +9,7 @@
 #include "../cscrollview.h"
 #include "../events.h"
 #include "clistcontrol.h"
+#include <algorithm>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -20,9 +21,43 @@ struct CListControl::Impl
 	SharedPointer<IListControlDrawer> drawer;
 	SharedPointer<IListControlConfigurator> configurator;
 
+	/** only used if the rows don't have a uniform height */
 	std::vector<CListControlRowDesc> rowDescriptions;
+	/** top of every row relative to the control plus the total height at the end */
+	std::vector<CCoord> rowOffsets;
+	CCoord uniformRowHeight {0.};
+	bool uniformRows {false};
+	size_t numRows {0};
 	Optional<int32_t> hoveredRow {};
 	bool doHoverCheck {false};
+
+	CCoord getRowTop (size_t row) const
+	{
+		if (uniformRows)
+			return static_cast<CCoord> (row) * uniformRowHeight;
+		return rowOffsets[row];
+	}
+
+	CCoord getRowHeight (size_t row) const
+	{
+		if (uniformRows)
+			return uniformRowHeight;
+		return rowOffsets[row + 1] - rowOffsets[row];
+	}
+
+	CCoord getTotalHeight () const { return getRowTop (numRows); }
+
+	/** returns the row containing y or numRows if there is none */
+	size_t findRow (CCoord y) const
+	{
+		if (numRows == 0 || y < 0. || y >= getTotalHeight ())
+			return numRows;
+		if (uniformRows)
+			return std::min (static_cast<size_t> (y / uniformRowHeight), numRows - 1);
+		// the first row whose bottom is below y
+		auto it = std::upper_bound (rowOffsets.begin () + 1, rowOffsets.end (), y);
+		return static_cast<size_t> (std::distance (rowOffsets.begin () + 1, it));
+	}
 };
 
 //------------------------------------------------------------------------
@@ -87,17 +122,35 @@ void CListControl::recalculateLayout ()
 	if (!impl->configurator)
 		return;
 
-	CCoord height = 0.;
-	auto numRows = getNumRows ();
-	impl->rowDescriptions.resize (static_cast<size_t> (numRows));
-	impl->doHoverCheck = false;
-
-	for (auto row = 0; row < numRows; ++row)
+	auto numRows = static_cast<size_t> (getNumRows ());
+	impl->numRows = numRows;
+	if (auto uniformRowHeight = impl->configurator->getUniformRowHeight ())
+	{
+		impl->uniformRows = true;
+		impl->uniformRowHeight = *uniformRowHeight;
+		impl->rowDescriptions.clear ();
+		impl->rowDescriptions.shrink_to_fit ();
+		impl->rowOffsets.clear ();
+		impl->rowOffsets.shrink_to_fit ();
+		// the flags are requested when needed
+		impl->doHoverCheck = numRows > 0;
+	}
+	else
 	{
-		impl->rowDescriptions[row] = impl->configurator->getRowDesc (row);
-		height += impl->rowDescriptions[row].height;
-		impl->doHoverCheck |= (impl->rowDescriptions[row].flags & CListControlRowDesc::Hoverable) != 0;
+		impl->uniformRows = false;
+		impl->rowDescriptions.resize (numRows);
+		impl->rowOffsets.resize (numRows + 1);
+		impl->rowOffsets[0] = 0.;
+		impl->doHoverCheck = false;
+		for (auto row = 0u; row < numRows; ++row)
+		{
+			auto& desc = impl->rowDescriptions[row];
+			desc = impl->configurator->getRowDesc (static_cast<int32_t> (row));
+			impl->rowOffsets[row + 1] = impl->rowOffsets[row] + desc.height;
+			impl->doHoverCheck |= (desc.flags & CListControlRowDesc::Hoverable) != 0;
+		}
 	}
+	auto height = impl->getTotalHeight ();
 
 	auto viewSize = getViewSize ();
 	if (viewSize.getHeight () != height)
@@ -113,16 +166,13 @@ Optional<CRect> CListControl::getRowRect (int32_t row) const
 {
 	if (row < getMinRowIndex () || row > getMaxRowIndex ())
 		return {};
-	row -= getMinRowIndex ();
+	auto index = getNormalizedRowIndex (row);
+	if (index >= impl->numRows)
+		return {};
 	CRect rowSize;
 	rowSize.setWidth (getWidth ());
-	for (auto i = 0u; i < impl->rowDescriptions.size (); ++i)
-	{
-		rowSize.setHeight (impl->rowDescriptions[i].height);
-		if (i == row)
-			break;
-		rowSize.offset (0, impl->rowDescriptions[i].height);
-	}
+	rowSize.setHeight (impl->getRowHeight (index));
+	rowSize.offset (0, impl->getRowTop (index));
 	rowSize.offset (getViewSize ().getTopLeft ());
 	return makeOptional (rowSize);
 }
@@ -139,13 +189,9 @@ Optional<int32_t> CListControl::getRowAtPoint (CPoint where) const
 {
 	where.offsetInverse (getViewSize ().getTopLeft ());
 
-	auto numRows = getNumRows ();
-	for (auto row = 0; row < numRows; ++row)
-	{
-		if (where.y < impl->rowDescriptions[row].height)
-			return {row + getMinRowIndex ()};
-		where.y -= impl->rowDescriptions[row].height;
-	}
+	auto row = impl->findRow (where.y);
+	if (row < impl->numRows)
+		return {static_cast<int32_t> (row) + getMinRowIndex ()};
 	return {};
 }
 
@@ -172,27 +218,34 @@ void CListControl::drawRect (CDrawContext* context, const CRect& updateRect)
 	if (!getTransparency ())
 		impl->drawer->drawBackground (context, getViewSize ());
 
-	CRect rowSize;
-	rowSize.setTopLeft (getViewSize ().getTopLeft ());
-	rowSize.setWidth (getWidth ());
-	rowSize.setHeight (0);
-	auto numRows = getNumRows ();
-	auto selectedRow = static_cast<int32_t> (getNormalizedRowIndex (getIntValue ()));
-	for (auto row = 0; row < numRows; ++row)
+	auto numRows = impl->numRows;
+	if (numRows == 0)
+		return;
+
+	// only iterate the rows intersecting the update rect
+	auto top = getViewSize ().top;
+	auto row = impl->findRow (std::max (0., updateRect.top - top));
+	auto selectedRow = getNormalizedRowIndex (getIntValue ());
+	for (; row < numRows; ++row)
 	{
-		rowSize.setHeight (impl->rowDescriptions[row].height);
-		if (updateRect.rectOverlap (rowSize))
-		{
-			int32_t flags = selectedRow == row ? IListControlDrawer::Row::Selected : 0;
-			if (impl->rowDescriptions[row].flags & CListControlRowDesc::Selectable)
-				flags |= IListControlDrawer::Row::Selectable;
-			if (impl->hoveredRow && *impl->hoveredRow == row + getMinRowIndex ())
-				flags |= IListControlDrawer::Row::Hovered;
-			if (row == numRows - 1)
-				flags |= IListControlDrawer::Row::LastRow;
-			impl->drawer->drawRow (context, rowSize, {row + getMinRowIndex (), flags});
-		}
-		rowSize.offset (0, impl->rowDescriptions[row].height);
+		CRect rowSize;
+		rowSize.setTopLeft (getViewSize ().getTopLeft ());
+		rowSize.setWidth (getWidth ());
+		rowSize.setHeight (impl->getRowHeight (row));
+		rowSize.offset (0, impl->getRowTop (row));
+		if (rowSize.top >= updateRect.bottom)
+			break;
+		if (!updateRect.rectOverlap (rowSize))
+			continue;
+		auto rowIndex = static_cast<int32_t> (row) + getMinRowIndex ();
+		int32_t flags = selectedRow == row ? IListControlDrawer::Row::Selected : 0;
+		if (getRowDesc (rowIndex).flags & CListControlRowDesc::Selectable)
+			flags |= IListControlDrawer::Row::Selectable;
+		if (impl->hoveredRow && *impl->hoveredRow == rowIndex)
+			flags |= IListControlDrawer::Row::Hovered;
+		if (row == numRows - 1)
+			flags |= IListControlDrawer::Row::LastRow;
+		impl->drawer->drawRow (context, rowSize, {rowIndex, flags});
 	}
 }
 
@@ -264,8 +317,7 @@ CMouseEventResult CListControl::onMouseMoved (CPoint& where, const CButtonState&
 		auto row = getRowAtPoint (where);
 		if (row)
 		{
-			if (impl->rowDescriptions[getNormalizedRowIndex (*row)].flags &
-			    CListControlRowDesc::Hoverable)
+			if (getRowDesc (*row).flags & CListControlRowDesc::Hoverable)
 			{
 				if (!impl->hoveredRow || *impl->hoveredRow != *row)
 				{
@@ -286,7 +338,7 @@ CMouseEventResult CListControl::onMouseMoved (CPoint& where, const CButtonState&
 //------------------------------------------------------------------------
 CMouseEventResult CListControl::onMouseUp (CPoint& where, const CButtonState& buttons)
 {
-	if (impl->rowDescriptions.empty () || !buttons.isLeftButton ())
+	if (impl->numRows == 0 || !buttons.isLeftButton ())
 		return kMouseEventHandled;
 
 	auto row = getRowAtPoint (where);
@@ -344,11 +396,18 @@ int32_t CListControl::getNextSelectableRow (int32_t r, int32_t direction) const
 	return row;
 }
 
+//------------------------------------------------------------------------
+CListControlRowDesc CListControl::getRowDesc (int32_t row) const
+{
+	if (impl->uniformRows)
+		return impl->configurator->getRowDesc (static_cast<int32_t> (getNormalizedRowIndex (row)));
+	return impl->rowDescriptions[getNormalizedRowIndex (row)];
+}
+
 //------------------------------------------------------------------------
 bool CListControl::rowSelectable (int32_t row) const
 {
-	return (impl->rowDescriptions[getNormalizedRowIndex (row)].flags &
-	        CListControlRowDesc::Selectable) != 0;
+	return (getRowDesc (row).flags & CListControlRowDesc::Selectable) != 0;
 }
 
 //------------------------------------------------------------------------
@@ -20,6 +20,9 @@ namespace VSTGUI {
  *	handled via the IListControlConfigurator instance. Every row can have different heights and
  *	flags.
  *
+ *	If the configurator reports a uniform row height, the row descriptions are only requested for
+ *	the rows which are drawn or hit-tested, so the control scales to large numbers of rows.
+ *
  *	@ingroup new_in_4_9
  */
 //------------------------------------------------------------------------
@@ -67,6 +70,7 @@ private:
 	int32_t getMinRowIndex () const;
 	int32_t getMaxRowIndex () const;
 	size_t getNormalizedRowIndex (int32_t row) const;
+	CListControlRowDesc getRowDesc (int32_t row) const;
 	bool rowSelectable (int32_t row) const;
 	void clearHoveredRow ();
 
@@ -154,6 +158,15 @@ public:
 	virtual ~IListControlConfigurator () noexcept {}
 
 	virtual CListControlRowDesc getRowDesc (int32_t row) const = 0;
+
+	/** return the height of all rows if all rows have the same height
+	 *
+	 *	In this case the CListControl does not query all row descriptions when the layout is
+	 *	recalculated, but only the ones it needs to draw or hit-test.
+	 *
+	 *	@ingroup new_in_4_11
+	 */
+	virtual Optional<CCoord> getUniformRowHeight () const { return {}; }
 };
 
 //------------------------------------------------------------------------
@@ -180,11 +193,29 @@ public:
 	CCoord getRowHeight () const { return rowHeight; }
 	int32_t getFlags () const { return flags; }
 
+	/** declare that all rows have the row height, so that the list control only queries the row
+	 *	descriptions it needs. Off by default, as subclasses may return other heights via
+	 *	getRowDesc.
+	 *
+	 *	@ingroup new_in_4_11
+	 */
+	void setUniformRowHeight (bool state) { uniformRowHeight = state; }
+	/** @ingroup new_in_4_11 */
+	bool hasUniformRowHeight () const { return uniformRowHeight; }
+
 	CListControlRowDesc getRowDesc (int32_t row) const override { return {rowHeight, flags}; }
 
+	Optional<CCoord> getUniformRowHeight () const override
+	{
+		if (uniformRowHeight)
+			return makeOptional (rowHeight);
+		return {};
+	}
+
 private:
 	CCoord rowHeight;
 	int32_t flags;
+	bool uniformRowHeight {false};
 };
 
 //------------------------------------------------------------------------
@@ -27,8 +27,11 @@ CMovieBitmap::CMovieBitmap (const CRect& size, IControlListener* listener, int32
 : CControl (size, listener, tag, background)
 , offset (offset)
 {
-	setHeightOfOneImage (size.getHeight ());
-	setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		setHeightOfOneImage (size.getHeight ());
+		setNumSubPixmaps (background ? (int32_t)(background->getHeight () / heightOfOneImage) : 0);
+	}
 }
 
 //------------------------------------------------------------------------
@@ -65,21 +68,18 @@ void CMovieBitmap::draw (CDrawContext *pContext)
 {
 	if (auto bitmap = getDrawBackground ())
 	{
-		CPoint where (offset.x, offset.y);
-
+		int32_t frameIndex;
 		if (useLegacyFrameCalculation)
 		{
-			where.y += heightOfOneImage *
-			           (int32_t) (getValueNormalized () * (getNumSubPixmaps () - 1) + 0.5);
+			frameIndex = (int32_t) (getValueNormalized () * (getNumSubPixmaps () - 1) + 0.5);
 		}
 		else
 		{
-			auto step = static_cast<int32_t> (
+			frameIndex = static_cast<int32_t> (
 			    std::min (getNumSubPixmaps () - 1.f, getValueNormalized () * getNumSubPixmaps ()));
-			where.y += heightOfOneImage * step;
 		}
 
-		bitmap->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, bitmap, getViewSize (), frameIndex, offset);
 	}
 	setDirty (false);
 }
@@ -90,7 +90,7 @@ bool CMovieBitmap::sizeToFit ()
 	if (getDrawBackground ())
 	{
 		CRect vs (getViewSize ());
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		vs.setHeight (getHeightOfOneImage ());
 		setViewSize (vs);
 		setMouseableArea (vs);
@@ -24,7 +24,8 @@ namespace VSTGUI {
 CMovieButton::CMovieButton (const CRect& size, IControlListener* listener, int32_t tag, CBitmap* background, const CPoint &offset)
 : CControl (size, listener, tag, background), offset (offset), buttonState (value)
 {
-	heightOfOneImage = size.getHeight ();
+	if (!updateFromMultiFrameBitmap (background))
+		heightOfOneImage = size.getHeight ();
 	setWantsFocus (true);
 }
 
@@ -61,18 +62,11 @@ CMovieButton::CMovieButton (const CMovieButton& v)
 //------------------------------------------------------------------------
 void CMovieButton::draw (CDrawContext *pContext)
 {
-	CPoint where;
-
-	where.x = 0;
-
-	if (value == getMax ())
-		where.y = heightOfOneImage;
-	else
-		where.y = 0;
+	int32_t frameIndex = (value == getMax ()) ? 1 : 0;
 
 	if (getDrawBackground ())
 	{
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), frameIndex);
 	}
 	buttonState = value;
 
@@ -158,7 +152,7 @@ bool CMovieButton::sizeToFit ()
 	if (getDrawBackground ())
 	{
 		CRect vs (getViewSize ());
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		vs.setHeight (getHeightOfOneImage ());
 		setViewSize (vs);
 		setMouseableArea (vs);
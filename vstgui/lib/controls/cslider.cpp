@@ -745,6 +745,14 @@ CPoint CSlider::getBackgroundOffset () const
 	return impl->backgroundOffset;
 }
 
+//------------------------------------------------------------------------
+void CSlider::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	CSliderBase::getDrawBitmaps (bitmaps);
+	if (impl->pHandle)
+		bitmaps.emplace_back (impl->pHandle);
+}
+
 //------------------------------------------------------------------------
 void CSlider::draw (CDrawContext* pContext)
 {
@@ -157,6 +157,7 @@ public:
 
 	// overrides
 	void draw (CDrawContext*) override;
+	void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const override;
 	bool sizeToFit () override;
 
 	CLASS_METHODS (CSlider, CControl)
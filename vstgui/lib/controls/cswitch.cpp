@@ -49,10 +49,7 @@ void CSwitchBase::draw (CDrawContext* pContext)
 		float norm = getValueNormalized ();
 		if (inverseBitmap)
 			norm = 1.f - norm;
-		// source position in bitmap
-		CPoint where (0, heightOfOneImage * normalizedToIndex (norm));
-
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), normalizedToIndex (norm));
 	}
 	setDirty (false);
 }
@@ -63,7 +60,7 @@ bool CSwitchBase::sizeToFit ()
 	if (getDrawBackground ())
 	{
 		CRect vs (getViewSize ());
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		vs.setHeight (getHeightOfOneImage ());
 		setViewSize (vs);
 		setMouseableArea (vs);
@@ -168,9 +165,12 @@ CVerticalSwitch::CVerticalSwitch (const CRect& size, IControlListener* listener,
                                   CBitmap* background, const CPoint& offset)
 : CSwitchBase (size, listener, tag, background, offset)
 {
-	heightOfOneImage = size.getHeight ();
-	setNumSubPixmaps (
-	    background ? static_cast<int32_t> (background->getHeight () / heightOfOneImage) : 0);
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		heightOfOneImage = size.getHeight ();
+		setNumSubPixmaps (
+		    background ? static_cast<int32_t> (background->getHeight () / heightOfOneImage) : 0);
+	}
 }
 
 //------------------------------------------------------------------------
@@ -263,8 +263,11 @@ CHorizontalSwitch::CHorizontalSwitch (const CRect& size, IControlListener* liste
                                       CBitmap* background, const CPoint& offset)
 : CSwitchBase (size, listener, tag, background, offset)
 {
-	heightOfOneImage = size.getWidth ();
-	setNumSubPixmaps (background ? (int32_t) (background->getWidth () / heightOfOneImage) : 0);
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		heightOfOneImage = size.getWidth ();
+		setNumSubPixmaps (background ? (int32_t) (background->getWidth () / heightOfOneImage) : 0);
+	}
 }
 
 //------------------------------------------------------------------------
@@ -297,7 +300,7 @@ CHorizontalSwitch::CHorizontalSwitch (const CHorizontalSwitch& v)
 //------------------------------------------------------------------------
 double CHorizontalSwitch::calculateCoef () const
 {
-	return getDrawBackground ()->getWidth () / static_cast<double> (getNumSubPixmaps ());
+	return getBitmapFrameWidth (getDrawBackground ()) / static_cast<double> (getNumSubPixmaps ());
 }
 
 //------------------------------------------------------------------------
@@ -362,8 +365,11 @@ CRockerSwitch::CRockerSwitch (const CRect& size, IControlListener* listener, int
 , style (style)
 , resetValueTimer (nullptr)
 {
-	setNumSubPixmaps (3);
-	setHeightOfOneImage (size.getHeight ());
+	if (!updateFromMultiFrameBitmap (background))
+	{
+		setNumSubPixmaps (3);
+		setHeightOfOneImage (size.getHeight ());
+	}
 	setWantsFocus (true);
 	setMin (-1.f);
 	setMax (1.f);
@@ -417,16 +423,16 @@ CRockerSwitch::~CRockerSwitch () noexcept
 //------------------------------------------------------------------------
 void CRockerSwitch::draw (CDrawContext *pContext)
 {
-	CPoint where (offset.x, offset.y);
+	int32_t frameIndex = 0;
 
 	if (value == getMax ())
-		where.y += 2 * heightOfOneImage;
+		frameIndex = 2;
 	else if (value == (getMax () - getMin ()) / 2.f + getMin ())
-		where.y += heightOfOneImage;
+		frameIndex = 1;
 
 	if (getDrawBackground ())
 	{
-		getDrawBackground ()->draw (pContext, getViewSize (), where);
+		drawBitmapFrame (pContext, getDrawBackground (), getViewSize (), frameIndex, offset);
 	}
 	setDirty (false);
 }
@@ -606,7 +612,7 @@ bool CRockerSwitch::sizeToFit ()
 	if (getDrawBackground ())
 	{
 		CRect vs (getViewSize ());
-		vs.setWidth (getDrawBackground ()->getWidth ());
+		vs.setWidth (getBitmapFrameWidth (getDrawBackground ()));
 		vs.setHeight (getHeightOfOneImage ());
 		setViewSize (vs);
 		setMouseableArea (vs);
@@ -6,7 +6,10 @@
 #include "../coffscreencontext.h"
 #include "../cbitmap.h"
 #include "../cvstguitimer.h"
+#include "../platform/platformfactory.h"
+#include <algorithm>
 #include <list>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -35,8 +38,6 @@ CVuMeter::CVuMeter (const CRect& size, CBitmap* onBitmap, CBitmap* offBitmap, in
 
 	rectOn  (size.left, size.top, size.right, size.bottom);
 	rectOff (size.left, size.top, size.right, size.bottom);
-
-	setWantsIdle (true);
 }
 
 //------------------------------------------------------------------------
@@ -48,9 +49,9 @@ CVuMeter::CVuMeter (const CVuMeter& v)
 , decreaseValue (v.decreaseValue)
 , rectOn (v.rectOn)
 , rectOff (v.rectOff)
+, peakHoldTime (v.peakHoldTime)
 {
 	setOffBitmap (v.offBitmap);
-	setWantsIdle (true);
 }
 
 //------------------------------------------------------------------------
@@ -93,17 +94,242 @@ void CVuMeter::setOffBitmap (CBitmap* bitmap)
 		offBitmap->remember ();
 }
 
+//------------------------------------------------------------------------
+void CVuMeter::setPeakHoldTime (uint32_t milliseconds)
+{
+	peakHoldTime = milliseconds;
+	resetPeak ();
+}
+
+//------------------------------------------------------------------------
+void CVuMeter::resetPeak ()
+{
+	CRect r;
+	if (getPeakRect (getOldValue (), r))
+		invalidRect (r);
+	peakValue = getOldValue ();
+	peakTime = 0;
+}
+
+//------------------------------------------------------------------------
+void CVuMeter::setValues (CVuMeter* const* meters, const float* values, size_t numMeters)
+{
+	struct Damage
+	{
+		CView* parent;
+		CRect rect;
+	};
+	std::vector<Damage> damages;
+	for (auto i = 0u; i < numMeters; ++i)
+	{
+		auto meter = meters[i];
+		// the meters are invalidated here and not by the next idle of the frame
+		meter->CControl::setValue (values[i]);
+		if (!meter->isAttached () || !meter->isVisible ())
+			continue;
+		auto rect = meter->updateDisplayValue (std::max (meter->getOldValue (), meter->getValue ()));
+		if (meter->isDecaying ())
+			meter->requestIdle ();
+		if (rect.isEmpty ())
+			continue;
+		auto parent = meter->getParentView ();
+		auto it = std::find_if (damages.begin (), damages.end (),
+								[&] (const Damage& d) { return d.parent == parent; });
+		if (it == damages.end ())
+			damages.push_back ({parent, rect});
+		else
+			it->rect.unite (rect);
+	}
+	for (auto& damage : damages)
+		damage.parent->invalidRect (damage.rect);
+}
+
+//------------------------------------------------------------------------
+void CVuMeter::setValue (float val)
+{
+	CControl::setValue (val);
+	// hosts may set the value from any thread, so the meter is only marked dirty here. Without
+	// kDirtyCallAlwaysOnMainThread the frame invalidates it with its next idle on the main thread,
+	// otherwise the host has to call setDirty on the main thread.
+	if (!kDirtyCallAlwaysOnMainThread && getOldValue () != getValue ())
+		CView::setDirty (true);
+}
+
 //------------------------------------------------------------------------
 void CVuMeter::setDirty (bool state)
 {
+	if (state && kDirtyCallAlwaysOnMainThread && isAttached () && !isDrawingConcurrently ())
+	{
+		// only the changed LEDs are invalidated
+		showValue ();
+		return;
+	}
 	CView::setDirty (state);
 }
 
+//------------------------------------------------------------------------
+void CVuMeter::invalid ()
+{
+	// called on the main thread, also by the frame for a meter which was set dirty
+	if (isAttached () && !isDrawingConcurrently ())
+		showValue ();
+	CControl::invalid ();
+}
+
+//------------------------------------------------------------------------
+void CVuMeter::showValue ()
+{
+	// a rising value is shown immediately, the decay is invalidated in onIdle
+	bounceValue ();
+	auto damage = updateDisplayValue (std::max (getOldValue (), value));
+	if (!damage.isEmpty ())
+		invalidRect (damage);
+	if (isDecaying ())
+		requestIdle ();
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::isDirty () const
+{
+	// the old value is the displayed value which differs from the value while it decreases
+	return CView::isDirty ();
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::attached (CView* parent)
+{
+	if (!CControl::attached (parent))
+		return false;
+	if (isDecaying ())
+		requestIdle ();
+	return true;
+}
+
 //------------------------------------------------------------------------
 void CVuMeter::onIdle ()
 {
-	if (getOldValue () != value)
-		invalid ();
+	bounceValue ();
+	auto damage = updateDisplayValue (getNextDisplayValue ());
+	if (!damage.isEmpty ())
+		invalidRect (damage);
+	// the idle timer only runs while the meter decreases or holds a peak
+	if (isDecaying () && !wantsIdle ())
+		requestIdle ();
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::isDecaying () const
+{
+	return getOldValue () != value || (peakHoldTime && peakValue > getOldValue ());
+}
+
+//------------------------------------------------------------------------
+float CVuMeter::getNextDisplayValue () const
+{
+	return std::max (getOldValue () - decreaseValue, value);
+}
+
+//------------------------------------------------------------------------
+CCoord CVuMeter::getLedBoundary (float displayValue) const
+{
+	auto normValue = (displayValue - getMin ()) / getRange ();
+	if (style & kHorizontal)
+		return (int32_t)(nbLed * normValue + 0.5f) * getOnBitmap ()->getWidth () / nbLed;
+	return (int32_t)(nbLed * (1.f - normValue) + 0.5f) * getOnBitmap ()->getHeight () / nbLed;
+}
+
+//------------------------------------------------------------------------
+CRect CVuMeter::getLedRect (CCoord boundary1, CCoord boundary2) const
+{
+	CRect r (rectOn);
+	if (style & kHorizontal)
+	{
+		r.left = rectOn.left + std::min (boundary1, boundary2);
+		r.right = rectOn.left + std::max (boundary1, boundary2);
+	}
+	else
+	{
+		r.top = rectOn.top + std::min (boundary1, boundary2);
+		r.bottom = rectOn.top + std::max (boundary1, boundary2);
+	}
+	return r.bound (getViewSize ());
+}
+
+//------------------------------------------------------------------------
+bool CVuMeter::getPeakRect (float displayValue, CRect& r) const
+{
+	if (peakHoldTime == 0 || nbLed <= 0 || !getOnBitmap ())
+		return false;
+	auto boundary = getLedBoundary (displayValue);
+	auto peakBoundary = getLedBoundary (peakValue);
+	if (style & kHorizontal)
+	{
+		if (peakBoundary <= boundary)
+			return false;
+		r = getLedRect (peakBoundary - getOnBitmap ()->getWidth () / nbLed, peakBoundary);
+	}
+	else
+	{
+		if (peakBoundary >= boundary)
+			return false;
+		r = getLedRect (peakBoundary, peakBoundary + getOnBitmap ()->getHeight () / nbLed);
+	}
+	return !r.isEmpty ();
+}
+
+//------------------------------------------------------------------------
+CRect CVuMeter::updateDisplayValue (float newDisplayValue)
+{
+	CRect damage;
+	auto addDamage = [&] (const CRect& r) {
+		if (damage.isEmpty ())
+			damage = r;
+		else
+			damage.unite (r);
+	};
+	auto oldDisplayValue = getOldValue ();
+	if (!getOnBitmap ())
+	{
+		setOldValue (newDisplayValue);
+		return damage;
+	}
+	CRect oldPeakRect;
+	auto hadPeak = getPeakRect (oldDisplayValue, oldPeakRect);
+	if (peakHoldTime)
+	{
+		auto now = getPlatformFactory ().getTicks ();
+		if (newDisplayValue >= peakValue)
+		{
+			peakValue = newDisplayValue;
+			peakTime = now;
+		}
+		else if (now - peakTime >= peakHoldTime)
+			peakValue = newDisplayValue;
+	}
+	setOldValue (newDisplayValue);
+
+	auto oldBoundary = getLedBoundary (oldDisplayValue);
+	auto newBoundary = getLedBoundary (newDisplayValue);
+	if (oldBoundary != newBoundary)
+		addDamage (getLedRect (oldBoundary, newBoundary));
+	CRect newPeakRect;
+	auto hasPeak = getPeakRect (newDisplayValue, newPeakRect);
+	if (hadPeak != hasPeak || oldPeakRect != newPeakRect)
+	{
+		if (hadPeak)
+			addDamage (oldPeakRect);
+		if (hasPeak)
+			addDamage (newPeakRect);
+	}
+	return damage;
+}
+
+//------------------------------------------------------------------------
+void CVuMeter::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	CControl::getDrawBitmaps (bitmaps);
+	if (offBitmap)
+		bitmaps.emplace_back (offBitmap);
 }
 
 //------------------------------------------------------------------------
@@ -118,18 +344,9 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	CPoint pointOff;
 	CDrawContext *pContext = _pContext;
 
-	bounceValue ();
-	
-	float newValue = getOldValue () - decreaseValue;
-	if (newValue < value)
-		newValue = value;
-	setOldValue (newValue);
-
-	newValue = (newValue - getMin ()) / getRange (); // normalize
-	
+	auto tmp = getLedBoundary (getOldValue ());
 	if (style & kHorizontal) 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * newValue + 0.5f) / (float)nbLed) * getOnBitmap ()->getWidth ());
 		pointOff (tmp, 0);
 
 		_rectOff.left += tmp;
@@ -137,7 +354,6 @@ void CVuMeter::draw (CDrawContext *_pContext)
 	}
 	else 
 	{
-		auto tmp = (CCoord)(((int32_t)(nbLed * (1.f - newValue) + 0.5f) / (float)nbLed) * getOnBitmap ()->getHeight ());
 		pointOn (0, tmp);
 
 		_rectOff.bottom = tmp + rectOff.top;
@@ -151,6 +367,13 @@ void CVuMeter::draw (CDrawContext *_pContext)
 
 	getOnBitmap ()->draw (pContext, _rectOn, pointOn);
 
+	CRect peakRect;
+	if (getPeakRect (getOldValue (), peakRect))
+	{
+		CPoint peakOffset (peakRect.left - rectOn.left, peakRect.top - rectOn.top);
+		getOnBitmap ()->draw (pContext, peakRect, peakOffset);
+	}
+
 	setDirty (false);
 }
 
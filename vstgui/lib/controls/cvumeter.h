@@ -40,7 +40,7 @@ public:
 
 	virtual CBitmap* getOnBitmap () const { return getBackground (); }
 	virtual CBitmap* getOffBitmap () const { return offBitmap; }
-	virtual void setOnBitmap (CBitmap* bitmap) { setBackground (bitmap); }
+	virtual void setOnBitmap (CBitmap* bitmap) { setBackground (bitmap); invalid (); }
 	virtual void setOffBitmap (CBitmap* bitmap);
 	
 	int32_t getNbLed () const { return nbLed; }
@@ -48,15 +48,39 @@ public:
 	
 	void setStyle (int32_t newStyle) { style = newStyle; invalid (); }
 	int32_t getStyle () const { return style; }
+
+	/** set the time in milliseconds the highest LED stays lit after the value decreased. 0 disables
+	 *	the peak hold indicator.
+	 *	@ingroup new_in_4_11
+	 */
+	void setPeakHoldTime (uint32_t milliseconds);
+	/** @ingroup new_in_4_11 */
+	uint32_t getPeakHoldTime () const { return peakHoldTime; }
+	/** @ingroup new_in_4_11 */
+	float getPeakValue () const { return peakValue; }
+	/** @ingroup new_in_4_11 */
+	void resetPeak ();
 	//@}
 
+	/** set the values of many meters at once.
+	 *
+	 *	Only the LEDs which changed are invalidated, merged into one invalidation per parent view.
+	 *	Must be called on the main thread.
+	 *	@ingroup new_in_4_11
+	 */
+	static void setValues (CVuMeter* const* meters, const float* values, size_t numMeters);
 
 	// overrides
+	void setValue (float val) override;
 	void setDirty (bool state) override;
+	void invalid () override;
+	bool isDirty () const override;
 	void draw (CDrawContext* pContext) override;
+	void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const override;
 	void setViewSize (const CRect& newSize, bool invalid = true) override;
 	bool sizeToFit () override;
 	void onIdle () override;
+	bool attached (CView* parent) override;
 	
 	CLASS_METHODS(CVuMeter, CControl)
 protected:
@@ -70,6 +94,19 @@ protected:
 
 	CRect    rectOn;
 	CRect    rectOff;
+
+private:
+	float getNextDisplayValue () const;
+	bool isDecaying () const;
+	void showValue ();
+	CCoord getLedBoundary (float displayValue) const;
+	bool getPeakRect (float displayValue, CRect& r) const;
+	CRect getLedRect (CCoord boundary1, CCoord boundary2) const;
+	CRect updateDisplayValue (float newDisplayValue);
+
+	float peakValue {0.f};
+	uint32_t peakHoldTime {0};
+	uint64_t peakTime {0};
 };
 
 } // VSTGUI
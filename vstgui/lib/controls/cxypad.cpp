@@ -29,6 +29,14 @@ CBitmap* CXYPad::getHandleBitmap () const
 	return handle;
 }
 
+//------------------------------------------------------------------------
+void CXYPad::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	CParamDisplay::getDrawBitmaps (bitmaps);
+	if (handle)
+		bitmaps.emplace_back (handle);
+}
+
 //------------------------------------------------------------------------
 void CXYPad::draw (CDrawContext* context)
 {
@@ -23,6 +23,7 @@ public:
 	CBitmap* getHandleBitmap () const;
 
 	void draw (CDrawContext* context) override;
+	void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const override;
 	void drawBack (CDrawContext* pContext, CBitmap* newBack = nullptr) override;
 
 	void onMouseDownEvent (MouseDownEvent& event) override;
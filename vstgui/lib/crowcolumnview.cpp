@@ -194,7 +194,7 @@ void CRowColumnView::layoutViews ()
 //--------------------------------------------------------------------------------
 bool CRowColumnView::sizeToFit ()
 {
-	if (!getChildren ().empty ())
+	if (!getChildViews ().empty ())
 	{
 		CRect viewSize = getViewSize ();
 		CPoint maxSize;
@@ -6,18 +6,20 @@
 #include "cdrawcontext.h"
 #include "cbitmap.h"
 #include "cframe.h"
+#include "cviewcontainer.h"
 #include "cvstguitimer.h"
 #include "cgraphicspath.h"
 #include "dispatchlist.h"
 #include "idatapackage.h"
 #include "iviewlistener.h"
-#include "malloc.h"
 #include "events.h"
 #include "animation/animator.h"
 #include "../uidescription/icontroller.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
 #include <cassert>
-#include <unordered_map>
+#include <cstring>
+#include <vector>
 #if DEBUG
 #include <list>
 #include <typeinfo>
@@ -59,10 +61,14 @@ public:
 class AttributeEntry
 {
 public:
-	AttributeEntry (uint32_t _size, const void* _data)
+	/** attributes up to this size are stored inside of the entry */
+	static constexpr uint32_t kInlineSize = 16;
+
+	AttributeEntry (CViewAttributeID id, uint32_t _size, const void* _data) : id (id)
 	{
 		updateData (_size, _data);
 	}
+	~AttributeEntry () noexcept { freeData (); }
 	
 	AttributeEntry (const AttributeEntry& me) = delete;
 	AttributeEntry& operator= (const AttributeEntry& me) = delete;
@@ -73,24 +79,97 @@ public:
 	
 	AttributeEntry& operator=(AttributeEntry&& me) noexcept
 	{
-		data = std::move (me.data);
+		freeData ();
+		id = me.id;
+		size = me.size;
+		if (size > kInlineSize)
+			heapData = me.heapData;
+		else
+			std::memcpy (inlineData, me.inlineData, size);
+		me.size = 0;
 		return *this;
 	}
 	
-	uint32_t getSize () const { return static_cast<uint32_t> (data.size ()); }
-	const void* getData () const { return data.get (); }
+	CViewAttributeID getID () const { return id; }
+	uint32_t getSize () const { return size; }
+	const void* getData () const { return size > kInlineSize ? heapData : inlineData; }
 	
 	void updateData (uint32_t _size, const void* _data)
 	{
-		data.allocate (_size);
-		if (!data.empty ())
+		if (_size != size)
 		{
-			std::memcpy (data.get (), _data, data.size ());
+			freeData ();
+			if (_size > kInlineSize)
+				heapData = new int8_t[_size];
+			size = _size;
 		}
+		std::memcpy (const_cast<void*> (getData ()), _data, size);
 	}
 	
-protected:
-	Buffer<int8_t> data;
+private:
+	void freeData ()
+	{
+		if (size > kInlineSize)
+			delete[] heapData;
+		size = 0;
+	}
+
+	CViewAttributeID id {0};
+	uint32_t size {0};
+	union
+	{
+		int8_t inlineData[kInlineSize];
+		int8_t* heapData;
+	};
+};
+
+//-----------------------------------------------------------------------------
+/** the attributes of a view in a vector sorted by their id */
+class AttributeList
+{
+public:
+	using Entries = std::vector<AttributeEntry>;
+
+	const AttributeEntry* find (CViewAttributeID id) const
+	{
+		auto it = lowerBound (id);
+		if (it != entries.end () && it->getID () == id)
+			return &(*it);
+		return nullptr;
+	}
+
+	void set (CViewAttributeID id, uint32_t size, const void* data)
+	{
+		auto it = lowerBound (id);
+		if (it != entries.end () && it->getID () == id)
+			entries[static_cast<size_t> (it - entries.begin ())].updateData (size, data);
+		else
+			entries.emplace (it, id, size, data);
+	}
+
+	bool remove (CViewAttributeID id)
+	{
+		auto it = lowerBound (id);
+		if (it == entries.end () || it->getID () != id)
+			return false;
+		entries.erase (it);
+		return true;
+	}
+
+	void clear () { Entries ().swap (entries); }
+
+	Entries::const_iterator begin () const { return entries.begin (); }
+	Entries::const_iterator end () const { return entries.end (); }
+
+private:
+	Entries::const_iterator lowerBound (CViewAttributeID id) const
+	{
+		return std::lower_bound (
+			entries.begin (), entries.end (), id,
+			[] (const AttributeEntry& entry, CViewAttributeID i) { return entry.getID () < i; });
+	}
+
+	Entries entries;
 };
 
 //-----------------------------------------------------------------------------
@@ -99,9 +178,7 @@ class IdleViewUpdater
 public:
 	static void add (CView* view)
 	{
-		if (gInstance == nullptr)
-			gInstance = std::unique_ptr<IdleViewUpdater> (new IdleViewUpdater ());
-		gInstance->views.emplace_back (view);
+		getInstance ().views.emplace_back (view);
 	}
 	
 	static void remove (CView* view)
@@ -109,41 +186,98 @@ public:
 		if (gInstance)
 		{
 			gInstance->views.remove (view);
-			if (!gInstance->inTimer && gInstance->views.empty ())
-			{
-				gInstance = nullptr;
-			}
+			gInstance->releaseIfUnused ();
 		}
 	}
-	
+
+	static void request (CView* view)
+	{
+		auto& requests = getInstance ().requests;
+		if (std::find (requests.begin (), requests.end (), view) == requests.end ())
+			requests.emplace_back (view);
+	}
+
+	static void cancelRequest (CView* view)
+	{
+		if (gInstance)
+		{
+			gInstance->removeRequest (view);
+			gInstance->releaseIfUnused ();
+		}
+	}
+
+	static bool isRunning () { return gInstance != nullptr; }
+
+	static IdleCounters counters;
+
 protected:
 	using ViewContainer = std::list<CView*>;
+	using RequestList = std::vector<CView*>;
 	
 	IdleViewUpdater ()
 	{
 		timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { onTimer (); }, 1000/CView::idleRate);
 	}
+
+	static IdleViewUpdater& getInstance ()
+	{
+		if (gInstance == nullptr)
+			gInstance = std::unique_ptr<IdleViewUpdater> (new IdleViewUpdater ());
+		return *gInstance;
+	}
+
+	void removeRequest (CView* view)
+	{
+		auto it = std::find (requests.begin (), requests.end (), view);
+		if (it != requests.end ())
+			requests.erase (it);
+		// the view may be removed while the requests of the current tick are dispatched
+		std::replace (dispatchedRequests.begin (), dispatchedRequests.end (), view,
+					  static_cast<CView*> (nullptr));
+	}
+
+	void releaseIfUnused ()
+	{
+		// the timer only runs while there are views which want or requested idle
+		if (!inTimer && views.empty () && requests.empty ())
+			gInstance = nullptr;
+	}
 	
 	void onTimer ()
 	{
 		inTimer = true;
+		++counters.timerCallbacks;
+		// views requesting idle again in onIdle are called with the next tick
+		dispatchedRequests.swap (requests);
+		for (auto view : dispatchedRequests)
+		{
+			if (view == nullptr)
+				continue;
+			++counters.onIdleCalls;
+			view->onIdle ();
+		}
+		dispatchedRequests.clear ();
 		for (ViewContainer::const_iterator it = views.begin (); it != views.end ();)
 		{
 			CView* view = (*it);
 			++it;
+			++counters.onIdleCalls;
 			view->onIdle ();
 		}
 		inTimer = false;
-		if (views.empty ())
+		if (views.empty () && requests.empty ())
 			gInstance = nullptr;
 	}
 	SharedPointer<CVSTGUITimer> timer;
 	ViewContainer views;
+	RequestList requests;
+	RequestList dispatchedRequests;
 	bool inTimer {false};
 	
 	static std::unique_ptr<IdleViewUpdater> gInstance;
 };
 std::unique_ptr<IdleViewUpdater> IdleViewUpdater::gInstance;
+IdleCounters IdleViewUpdater::counters;
 
 } // CViewInternal
 
@@ -164,24 +298,22 @@ IdStringPtr kMsgViewSizeChanged = "kMsgViewSizeChanged";
 
 bool CView::kDirtyCallAlwaysOnMainThread = false;
 
+//-----------------------------------------------------------------------------
+static thread_local bool gDrawingConcurrently = false;
+
 //-----------------------------------------------------------------------------
 static constexpr CViewAttributeID kCViewHitTestPathAttrID = 'cvht';
 static constexpr CViewAttributeID kCViewCustomDropTargetAttrID = 'cvdt';
-static constexpr CViewAttributeID kCViewAlphaValueAttrID = 'cvav';
-static constexpr CViewAttributeID kCViewMouseableAreaAttrID = 'cvma';
-static constexpr CViewAttributeID kCViewBackgroundBitmapAttrID = 'cvbb';
-static constexpr CViewAttributeID kCViewDisabledBackgroundBitmapAttrID = 'cvdb';
 
 //-----------------------------------------------------------------------------
 // CView
 //-----------------------------------------------------------------------------
 struct CView::Impl
 {
-	using ViewAttributes = std::unordered_map<CViewAttributeID, std::unique_ptr<CViewInternal::AttributeEntry>>;
 	using ViewListenerDispatcher = DispatchList<IViewListener*>;
 	using ViewEventListenerDispatcher = DispatchList<IViewEventListener*>;
 
-	ViewAttributes attributes;
+	CViewInternal::AttributeList attributes;
 	std::unique_ptr<ViewListenerDispatcher> viewListeners;
 	std::unique_ptr<ViewEventListenerDispatcher> viewEventListeners;
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -191,10 +323,16 @@ struct CView::Impl
 #include "private/enabledeprecatedmessage.h"
 #endif
 	CRect size;
-	int32_t viewFlags {0};
-	int32_t autosizeFlags {kAutosizeNone};
+	// the frequently used properties are not stored as attributes
+	CRect mouseableArea;
+	SharedPointer<CBitmap> background;
+	SharedPointer<CBitmap> disabledBackground;
 	CFrame* parentFrame {nullptr};
 	CView* parentView {nullptr};
+	int32_t viewFlags {0};
+	int32_t autosizeFlags {kAutosizeNone};
+	float alphaValue {1.f};
+	bool threadSafeDrawing {false};
 };
 
 //-----------------------------------------------------------------------------
@@ -219,14 +357,17 @@ CView::CView (const CView& v)
 	pImpl->size = v.pImpl->size;
 	pImpl->viewFlags = v.pImpl->viewFlags;
 	pImpl->autosizeFlags = v.pImpl->autosizeFlags;
+	pImpl->threadSafeDrawing = v.pImpl->threadSafeDrawing;
 
 	setMouseableArea (v.getMouseableArea ());
 	setHitTestPath (v.getHitTestPath ());
 	setBackground (v.getBackground ());
 	setDisabledBackground (v.getDisabledBackground ());
 
+	setAlphaValueNoInvalidate (v.getAlphaValue ());
+
 	for (auto& attribute : v.pImpl->attributes)
-		setAttribute (attribute.first, attribute.second->getSize (), attribute.second->getData ());
+		setAttribute (attribute.getID (), attribute.getSize (), attribute.getData ());
 }
 
 //-----------------------------------------------------------------------------
@@ -277,16 +418,20 @@ void CView::beforeDelete ()
 //-----------------------------------------------------------------------------
 void CView::setMouseableArea (const CRect& rect)
 {
-	if (pImpl->size == rect)
-	{
-		setViewFlag (kHasMouseableArea, false);
-		removeAttribute (kCViewMouseableAreaAttrID);
-	}
-	else
-	{
-		setViewFlag (kHasMouseableArea, true);
-		setAttribute (kCViewMouseableAreaAttrID, rect);
-	}
+	pImpl->mouseableArea = rect;
+	setViewFlag (kHasMouseableArea, pImpl->size != rect);
+	if (auto parent = pImpl->parentView)
+		parent->asViewContainer ()->childViewBoundsChanged ();
+}
+
+//-----------------------------------------------------------------------------
+void CView::setDrawsOutsideBounds (bool state)
+{
+	if (drawsOutsideBounds () == state)
+		return;
+	setViewFlag (kDrawsOutsideBounds, state);
+	if (auto parent = pImpl->parentView)
+		parent->asViewContainer ()->childViewBoundsChanged ();
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -302,11 +447,7 @@ CRect& CView::getMouseableArea (CRect& rect) const
 CRect CView::getMouseableArea () const
 {
 	if (hasViewFlag (kHasMouseableArea))
-	{
-		CRect r;
-		if (getAttribute (kCViewMouseableAreaAttrID, r))
-			return r;
-	}
+		return pImpl->mouseableArea;
 	return pImpl->size;
 }
 
@@ -401,9 +542,36 @@ void CView::setWantsIdle (bool state)
 		state ? CViewInternal::IdleViewUpdater::add (this) : CViewInternal::IdleViewUpdater::remove (this);
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * onIdle () is called once with the next tick of the idle timer. In contrast to setWantsIdle (),
+ * the idle timer only runs while views have requested it, a view with ongoing work requests the
+ * next tick again in onIdle ().
+ */
+void CView::requestIdle ()
+{
+	if (isAttached ())
+		CViewInternal::IdleViewUpdater::request (this);
+}
+
+//-----------------------------------------------------------------------------
+IdleCounters& CView::getIdleCounters ()
+{
+	return CViewInternal::IdleViewUpdater::counters;
+}
+
+//-----------------------------------------------------------------------------
+bool CView::isIdleTimerRunning ()
+{
+	return CViewInternal::IdleViewUpdater::isRunning ();
+}
+
 //-----------------------------------------------------------------------------
 void CView::setDirty (bool state)
 {
+	// the dirty state is reset on the main thread after a concurrent draw
+	if (gDrawingConcurrently)
+		return;
 	if (kDirtyCallAlwaysOnMainThread && isAttached ())
 	{
 		if (state)
@@ -418,9 +586,55 @@ void CView::setDirty (bool state)
 	else
 	{
 		setViewFlag (kDirty, state);
+		if (state)
+			markDirtyInParents ();
 	}
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Views which are dirty without a call to setDirty () must call this when they become dirty, so
+ * that CViewContainer::invalidateDirtyDescendants () finds them.
+ */
+void CView::markDirtyInParents ()
+{
+	if (auto parent = pImpl->parentView)
+		parent->asViewContainer ()->markDirtyDescendant ();
+}
+
+//-----------------------------------------------------------------------------
+void CView::setThreadSafeDrawing (bool state)
+{
+	pImpl->threadSafeDrawing = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CView::isThreadSafeDrawing () const
+{
+	return pImpl->threadSafeDrawing;
+}
+
+//-----------------------------------------------------------------------------
+bool CView::isDrawingConcurrently ()
+{
+	return gDrawingConcurrently;
+}
+
+//-----------------------------------------------------------------------------
+void CView::getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const
+{
+	if (auto bitmap = getBackground ())
+		bitmaps.emplace_back (bitmap);
+	if (auto bitmap = getDisabledBackground ())
+		bitmaps.emplace_back (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+void CView::setDrawingConcurrently (bool state)
+{
+	gDrawingConcurrently = state;
+}
+
 //-----------------------------------------------------------------------------
 void CView::setSubviewState (bool state)
 {
@@ -464,6 +678,7 @@ bool CView::removed (CView* parent)
 		return false;
 	if (wantsIdle ())
 		CViewInternal::IdleViewUpdater::remove (this);
+	CViewInternal::IdleViewUpdater::cancelRequest (this);
 	if (pImpl->viewListeners)
 	{
 		pImpl->viewListeners->forEach (
@@ -998,6 +1213,8 @@ void CView::setViewSize (const CRect& newSize, bool doInvalid)
 			invalid ();
 		CRect oldSize = getViewSize ();
 		pImpl->size = newSize;
+		if (auto parent = pImpl->parentView)
+			parent->asViewContainer ()->childViewBoundsChanged ();
 		if (doInvalid)
 			setDirty ();
 		if (getParentView ())
@@ -1048,34 +1265,15 @@ void CView::setVisible (bool state)
 //-----------------------------------------------------------------------------
 void CView::setAlphaValueNoInvalidate (float value)
 {
-	if (value == 1.f)
-	{
-		removeAttribute (kCViewAlphaValueAttrID);
-		setViewFlag (kHasAlpha, false);
-	}
-	else
-	{
-		setAttribute (kCViewAlphaValueAttrID, value);
-		setViewFlag (kHasAlpha, true);
-	}
+	pImpl->alphaValue = value;
+	setViewFlag (kHasAlpha, value != 1.f);
 }
 
 //-----------------------------------------------------------------------------
 void CView::setAlphaValue (float alpha)
 {
-	float oldAlpha = 1.f;
-	if (hasViewFlag (kHasAlpha))
-		getAttribute (kCViewAlphaValueAttrID, oldAlpha);
-	if (alpha == 1.f)
-	{
-		removeAttribute (kCViewAlphaValueAttrID);
-		setViewFlag (kHasAlpha, false);
-	}
-	else
-	{
-		setAttribute (kCViewAlphaValueAttrID, alpha);
-		setViewFlag (kHasAlpha, true);
-	}
+	auto oldAlpha = pImpl->alphaValue;
+	setAlphaValueNoInvalidate (alpha);
 	if (oldAlpha != alpha)
 	{
 		// we invalidate the parent to make sure that when alpha == 0 that a redraw occurs
@@ -1087,10 +1285,7 @@ void CView::setAlphaValue (float alpha)
 //-----------------------------------------------------------------------------
 float CView::getAlphaValue () const
 {
-	float a = 1.f;
-	if (hasViewFlag (kHasAlpha))
-		getAttribute (kCViewAlphaValueAttrID, a);
-	return a;
+	return pImpl->alphaValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -1141,22 +1336,8 @@ VSTGUIEditorInterface* CView::getEditor () const
  */
 void CView::setBackground (CBitmap* background)
 {
-	if (hasViewFlag (kHasBackground))
-	{
-		CBitmap* old;
-		if (getAttribute (kCViewBackgroundBitmapAttrID, old))
-		{
-			old->forget ();
-			removeAttribute (kCViewBackgroundBitmapAttrID);
-		}
-		setViewFlag (kHasBackground, false);
-	}
-	if (background)
-	{
-		background->remember ();
-		setAttribute (kCViewBackgroundBitmapAttrID, background);
-		setViewFlag (kHasBackground, true);
-	}
+	pImpl->background = background;
+	setViewFlag (kHasBackground, background != nullptr);
 	if (getMouseEnabled () == true)
 		setDirty (true);
 }
@@ -1164,19 +1345,13 @@ void CView::setBackground (CBitmap* background)
 //-----------------------------------------------------------------------------
 CBitmap* CView::getBackground () const
 {
-	CBitmap* result = nullptr;
-	if (hasViewFlag (kHasBackground))
-		getAttribute (kCViewBackgroundBitmapAttrID, result);
-	return result;
+	return pImpl->background;
 }
 
 //-----------------------------------------------------------------------------
 CBitmap* CView::getDisabledBackground () const
 {
-	CBitmap* result = nullptr;
-	if (hasViewFlag (kHasDisabledBackground))
-		getAttribute (kCViewDisabledBackgroundBitmapAttrID, result);
-	return result;
+	return pImpl->disabledBackground;
 }
 
 //-----------------------------------------------------------------------------
@@ -1193,22 +1368,8 @@ CBitmap* CView::getDrawBackground () const
  */
 void CView::setDisabledBackground (CBitmap* background)
 {
-	if (hasViewFlag (kHasDisabledBackground))
-	{
-		CBitmap* old;
-		if (getAttribute (kCViewDisabledBackgroundBitmapAttrID, old))
-		{
-			old->forget ();
-			removeAttribute (kCViewDisabledBackgroundBitmapAttrID);
-		}
-		setViewFlag (kHasDisabledBackground, false);
-	}
-	if (background)
-	{
-		background->remember ();
-		setAttribute (kCViewDisabledBackgroundBitmapAttrID, background);
-		setViewFlag (kHasDisabledBackground, true);
-	}
+	pImpl->disabledBackground = background;
+	setViewFlag (kHasDisabledBackground, background != nullptr);
 	if (getMouseEnabled () == false)
 		setDirty (true);
 }
@@ -1221,10 +1382,9 @@ void CView::setDisabledBackground (CBitmap* background)
  */
 bool CView::getAttributeSize (const CViewAttributeID aId, uint32_t& outSize) const
 {
-	auto it = pImpl->attributes.find (aId);
-	if (it != pImpl->attributes.end ())
+	if (auto entry = pImpl->attributes.find (aId))
 	{
-		outSize = it->second->getSize ();
+		outSize = entry->getSize ();
 		return true;
 	}
 	return false;
@@ -1240,14 +1400,13 @@ bool CView::getAttributeSize (const CViewAttributeID aId, uint32_t& outSize) con
  */
 bool CView::getAttribute (const CViewAttributeID aId, const uint32_t inSize, void* outData, uint32_t& outSize) const
 {
-	auto it = pImpl->attributes.find (aId);
-	if (it != pImpl->attributes.end ())
+	if (auto entry = pImpl->attributes.find (aId))
 	{
-		if (inSize >= it->second->getSize ())
+		if (inSize >= entry->getSize ())
 		{
-			outSize = it->second->getSize ();
+			outSize = entry->getSize ();
 			if (outSize > 0)
-				std::memcpy (outData, it->second->getData (), static_cast<size_t> (outSize));
+				std::memcpy (outData, entry->getData (), static_cast<size_t> (outSize));
 			return true;
 		}
 	}
@@ -1266,24 +1425,14 @@ bool CView::setAttribute (const CViewAttributeID aId, const uint32_t inSize, con
 {
 	if (inData == nullptr || inSize <= 0)
 		return false;
-	auto it = pImpl->attributes.find (aId);
-	if (it != pImpl->attributes.end ())
-		it->second->updateData (inSize, inData);
-	else
-		pImpl->attributes.emplace (aId, std::unique_ptr<CViewInternal::AttributeEntry> (new CViewInternal::AttributeEntry (inSize, inData)));
+	pImpl->attributes.set (aId, inSize, inData);
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 bool CView::removeAttribute (const CViewAttributeID aId)
 {
-	auto it = pImpl->attributes.find (aId);
-	if (it != pImpl->attributes.end ())
-	{
-		pImpl->attributes.erase (aId);
-		return true;
-	}
-	return false;
+	return pImpl->attributes.remove (aId);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -10,7 +10,9 @@
 #include "vstkeycode.h"
 #include "cbuttonstate.h"
 #include "cgraphicstransform.h"
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -42,6 +44,21 @@ static constexpr CViewAttributeID kCViewAttributeReferencePointer = 'cvrp';
 static constexpr CViewAttributeID kCViewTooltipAttribute = 'cvtt';
 static constexpr CViewAttributeID kCViewControllerAttribute = 'ictr';
 
+//-----------------------------------------------------------------------------
+/** Counters of the work done in idle, i.e. to check that an idle user interface does no work.
+ *	The counters are shared by all frames and may be read from any thread.
+ *	@ingroup new_in_4_11
+ */
+struct IdleCounters
+{
+	/** number of callbacks of the idle timer */
+	std::atomic<uint64_t> timerCallbacks {0};
+	/** number of CView::onIdle () calls */
+	std::atomic<uint64_t> onIdleCalls {0};
+	/** number of CFrame::idle () calls which checked the view hierarchy for dirty views */
+	std::atomic<uint64_t> dirtyViewChecks {0};
+};
+
 //-----------------------------------------------------------------------------
 // CView Declaration
 //! @brief Base Class of all view objects
@@ -70,6 +87,30 @@ public:
 	/** if this is true, setting a view dirty will call invalid() instead of checking it in idle. Default value is false. */
 	static bool kDirtyCallAlwaysOnMainThread;
 
+	/** mark the view as safe to be drawn on a worker thread
+	 *
+	 *	Platforms may draw regions of a frame concurrently if the frame and all views drawn in
+	 *	the region are marked. While drawing, such a view must only read its own state, must only
+	 *	use fonts which were already drawn once and must only draw the bitmaps it reports in
+	 *	getDrawBitmaps. Calls to setDirty are ignored while drawing on a worker thread.
+	 *
+	 *	@ingroup new_in_4_11
+	 */
+	void setThreadSafeDrawing (bool state);
+	/** check if the view can be drawn on a worker thread
+	 *	@ingroup new_in_4_11
+	 */
+	bool isThreadSafeDrawing () const;
+	/** check if the calling thread currently draws views concurrently to the main thread
+	 *	@ingroup new_in_4_11
+	 */
+	static bool isDrawingConcurrently ();
+	/** add the bitmaps drawn by the view. They are loaded and kept loaded before the view is drawn
+	 *	on a worker thread. The default adds the background and the disabled background.
+	 *	@ingroup new_in_4_11
+	 */
+	virtual void getDrawBitmaps (std::vector<CBitmap*>& bitmaps) const;
+
 	/** mark rect as invalid */
 	virtual void invalidRect (const CRect& rect);
 	/** mark whole view as invalid */
@@ -79,6 +120,18 @@ public:
 	virtual void setVisible (bool state);
 	/** get visibility state */
 	bool isVisible () const { return hasViewFlag (kVisible) && getAlphaValue () > 0.f; }
+
+	/** mark the view as drawing outside of its view size
+	 *
+	 *	The containers skip the views whose view size does not overlap the update rect and clip
+	 *	the drawing to the view size. A view which draws outside of it, like a shadow, has to
+	 *	set this and override checkUpdate to return true for the update rects it draws into.
+	 *	It is then clipped to the update rect of the container only.
+	 *	@ingroup new_in_4_11
+	 */
+	void setDrawsOutsideBounds (bool state);
+	/** @ingroup new_in_4_11 */
+	bool drawsOutsideBounds () const { return hasViewFlag (kDrawsOutsideBounds); }
 	//@}
 
 	//-----------------------------------------------------------------------------
@@ -382,8 +435,20 @@ public:
 	void setWantsIdle (bool state);
 	/** returns if the view wants idle callback or not */
 	bool wantsIdle () const { return hasViewFlag (kWantsIdle); }
+	/** call onIdle() once with the next idle tick, only while the view is attached
+	 *	@ingroup new_in_4_11
+	 */
+	void requestIdle ();
 	/** global idle rate in Hz, defaults to 30 Hz*/
 	static uint32_t idleRate;
+	/** the counters of the idle work of all views and frames
+	 *	@ingroup new_in_4_11
+	 */
+	static IdleCounters& getIdleCounters ();
+	/** returns true while views want or requested idle
+	 *	@ingroup new_in_4_11
+	 */
+	static bool isIdleTimerRunning ();
 	//@}
 
 	/** whether this view wants to be informed if the window's active state changes */
@@ -463,7 +528,8 @@ protected:
 		kHasBackground			= 1 << 9,
 		kHasDisabledBackground	= 1 << 10,
 		kHasMouseableArea		= 1 << 11,
-		kLastCViewFlag			= 11
+		kDrawsOutsideBounds		= 1 << 12,
+		kLastCViewFlag			= 12
 	};
 
 	~CView () noexcept override;
@@ -474,8 +540,14 @@ protected:
 	void setViewFlag (int32_t bit, bool state);
 	
 	void setAlphaValueNoInvalidate (float value);
+	/** mark the parent containers as containing a dirty view, see
+	 *	CViewContainer::markDirtyDescendant ()
+	 *	@ingroup new_in_4_11
+	 */
+	void markDirtyInParents ();
 	void setParentFrame (CFrame* frame);
 	void setParentView (CView* parent);
+	static void setDrawingConcurrently (bool state);
 
 private:
 	struct Impl;
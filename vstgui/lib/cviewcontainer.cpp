@@ -6,6 +6,7 @@
 #include "coffscreencontext.h"
 #include "cbitmap.h"
 #include "cframe.h"
+#include "cdrawprofiler.h"
 #include "ccolor.h"
 #include "ifocusdrawing.h"
 #include "itouchevent.h"
@@ -19,6 +20,7 @@
 #include "finally.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 
 namespace VSTGUI {
@@ -40,12 +42,208 @@ struct CViewContainer::Impl
 	ViewContainerListenerDispatcher viewContainerListeners;
 	CGraphicsTransform transform;
 	
-	ViewList children;
+	ChildViews children;
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	std::atomic<bool> hasDirtyDescendant {false};
+
+	// clear the marks of a subtree which is not visited, otherwise a marked child would stop
+	// markDirtyDescendant () from reaching its parents
+	void resetDirtyDescendants ()
+	{
+		hasDirtyDescendant = false;
+		for (const auto& pV : children)
+		{
+			if (auto container = pV->asViewContainer ())
+			{
+				if (container->pImpl->hasDirtyDescendant)
+					container->pImpl->resetDirtyDescendants ();
+			}
+		}
+	}
 };
 
+//-----------------------------------------------------------------------------
+size_t CViewContainer::ChildViews::find (const CView* view) const
+{
+	for (size_t i = 0; i < views.size (); ++i)
+	{
+		if (views[i].get () == view && !isRemoved (i))
+			return i;
+	}
+	return views.size ();
+}
+
+//-----------------------------------------------------------------------------
+size_t CViewContainer::ChildViews::toStorageIndex (size_t index) const
+{
+	if (numRemoved == 0)
+		return std::min (index, views.size ());
+	for (size_t i = 0; i < views.size (); ++i)
+	{
+		if (removed[i])
+			continue;
+		if (index-- == 0)
+			return i;
+	}
+	return views.size ();
+}
+
+//-----------------------------------------------------------------------------
+size_t CViewContainer::ChildViews::toListIndex (size_t index) const
+{
+	if (numRemoved == 0)
+		return index;
+	return static_cast<size_t> (
+		std::count (removed.begin (), removed.begin () + static_cast<std::ptrdiff_t> (index), 0));
+}
+
+//-----------------------------------------------------------------------------
+auto CViewContainer::ChildViews::asList () const -> const ViewList&
+{
+	if (!list)
+	{
+		list = std::make_unique<ViewList> ();
+		for (size_t i = 0; i < views.size (); ++i)
+		{
+			if (!isRemoved (i))
+				list->emplace_back (views[i]);
+		}
+	}
+	return *list;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::insert (size_t index, CView* view)
+{
+	if (list)
+		list->emplace (std::next (list->begin (), toListIndex (index)), view);
+	views.emplace (views.begin () + index, view);
+	removed.emplace (removed.begin () + index, 0);
+	if (boundsValid)
+	{
+		viewSizes.emplace (viewSizes.begin () + index, view->getViewSize ());
+		mouseableAreas.emplace (mouseableAreas.begin () + index, view->getMouseableArea ());
+		drawsOutside.emplace (drawsOutside.begin () + index, view->drawsOutsideBounds ());
+	}
+	if (numIterators)
+		insertions.emplace_back (index);
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::erase (size_t index)
+{
+	if (index >= views.size () || isRemoved (index))
+		return;
+	if (list)
+		list->erase (std::next (list->begin (), toListIndex (index)));
+	if (numIterators)
+	{
+		// the view is kept until the last iterator is destroyed
+		removed[index] = 1;
+		++numRemoved;
+		return;
+	}
+	// released after the storage is consistent again, as this may delete the view
+	auto view = std::move (views[index]);
+	views.erase (views.begin () + index);
+	removed.erase (removed.begin () + index);
+	if (boundsValid)
+	{
+		viewSizes.erase (viewSizes.begin () + index);
+		mouseableAreas.erase (mouseableAreas.begin () + index);
+		drawsOutside.erase (drawsOutside.begin () + index);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::endIteration () const
+{
+	if (--numIterators == 0 && (numRemoved || !insertions.empty ()))
+		compact ();
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::compact () const
+{
+	std::vector<SharedPointer<CView>> removedViews;
+	removedViews.reserve (numRemoved);
+	bool moveBounds = boundsValid;
+	size_t count = 0;
+	for (size_t i = 0; i < views.size (); ++i)
+	{
+		if (removed[i])
+		{
+			removedViews.emplace_back (std::move (views[i]));
+			continue;
+		}
+		if (count != i)
+		{
+			views[count] = std::move (views[i]);
+			if (moveBounds)
+			{
+				viewSizes[count] = viewSizes[i];
+				mouseableAreas[count] = mouseableAreas[i];
+				drawsOutside[count] = drawsOutside[i];
+			}
+		}
+		++count;
+	}
+	views.resize (count);
+	removed.assign (count, 0);
+	if (moveBounds)
+	{
+		viewSizes.resize (count);
+		mouseableAreas.resize (count);
+		drawsOutside.resize (count);
+	}
+	numRemoved = 0;
+	insertions.clear ();
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::setCacheBounds (bool state)
+{
+	cacheBounds = state;
+	boundsValid = false;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::refreshBounds (size_t index, const CView* view)
+{
+	if (!boundsValid)
+		return;
+	if (index < views.size () && views[index].get () == view)
+	{
+		viewSizes[index] = view->getViewSize ();
+		mouseableAreas[index] = view->getMouseableArea ();
+		drawsOutside[index] = view->drawsOutsideBounds ();
+	}
+	else
+		boundsValid = false;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::ChildViews::updateBounds () const
+{
+	// the threads drawing in parallel may get here at the same time
+	std::lock_guard<std::mutex> guard (boundsMutex);
+	if (boundsValid)
+		return;
+	viewSizes.resize (views.size ());
+	mouseableAreas.resize (views.size ());
+	drawsOutside.resize (views.size ());
+	for (size_t i = 0; i < views.size (); ++i)
+	{
+		viewSizes[i] = views[i]->getViewSize ();
+		mouseableAreas[i] = views[i]->getMouseableArea ();
+		drawsOutside[i] = views[i]->drawsOutsideBounds ();
+	}
+	boundsValid.store (cacheBounds, std::memory_order_release);
+}
+
 //------------------------------------------------------------------------
 struct CViewContainerDropTarget : public IDropTarget, public NonAtomicReferenceCounted
 {
@@ -254,6 +452,12 @@ void CViewContainer::setLastDrawnFocus (CRect r)
 
 //-----------------------------------------------------------------------------
 auto CViewContainer::getChildren () const -> const ViewList&
+{
+	return pImpl->children.asList ();
+}
+
+//-----------------------------------------------------------------------------
+auto CViewContainer::getChildViews () const -> const ChildViews&
 {
 	return pImpl->children;
 }
@@ -516,16 +720,13 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 
 	vstgui_assert (!pView->isSubview (), "view is already added to a container view");
 
+	auto index = pImpl->children.views.size ();
 	if (pBefore)
 	{
-		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pBefore);
-		vstgui_assert (it != pImpl->children.end ());
-		pImpl->children.insert (it, pView);
-	}
-	else
-	{
-		pImpl->children.emplace_back (pView);
+		index = pImpl->children.find (pBefore);
+		vstgui_assert (index != pImpl->children.views.size ());
 	}
+	pImpl->children.insert (index, pView);
 
 	pView->setSubviewState (true);
 
@@ -538,6 +739,8 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 		pView->attached (this);
 		pView->invalid ();
 	}
+	// the view does not notify us about size changes before it is attached
+	pImpl->children.refreshBounds (index, pView);
 	return true;
 }
 
@@ -568,20 +771,19 @@ bool CViewContainer::removeAll (bool withForget)
 {
 	clearMouseDownView ();
 	
-	auto it = pImpl->children.begin ();
-	while (it != pImpl->children.end ())
+	auto& children = pImpl->children;
+	while (!children.empty ())
 	{
-		auto view = *it;
+		auto view = children.views[children.toStorageIndex (0)];
 		if (isAttached ())
 			view->removed (this);
-		pImpl->children.erase (it);
+		children.erase (children.find (view));
 		view->setSubviewState (false);
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, view);
 		});
 		if (withForget)
 			view->forget ();
-		it = pImpl->children.begin ();
 	}
 	return true;
 }
@@ -594,8 +796,8 @@ bool CViewContainer::removeAll (bool withForget)
  */
 bool CViewContainer::removeView (CView *pView, bool withForget)
 {
-	auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pView);
-	if (it != pImpl->children.end ())
+	auto& children = pImpl->children;
+	if (children.find (pView) != children.views.size ())
 	{
 		pView->invalid ();
 		if (pView == getMouseDownView ())
@@ -608,7 +810,8 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 		});
 		if (withForget)
 			pView->forget ();
-		pImpl->children.erase (it);
+		// the listeners may have changed the children
+		children.erase (children.find (pView));
 		return true;
 	}
 	return false;
@@ -631,23 +834,24 @@ bool CViewContainer::isChild (CView *pView, bool deep) const
 
 	if (deep)
 	{
-		auto it = pImpl->children.begin ();
-		while (!found && it != pImpl->children.end ())
+		for (const auto& v : pImpl->children)
 		{
-			CView* v = (*it);
 			if (pView == v)
 			{
 				found = true;
 				break;
 			}
 			if (CViewContainer* container = v->asViewContainer ())
+			{
 				found = container->isChild (pView, true);
-			++it;
+				if (found)
+					break;
+			}
 		}
 	}
 	else
 	{
-		found = std::find (pImpl->children.begin (), pImpl->children.end (), pView) != pImpl->children.end ();
+		found = pImpl->children.find (pView) != pImpl->children.views.size ();
 	}
 	return found;
 }
@@ -674,10 +878,9 @@ uint32_t CViewContainer::getNbViews () const
  */
 CView* CViewContainer::getView (uint32_t index) const
 {
-	auto it = pImpl->children.begin ();
-	std::advance (it, index);
-	if (it != pImpl->children.end ())
-		return *it;
+	auto storageIndex = pImpl->children.toStorageIndex (index);
+	if (storageIndex < pImpl->children.views.size ())
+		return pImpl->children.views[storageIndex];
 	return nullptr;
 }
 
@@ -691,21 +894,18 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 {
 	if (newIndex < getNbViews ())
 	{
-		uint32_t oldIndex = 0;
-		auto src = pImpl->children.begin ();
-		for (;src != pImpl->children.end () && *src != view; ++src, ++oldIndex);
-		if (src != pImpl->children.end ())
+		auto& children = pImpl->children;
+		auto src = children.find (view);
+		if (src != children.views.size ())
 		{
-			if (newIndex == oldIndex)
+			auto dest = children.toStorageIndex (newIndex);
+			if (dest == src)
 				return true;
-			if (newIndex > oldIndex)
-				++newIndex;
+			if (dest > src)
+				dest = children.toStorageIndex (newIndex + 1);
 
-			auto dest = pImpl->children.begin ();
-			std::advance (dest, newIndex);
-
-			pImpl->children.insert (dest, view);
-			pImpl->children.erase (src);
+			children.insert (dest, view);
+			children.erase (dest <= src ? src + 1 : src);
 
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
@@ -740,6 +940,67 @@ bool CViewContainer::invalidateDirtyViews ()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::markDirtyDescendant ()
+{
+	CView* view = this;
+	while (view)
+	{
+		auto container = view->asViewContainer ();
+		// the parents of a marked container are already marked
+		if (!container || container->pImpl->hasDirtyDescendant.exchange (true))
+			break;
+		view = container->getParentView ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::hasDirtyDescendant () const
+{
+	return pImpl->hasDirtyDescendant;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::invalidateDirtyDescendants ()
+{
+	// reset before the children are visited, so that views set dirty meanwhile mark it again
+	pImpl->hasDirtyDescendant = false;
+	if (!isVisible ())
+	{
+		pImpl->resetDirtyDescendants ();
+		return;
+	}
+	if (CView::isDirty ())
+	{
+		pImpl->resetDirtyDescendants ();
+		if (auto parent = getParentView ())
+			parent->invalidRect (getViewSize ());
+		return;
+	}
+	for (const auto& pV : pImpl->children)
+	{
+		if (!pV->isVisible ())
+		{
+			if (auto container = pV->asViewContainer ())
+				container->pImpl->resetDirtyDescendants ();
+			continue;
+		}
+		if (auto container = pV->asViewContainer ())
+		{
+			if (container->hasDirtyDescendant () || container->CView::isDirty ())
+				container->invalidateDirtyDescendants ();
+		}
+		else if (pV->isDirty ())
+			pV->invalid ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::childViewBoundsChanged ()
+{
+	pImpl->children.invalidateBounds ();
+}
+
 //-----------------------------------------------------------------------------
 void CViewContainer::invalid ()
 {
@@ -839,6 +1100,7 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	
 	CView* _focusView = nullptr;
 	IFocusDrawing* _focusDrawing = nullptr;
+	auto profiler = pContext->getDrawProfiler ();
 	auto frame = getFrame ();
 	if (frame && frame->focusDrawingEnabled () && isChild (frame->getFocusView (), false) && frame->getFocusView ()->isVisible () && frame->getFocusView ()->wantsFocus ())
 	{
@@ -853,8 +1115,14 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().transform (oldClip2);
 		
 		// draw each view
-		for (const auto& pV : pImpl->children)
+		const auto& children = pImpl->children;
+		for (auto it = children.begin (), end = children.end (); it != end; ++it)
 		{
+			// the views outside of the clip rect are skipped without touching them
+			it.moveTo (children.findOverlapping (it.index (), newClip, _focusView));
+			if (it == end)
+				break;
+			const auto& pV = *it;
 			if (pV->isVisible ())
 			{
 				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
@@ -883,13 +1151,23 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 				if (checkUpdateRect (pV, clientRect))
 				{
 					CRect viewSize = pV->getViewSize ();
-					viewSize.bound (newClip);
+					if (pV->drawsOutsideBounds ())
+						viewSize = newClip;
+					else
+						viewSize.bound (newClip);
 					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
 						continue;
 					pContext->setClipRect (viewSize);
 					float globalContextAlpha = pContext->getGlobalAlpha ();
 					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
-					pV->drawRect (pContext, viewSize);
+					if (profiler)
+					{
+						profiler->beginView (pV);
+						pV->drawRect (pContext, viewSize);
+						profiler->endView ();
+					}
+					else
+						pV->drawRect (pContext, viewSize);
 					pContext->setGlobalAlpha (globalContextAlpha);
 				}
 			}
@@ -933,7 +1211,8 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 
 //-----------------------------------------------------------------------------
 /**
- * check if view needs to be updated for rect
+ * check if view needs to be updated for rect. Only called for the views which overlap the rect or
+ * draw outside of their bounds.
  * @param view view to check
  * @param rect update rect
  * @return true if view needs update
@@ -1357,10 +1636,15 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
+	// a query, which does not change the children, so the storage is accessed directly
+	const auto& children = pImpl->children;
+	auto mouseableAreas = children.getMouseableAreas ();
+	for (auto index = children.views.size (); index-- > 0;)
 	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+		if (!mouseableAreas[index].pointInside (where) || children.isRemoved (index))
+			continue;
+		const auto& pV = children.views[index];
+		if (pV)
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
 				continue;
@@ -1401,10 +1685,15 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
+	// a query, which does not change the children, so the storage is accessed directly
+	const auto& children = pImpl->children;
+	auto mouseableAreas = children.getMouseableAreas ();
+	for (auto index = children.views.size (); index-- > 0;)
 	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+		if (!mouseableAreas[index].pointInside (where) || children.isRemoved (index))
+			continue;
+		const auto& pV = children.views[index];
+		if (pV)
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
 				continue;
@@ -1443,10 +1732,15 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
+	// a query, which does not change the children, so the storage is accessed directly
+	const auto& children = pImpl->children;
+	auto mouseableAreas = children.getMouseableAreas ();
+	for (auto index = children.views.size (); index-- > 0;)
 	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+		if (!mouseableAreas[index].pointInside (where) || children.isRemoved (index))
+			continue;
+		const auto& pV = children.views[index];
+		if (pV)
 		{
 			if (!options.getIncludeInvisible () && pV->isVisible () == false)
 				continue;
@@ -1491,6 +1785,7 @@ bool CViewContainer::removed (CView* parent)
 	if (!isAttached ())
 		return false;
 
+	pImpl->children.setCacheBounds (false);
 	for (const auto& pV : pImpl->children)
 		pV->removed (this);
 	
@@ -1510,6 +1805,11 @@ bool CViewContainer::attached (CView* parent)
 	{
 		for (const auto& pV : pImpl->children)
 			pV->attached (this);
+		// the attached children notify us about changes of their bounds
+		pImpl->children.setCacheBounds (true);
+		// dirty views marked before, or in a previous parent, must be found from the new parents
+		if (pImpl->hasDirtyDescendant)
+			markDirtyInParents ();
 	}
 	return result;
 }
@@ -10,8 +10,12 @@
 #if VSTGUI_TOUCH_EVENT_HANDLING
 #include "itouchevent.h"
 #endif
+#include <atomic>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -54,6 +58,239 @@ class CViewContainer : public CView
 public:
 	using ViewList = std::list<SharedPointer<CView>>;
 
+	//-----------------------------------------------------------------------------
+	/** the child views in z order.
+	 *
+	 *	The views are stored in a contiguous array, together with a cache of their view sizes and
+	 *	mouseable areas in parallel arrays, so that drawing and hit testing only touch the views
+	 *	which intersect the update rect or contain the point.
+	 *
+	 *	The iterators refer to an index which is adjusted when views are inserted. While an iterator
+	 *	exists, removed views are only marked as removed and kept alive, they are erased when the
+	 *	last iterator is destroyed. So a view and the iterators stay valid when views are added or
+	 *	removed while iterating, like they did with a list.
+	 *
+	 *	Drawing skips the views by their cached view size, unless they draw outside of their
+	 *	bounds (see CView::setDrawsOutsideBounds).
+	 *	@ingroup new_in_4_11
+	 */
+	class ChildViews
+	{
+	public:
+		template<bool reverse>
+		class IteratorT
+		{
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type = SharedPointer<CView>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const SharedPointer<CView>*;
+			using reference = const SharedPointer<CView>&;
+
+			IteratorT (const ChildViews* children, size_t position)
+			: children (children), position (position), numInsertions (children->insertions.size ())
+			{
+				children->beginIteration ();
+				skipRemoved ();
+			}
+			IteratorT (const IteratorT& o)
+			: children (o.children), position (o.position), numInsertions (o.numInsertions)
+			{
+				children->beginIteration ();
+			}
+			~IteratorT () noexcept { children->endIteration (); }
+
+			IteratorT& operator= (const IteratorT& o)
+			{
+				o.children->beginIteration ();
+				children->endIteration ();
+				children = o.children;
+				position = o.position;
+				numInsertions = o.numInsertions;
+				return *this;
+			}
+
+			reference operator* () const { return children->views[index ()]; }
+			pointer operator-> () const { return &children->views[index ()]; }
+
+			IteratorT& operator++ ()
+			{
+				sync ();
+				if (!reverse)
+					++position;
+				else if (position > 0)
+					--position;
+				skipRemoved ();
+				return *this;
+			}
+
+			IteratorT& operator-- ()
+			{
+				sync ();
+				if (reverse)
+				{
+					while (position < children->views.size ())
+					{
+						if (!children->isRemoved (position++))
+							break;
+					}
+				}
+				else
+				{
+					while (position > 0)
+					{
+						if (!children->isRemoved (--position))
+							break;
+					}
+				}
+				return *this;
+			}
+
+			bool operator== (const IteratorT& o) const
+			{
+				sync ();
+				o.sync ();
+				if (atEnd () || o.atEnd ())
+					return atEnd () == o.atEnd ();
+				return position == o.position;
+			}
+			bool operator!= (const IteratorT& o) const { return !(*this == o); }
+
+		private:
+			friend class CViewContainer;
+
+			/** the index of the view in the storage */
+			size_t index () const
+			{
+				sync ();
+				return reverse ? position - 1 : position;
+			}
+
+			void moveTo (size_t index) { position = reverse ? index + 1 : index; }
+
+			bool atEnd () const
+			{
+				return reverse ? position == 0 : position >= children->views.size ();
+			}
+
+			/** move the position behind the views which were inserted before it */
+			void sync () const
+			{
+				const auto& insertions = children->insertions;
+				if (numInsertions > insertions.size ())
+					numInsertions = insertions.size ();
+				for (; numInsertions < insertions.size (); ++numInsertions)
+				{
+					if (reverse ? insertions[numInsertions] < position
+								: insertions[numInsertions] <= position)
+						++position;
+				}
+			}
+
+			void skipRemoved ()
+			{
+				while (!atEnd () && children->isRemoved (reverse ? position - 1 : position))
+				{
+					if (reverse)
+						--position;
+					else
+						++position;
+				}
+			}
+
+			const ChildViews* children;
+			// for reverse iterators the index of the view plus one
+			mutable size_t position;
+			mutable size_t numInsertions;
+		};
+
+		using const_iterator = IteratorT<false>;
+		using const_reverse_iterator = IteratorT<true>;
+
+		const_iterator begin () const { return {this, 0}; }
+		const_iterator end () const { return {this, views.size ()}; }
+		const_reverse_iterator rbegin () const { return {this, views.size ()}; }
+		const_reverse_iterator rend () const { return {this, 0}; }
+
+		size_t size () const { return views.size () - numRemoved; }
+		bool empty () const { return size () == 0; }
+
+	private:
+		friend class CViewContainer;
+
+		/** returns the index of the view in the storage or size of the storage */
+		size_t find (const CView* view) const;
+		/** returns the index in the storage of the view at the index without the removed views */
+		size_t toStorageIndex (size_t index) const;
+		void insert (size_t index, CView* view);
+		void erase (size_t index);
+		bool isRemoved (size_t index) const { return numRemoved && removed[index]; }
+		/** returns the number of views before the index which are not removed */
+		size_t toListIndex (size_t index) const;
+		/** the views as a list, created on the first call and kept in sync afterwards */
+		const ViewList& asList () const;
+
+		/** the bounds are only cached while the children are attached, as only then the views
+		 *	notify their parent when their bounds change
+		 */
+		void setCacheBounds (bool state);
+		void invalidateBounds () { boundsValid = false; }
+		/** update the cached bounds of the view at the index */
+		void refreshBounds (size_t index, const CView* view);
+		/** returns the index of the first view at or after the index which overlaps the rect, is
+		 *	the view or draws outside of its bounds, or the size of the storage. Without cached
+		 *	bounds no view is skipped.
+		 */
+		size_t findOverlapping (size_t index, const CRect& rect, const CView* view) const
+		{
+			if (!cacheBounds)
+				return index;
+			if (!boundsValid.load (std::memory_order_acquire))
+				updateBounds ();
+			while (index < views.size ())
+			{
+				if ((viewSizes[index].rectOverlap (rect) || drawsOutside[index] ||
+					 (view && views[index].get () == view)) &&
+					!isRemoved (index))
+					break;
+				++index;
+			}
+			return index;
+		}
+		/** the mouseable areas of all views in the storage. Only valid until the children or their
+		 *	bounds change, if the bounds are not cached they are collected on every call.
+		 */
+		const CRect* getMouseableAreas () const
+		{
+			if (!cacheBounds || !boundsValid.load (std::memory_order_acquire))
+				updateBounds ();
+			return mouseableAreas.data ();
+		}
+		void updateBounds () const;
+
+		void beginIteration () const { ++numIterators; }
+		void endIteration () const;
+		void compact () const;
+
+		mutable std::vector<SharedPointer<CView>> views;
+		mutable std::vector<uint8_t> removed;
+		mutable std::unique_ptr<ViewList> list;
+		// the indices of the views inserted while iterators exist
+		mutable std::vector<size_t> insertions;
+		mutable size_t numRemoved {0};
+		// the children are iterated by the threads drawing in parallel
+		mutable std::atomic<uint32_t> numIterators {0};
+
+		// drawing only needs the view sizes and hit testing only the mouseable areas
+		mutable std::vector<CRect> viewSizes;
+		mutable std::vector<CRect> mouseableAreas;
+		// the views which draw outside of their bounds are never skipped
+		mutable std::vector<uint8_t> drawsOutside;
+		mutable std::atomic<bool> boundsValid {false};
+		mutable std::mutex boundsMutex;
+		bool cacheBounds {false};
+	};
+
 	explicit CViewContainer (const CRect& size);
 	CViewContainer (const CViewContainer& viewContainer);
 
@@ -125,6 +362,24 @@ public:
 
 	virtual bool advanceNextFocusView (CView* oldFocus, bool reverse = false);
 	virtual bool invalidateDirtyViews ();
+	/** mark this container and its parents as containing a dirty view. Thread safe.
+	 *	@ingroup new_in_4_11
+	 */
+	void markDirtyDescendant ();
+	/** returns true if a view in this container was set dirty since the last call to
+	 *	invalidateDirtyDescendants ()
+	 *	@ingroup new_in_4_11
+	 */
+	bool hasDirtyDescendant () const;
+	/** invalidate the dirty views like invalidateDirtyViews (), but only visit the child containers
+	 *	which contain a dirty view. Only views which call setDirty () when they become dirty are found.
+	 *	@ingroup new_in_4_11
+	 */
+	void invalidateDirtyDescendants ();
+	/** called by a child view when its view size or mouseable area changed
+	 *	@ingroup new_in_4_11
+	 */
+	void childViewBoundsChanged ();
 	virtual CRect getVisibleSize (const CRect& rect) const;
 
 	void setTransform (const CGraphicsTransform& t);
@@ -175,8 +430,8 @@ public:
 	CPoint& localToFrame (CPoint& point) const override;
 
 	//-----------------------------------------------------------------------------
-	using ChildViewConstIterator = ViewList::const_iterator;
-	using ChildViewConstReverseIterator = ViewList::const_reverse_iterator;
+	using ChildViewConstIterator = ChildViews::const_iterator;
+	using ChildViewConstReverseIterator = ChildViews::const_reverse_iterator;
 
 	//-----------------------------------------------------------------------------
 	template<bool reverse>
@@ -186,12 +441,9 @@ public:
 		using IteratorType = typename std::conditional<reverse, ChildViewConstReverseIterator,
 													   ChildViewConstIterator>::type;
 
-		explicit Iterator (const CViewContainer* container) : children (container->getChildren ())
+		explicit Iterator (const CViewContainer* container)
+		: children (container->getChildViews ()), iterator (first (children))
 		{
-			if constexpr (reverse)
-				iterator = children.rbegin ();
-			else
-				iterator = children.begin ();
 		}
 
 		explicit Iterator (const Iterator<reverse>& vi)
@@ -231,7 +483,15 @@ public:
 		}
 		
 	protected:
-		const ViewList& children;
+		static IteratorType first (const ChildViews& children)
+		{
+			if constexpr (reverse)
+				return children.rbegin ();
+			else
+				return children.begin ();
+		}
+
+		const ChildViews& children;
 		IteratorType iterator;
 	};
 
@@ -260,6 +520,10 @@ protected:
 	CView* getMouseDownView () const;
 	
 	const ViewList& getChildren () const;
+	/** the child views without copying them to a list
+	 *	@ingroup new_in_4_11
+	 */
+	const ChildViews& getChildViews () const;
 private:
 	void dispatchEventToSubViews (Event& event);
 	
@@ -278,7 +542,7 @@ using ReverseViewIterator = CViewContainer::Iterator<true>;
 template<class ViewClass, class ContainerClass>
 inline uint32_t CViewContainer::getChildViewsOfType (ContainerClass& result, bool deep) const
 {
-	for (auto& child : getChildren ())
+	for (auto& child : getChildViews ())
 	{
 		auto vObj = child.cast<ViewClass> ();
 		if (vObj)
@@ -300,7 +564,7 @@ inline uint32_t CViewContainer::getChildViewsOfType (ContainerClass& result, boo
 template <typename Proc>
 inline void CViewContainer::forEachChild (Proc proc) const
 {
-	for (auto& child : getChildren ())
+	for (auto& child : getChildViews ())
 	{
 		proc (child);
 	}
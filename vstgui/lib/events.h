@@ -319,6 +319,18 @@ struct MouseUpEvent : MouseDownUpMoveEvent
  */
 struct MouseMoveEvent : MouseDownUpMoveEvent
 {
+	/** positions of earlier mouse moves which the platform coalesced into this event, oldest
+	 *	first. Only valid while the event is dispatched.
+	 *
+	 *	The positions are in frame coordinates with the transform of the frame (its zoom factor)
+	 *	already applied, they are not made local while the event is dispatched to the views. A
+	 *	view gets them in the coordinates of mousePosition with translateToLocal (position, true)
+	 *	of its parent view.
+	 *	@ingroup new_in_4_11
+	 */
+	const CPoint* coalescedPositions {nullptr};
+	size_t numCoalescedPositions {0};
+
 	MouseMoveEvent () { type = EventType::MouseMove; }
 	MouseMoveEvent (const CPoint& pos, MouseEventButtonState buttons = {})
 	: MouseDownUpMoveEvent (pos, buttons)
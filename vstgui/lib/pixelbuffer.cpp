@@ -4,6 +4,13 @@
 
 #include "pixelbuffer.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VSTGUI_PIXELBUFFER_SSE2 1
+#include <emmintrin.h>
+#else
+#define VSTGUI_PIXELBUFFER_SSE2 0
+#endif
+
 //------------------------------------------------------------------------
 namespace VSTGUI {
 namespace PixelBuffer {
@@ -273,6 +280,142 @@ void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t byte
 	}
 }
 
+//------------------------------------------------------------------------
+namespace Private {
+
+//------------------------------------------------------------------------
+inline uint8_t premultiply (uint32_t component, uint32_t alpha)
+{
+	// exact rounding of component * alpha / 255
+	auto t = component * alpha + 128;
+	return static_cast<uint8_t> ((t + (t >> 8)) >> 8);
+}
+
+//------------------------------------------------------------------------
+inline uint8_t unpremultiply (uint32_t component, uint32_t alpha)
+{
+	auto result = (component * 255 + alpha / 2) / alpha;
+	return static_cast<uint8_t> (result > 255 ? 255 : result);
+}
+
+//------------------------------------------------------------------------
+template<uint32_t AlphaIndex>
+void premultiplyRow (uint8_t* row, uint32_t width)
+{
+	uint32_t x = 0;
+#if VSTGUI_PIXELBUFFER_SSE2
+	const auto zero = _mm_setzero_si128 ();
+	const auto bias = _mm_set1_epi16 (128);
+	const auto alphaMask = _mm_set1_epi32 (static_cast<int> (0xFFu << (AlphaIndex * 8)));
+	constexpr int kAlphaShuffle = _MM_SHUFFLE (AlphaIndex, AlphaIndex, AlphaIndex, AlphaIndex);
+	auto premultiplyPixels = [&] (__m128i v) {
+		// v contains two pixels with one 16 bit lane per component
+		auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, kAlphaShuffle), kAlphaShuffle);
+		auto t = _mm_add_epi16 (_mm_mullo_epi16 (v, alpha), bias);
+		return _mm_srli_epi16 (_mm_add_epi16 (t, _mm_srli_epi16 (t, 8)), 8);
+	};
+	for (; x + 4 <= width; x += 4, row += 16)
+	{
+		auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (row));
+		auto lo = premultiplyPixels (_mm_unpacklo_epi8 (pixels, zero));
+		auto hi = premultiplyPixels (_mm_unpackhi_epi8 (pixels, zero));
+		auto result = _mm_packus_epi16 (lo, hi);
+		result = _mm_or_si128 (_mm_andnot_si128 (alphaMask, result),
+							   _mm_and_si128 (alphaMask, pixels));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (row), result);
+	}
+#endif
+	for (; x < width; ++x, row += 4)
+	{
+		auto alpha = row[AlphaIndex];
+		if (alpha == 255)
+			continue;
+		for (auto i = 0u; i < 4; ++i)
+		{
+			if (i != AlphaIndex)
+				row[i] = premultiply (row[i], alpha);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+template<uint32_t AlphaIndex>
+void unpremultiplyRow (uint8_t* row, uint32_t width)
+{
+	uint32_t x = 0;
+#if VSTGUI_PIXELBUFFER_SSE2
+	const auto zero = _mm_setzero_si128 ();
+	const auto byteMask = _mm_set1_epi32 (0xFF);
+	const auto maxValue = _mm_set1_ps (255.f);
+	for (; x + 4 <= width; x += 4, row += 16)
+	{
+		auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (row));
+		auto alpha = _mm_and_si128 (_mm_srli_epi32 (pixels, AlphaIndex * 8), byteMask);
+		auto alphaF = _mm_cvtepi32_ps (alpha);
+		auto halfAlphaF = _mm_cvtepi32_ps (_mm_srli_epi32 (alpha, 1));
+		auto result = _mm_slli_epi32 (alpha, AlphaIndex * 8);
+		for (auto i = 0u; i < 4; ++i)
+		{
+			if (i == AlphaIndex)
+				continue;
+			auto component = _mm_and_si128 (_mm_srli_epi32 (pixels, static_cast<int> (i * 8)),
+											byteMask);
+			// (component * 255 + alpha / 2) / alpha, the float division is exact enough to
+			// truncate to the same result as the integer division
+			auto n = _mm_add_ps (_mm_mul_ps (_mm_cvtepi32_ps (component), maxValue), halfAlphaF);
+			auto q = _mm_min_ps (_mm_div_ps (n, alphaF), maxValue);
+			result = _mm_or_si128 (
+				result, _mm_slli_epi32 (_mm_cvttps_epi32 (q), static_cast<int> (i * 8)));
+		}
+		// pixels with an alpha of zero stay as they are
+		auto zeroAlpha = _mm_cmpeq_epi32 (alpha, zero);
+		result = _mm_or_si128 (_mm_and_si128 (zeroAlpha, pixels),
+							   _mm_andnot_si128 (zeroAlpha, result));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (row), result);
+	}
+#endif
+	for (; x < width; ++x, row += 4)
+	{
+		auto alpha = row[AlphaIndex];
+		if (alpha == 0 || alpha == 255)
+			continue;
+		for (auto i = 0u; i < 4; ++i)
+		{
+			if (i != AlphaIndex)
+				row[i] = unpremultiply (row[i], alpha);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+template<void (*RowProc0) (uint8_t*, uint32_t), void (*RowProc3) (uint8_t*, uint32_t)>
+void processRows (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+				  uint32_t alphaByteIndex)
+{
+	auto proc = alphaByteIndex == 0 ? RowProc0 : RowProc3;
+	for (auto y = 0u; y < height; ++y, buffer += bytesPerRow)
+		proc (buffer, width);
+}
+
+//------------------------------------------------------------------------
+} // Private
+
+//------------------------------------------------------------------------
+void premultiplyAlpha (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+					   uint32_t alphaByteIndex)
+{
+	Private::processRows<Private::premultiplyRow<0>, Private::premultiplyRow<3>> (
+		buffer, bytesPerRow, width, height, alphaByteIndex);
+}
+
+//------------------------------------------------------------------------
+void unpremultiplyAlpha (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+						 uint32_t alphaByteIndex)
+{
+	Private::processRows<Private::unpremultiplyRow<0>, Private::unpremultiplyRow<3>> (
+		buffer, bytesPerRow, width, height, alphaByteIndex);
+}
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
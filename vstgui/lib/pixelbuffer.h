@@ -32,6 +32,35 @@ enum class Format
 void convert (Format srcFormat, Format dstFormat, uint8_t* buffer, uint32_t bytesPerRow,
 			  uint32_t width, uint32_t height);
 
+//------------------------------------------------------------------------
+/** Multiply the color components of a buffer of 32 bit pixels with their alpha component
+ *
+ *	@param buffer Pixel Buffer
+ *	@param bytesPerRow Number of bytes per row in buffer
+ *	@param width Number of pixels per row
+ *	@param height Number of rows
+ *	@param alphaByteIndex Position of the alpha byte in memory, 0 or 3
+ *	@ingroup new_in_4_11
+ */
+void premultiplyAlpha (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+					   uint32_t alphaByteIndex);
+
+//------------------------------------------------------------------------
+/** Divide the color components of a buffer of 32 bit pixels by their alpha component
+ *
+ *	Pixels with an alpha of zero are left as they are. Unpremultiplying and premultiplying again
+ *	results in the original pixels.
+ *
+ *	@param buffer Pixel Buffer
+ *	@param bytesPerRow Number of bytes per row in buffer
+ *	@param width Number of pixels per row
+ *	@param height Number of rows
+ *	@param alphaByteIndex Position of the alpha byte in memory, 0 or 3
+ *	@ingroup new_in_4_11
+ */
+void unpremultiplyAlpha (uint8_t* buffer, uint32_t bytesPerRow, uint32_t width, uint32_t height,
+						 uint32_t alphaByteIndex);
+
 //------------------------------------------------------------------------
 } // PixelBuffer
 } // VSTGUI
@@ -17,6 +17,7 @@
 #include "../../cvstguitimer.h"
 #include "../../events.h"
 #include "../../idatabrowserdelegate.h"
+#include <algorithm>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -63,13 +64,33 @@ public:
 		maxWidth = 0.;
 		maxTitleWidth = 0.;
 		hasRightMargin = false;
-		for (auto& item : *menu->getItems ())
+		const auto& items = *menu->getItems ();
+		std::vector<uint32_t> titleRows;
+		titleRows.reserve (items.size ());
+		for (auto row = 0u; row < items.size (); ++row)
 		{
+			const auto& item = items[row];
 			if (item->isSeparator ())
 				continue;
-			auto width = context->getStringWidth (item->getTitle ());
 			hasRightMargin |= item->getSubmenu () ? true : false;
 			hasRightMargin |= item->getIcon () ? true : false;
+			titleRows.emplace_back (row);
+		}
+		// measuring the text of thousands of items takes too long, in this case only the first
+		// rows and the titles with the most bytes are measured. As the width is only an estimate
+		// the title of an unmeasured item may be clipped.
+		if (titleRows.size () > MaxMeasuredTitles)
+		{
+			auto byteCount = [&] (uint32_t row) { return items[row]->getTitle ().length (); };
+			auto first = titleRows.begin () + MaxMeasuredTitles / 2;
+			auto last = titleRows.begin () + MaxMeasuredTitles;
+			std::nth_element (first, last, titleRows.end (),
+			                  [&] (auto a, auto b) { return byteCount (a) > byteCount (b); });
+			titleRows.resize (MaxMeasuredTitles);
+		}
+		for (auto row : titleRows)
+		{
+			auto width = context->getStringWidth (items[row]->getTitle ());
 			if (maxTitleWidth < width)
 				maxTitleWidth = width;
 		}
@@ -100,6 +121,10 @@ public:
 
 private:
 	static constexpr int32_t ViewRemoved = -2;
+	static constexpr size_t MaxMeasuredTitles = 256;
+
+	/** upper case title and row of a selectable item, sorted for the type-ahead search */
+	using TitleIndexEntry = std::pair<std::string, int32_t>;
 
 	void dbAttached (CDataBrowser* browser) override
 	{
@@ -171,10 +196,86 @@ private:
 		}
 	}
 
+	void buildTitleIndex ()
+	{
+		titleIndex.clear ();
+		const auto& items = *menu->getItems ();
+		titleIndex.reserve (items.size ());
+		for (auto row = 0u; row < items.size (); ++row)
+		{
+			const auto& item = items[row];
+			if (!item->isEnabled () || item->isSeparator () || item->isTitle ())
+				continue;
+			std::string title (item->getTitle ().getString ());
+			std::transform (title.begin (), title.end (), title.begin (), [] (auto c) {
+				return static_cast<char> (toupper (static_cast<unsigned char> (c)));
+			});
+			titleIndex.emplace_back (std::move (title), static_cast<int32_t> (row));
+		}
+		std::sort (titleIndex.begin (), titleIndex.end ());
+	}
+
+	int32_t findRowWithPrefix (const std::string& prefix)
+	{
+		if (titleIndex.empty ())
+			buildTitleIndex ();
+		auto it = std::lower_bound (titleIndex.begin (), titleIndex.end (),
+		                            TitleIndexEntry (prefix, -1));
+		int32_t result = CDataBrowser::kNoSelection;
+		for (; it != titleIndex.end () && it->first.compare (0, prefix.size (), prefix) == 0; ++it)
+		{
+			if (result == CDataBrowser::kNoSelection || it->second < result)
+				result = it->second;
+		}
+		return result;
+	}
+
+	bool onTypeAhead (char32_t character)
+	{
+		if (character < 0x20 || character > 0x7f)
+			return false;
+		if (typeAheadTimer)
+		{
+			typeAheadTimer->stop ();
+			typeAheadTimer->start ();
+		}
+		else
+		{
+			typeAheadTimer = makeOwned<CVSTGUITimer> (
+			    [this] (CVSTGUITimer*) {
+				    typeAheadString.clear ();
+				    typeAheadTimer = nullptr;
+			    },
+			    1000);
+		}
+		typeAheadString += static_cast<char> (toupper (static_cast<int> (character)));
+		auto row = findRowWithPrefix (typeAheadString);
+		if (row == CDataBrowser::kNoSelection)
+			return false;
+		if (row != db->getSelectedRow ())
+		{
+			closeSubMenu ();
+			db->setSelectedRow (row, true);
+		}
+		return true;
+	}
+
 	void dbOnKeyboardEvent (KeyboardEvent& event, CDataBrowser* browser) override
 	{
-		if (event.type != EventType::KeyDown || event.character != 0 || !event.modifiers.empty ())
+		if (event.type != EventType::KeyDown || !event.modifiers.empty ())
 			return;
+		if (event.virt == VirtualKey::Space)
+		{
+			if (onTypeAhead (0x20))
+				event.consumed = true;
+			return;
+		}
+		if (event.character != 0)
+		{
+			if (event.virt == VirtualKey::None && onTypeAhead (event.character))
+				event.consumed = true;
+			return;
+		}
 		switch (event.virt)
 		{
 			default: return;
@@ -446,6 +547,9 @@ private:
 	int32_t selectedRow {-1};
 	bool hasRightMargin {false};
 	GenericOptionMenuTheme theme;
+	std::vector<TitleIndexEntry> titleIndex;
+	std::string typeAheadString;
+	SharedPointer<CVSTGUITimer> typeAheadTimer;
 };
 
 //------------------------------------------------------------------------
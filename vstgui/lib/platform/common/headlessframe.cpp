@@ -0,0 +1,133 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "headlessframe.h"
+#include "../iplatformframecallback.h"
+#include "../iplatformopenglview.h"
+#include "../iplatformoptionmenu.h"
+#include "../iplatformtextedit.h"
+#include "../iplatformviewlayer.h"
+#include "../../cbuttonstate.h"
+#include "../../events.h"
+
+//-----------------------------------------------------------------------------
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+HeadlessFrame::HeadlessFrame (IPlatformFrameCallback* frame, const CRect& size)
+: IPlatformFrame (frame), size (size)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::getGlobalPosition (CPoint& pos) const
+{
+	pos = size.getTopLeft ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::setSize (const CRect& newSize)
+{
+	size = newSize;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::getSize (CRect& s) const
+{
+	s = size;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::getCurrentMousePosition (CPoint& mousePosition) const { return false; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::getCurrentMouseButtons (CButtonState& buttons) const
+{
+	buttons = 0;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::getCurrentModifiers (Modifiers& modifiers) const
+{
+	modifiers.clear ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::setMouseCursor (CCursorType type) { return false; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::invalidRect (const CRect& rect) { return true; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::scrollRect (const CRect& src, const CPoint& distance) { return false; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::showTooltip (const CRect& rect, const char* utf8Text) { return false; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::hideTooltip () { return false; }
+
+//-----------------------------------------------------------------------------
+void* HeadlessFrame::getPlatformRepresentation () const { return nullptr; }
+
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformTextEdit> HeadlessFrame::createPlatformTextEdit (
+	IPlatformTextEditCallback* textEdit)
+{
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformOptionMenu> HeadlessFrame::createPlatformOptionMenu () { return nullptr; }
+
+#if VSTGUI_OPENGL_SUPPORT
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformOpenGLView> HeadlessFrame::createPlatformOpenGLView () { return nullptr; }
+#endif // VSTGUI_OPENGL_SUPPORT
+
+//-----------------------------------------------------------------------------
+SharedPointer<IPlatformViewLayer> HeadlessFrame::createPlatformViewLayer (
+	IPlatformViewLayerDelegate* drawDelegate, IPlatformViewLayer* parentLayer)
+{
+	// without layers the layered views are drawn into the offscreen context
+	return nullptr;
+}
+
+#if VSTGUI_ENABLE_DEPRECATED_METHODS
+//-----------------------------------------------------------------------------
+DragResult HeadlessFrame::doDrag (IDataPackage* source, const CPoint& offset, CBitmap* dragBitmap)
+{
+	return kDragError;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::doDrag (const DragDescription& dragDescription,
+							const SharedPointer<IDragCallback>& callback)
+{
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+PlatformType HeadlessFrame::getPlatformType () const { return PlatformType::kDefaultNative; }
+
+//-----------------------------------------------------------------------------
+void HeadlessFrame::onFrameClosed () {}
+
+//-----------------------------------------------------------------------------
+Optional<UTF8String> HeadlessFrame::convertCurrentKeyEventToText () { return {}; }
+
+//-----------------------------------------------------------------------------
+bool HeadlessFrame::setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme)
+{
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+} // VSTGUI
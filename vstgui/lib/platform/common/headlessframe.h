@@ -0,0 +1,58 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformframe.h"
+#include "../../crect.h"
+
+//-----------------------------------------------------------------------------
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** platform frame without a window
+ *
+ *	Used by CFrame::openHeadless. The frame is only drawn into offscreen contexts, so it does
+ *	not need a window system connection.
+ */
+class HeadlessFrame : public IPlatformFrame
+{
+public:
+	HeadlessFrame (IPlatformFrameCallback* frame, const CRect& size);
+
+	bool getGlobalPosition (CPoint& pos) const override;
+	bool setSize (const CRect& newSize) override;
+	bool getSize (CRect& size) const override;
+	bool getCurrentMousePosition (CPoint& mousePosition) const override;
+	bool getCurrentMouseButtons (CButtonState& buttons) const override;
+	bool getCurrentModifiers (Modifiers& modifiers) const override;
+	bool setMouseCursor (CCursorType type) override;
+	bool invalidRect (const CRect& rect) override;
+	bool scrollRect (const CRect& src, const CPoint& distance) override;
+	bool showTooltip (const CRect& rect, const char* utf8Text) override;
+	bool hideTooltip () override;
+	void* getPlatformRepresentation () const override;
+	SharedPointer<IPlatformTextEdit> createPlatformTextEdit (IPlatformTextEditCallback* textEdit) override;
+	SharedPointer<IPlatformOptionMenu> createPlatformOptionMenu () override;
+#if VSTGUI_OPENGL_SUPPORT
+	SharedPointer<IPlatformOpenGLView> createPlatformOpenGLView () override;
+#endif // VSTGUI_OPENGL_SUPPORT
+	SharedPointer<IPlatformViewLayer> createPlatformViewLayer (
+		IPlatformViewLayerDelegate* drawDelegate, IPlatformViewLayer* parentLayer = nullptr) override;
+#if VSTGUI_ENABLE_DEPRECATED_METHODS
+	DragResult doDrag (IDataPackage* source, const CPoint& offset, CBitmap* dragBitmap) override;
+#endif
+	bool doDrag (const DragDescription& dragDescription,
+				 const SharedPointer<IDragCallback>& callback) override;
+	PlatformType getPlatformType () const override;
+	void onFrameClosed () override;
+	Optional<UTF8String> convertCurrentKeyEventToText () override;
+	bool setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme = nullptr) override;
+
+private:
+	CRect size;
+};
+
+//-----------------------------------------------------------------------------
+} // VSTGUI
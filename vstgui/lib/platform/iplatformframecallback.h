@@ -7,6 +7,8 @@
 /// @cond ignore
 
 #include "../vstguifwd.h"
+#include "../crect.h"
+#include <vector>
 
 struct VstKeyCode;
 
@@ -32,6 +34,26 @@ class IPlatformFrameCallback
 {
 public:
 	virtual bool platformDrawRect (CDrawContext* context, const CRect& rect) = 0;
+	/** called on the main thread before rects are drawn at the same time. Fills groups with one
+	 *	entry per rect: the index of the group the rect is drawn with on a worker thread via
+	 *	platformDrawRectConcurrently, or -1 if the rect must be drawn via platformDrawRect. The
+	 *	rects of one group are drawn one after the other on the same thread. Returns the number of
+	 *	groups.
+	 */
+	virtual uint32_t platformPrepareConcurrentDraw (const std::vector<CRect>& rects,
+													std::vector<int32_t>& groups)
+	{
+		groups.assign (rects.size (), -1);
+		return 0;
+	}
+	/** draw rect on a worker thread, the rects of other groups may be drawn at the same time */
+	virtual void platformDrawRectConcurrently (CDrawContext* context, const CRect& rect)
+	{
+		platformDrawRect (context, rect);
+	}
+	/** called on the main thread after all rects of the last platformPrepareConcurrentDraw call
+	 *	were drawn */
+	virtual void platformDidDrawConcurrently () {}
 	
 	virtual void platformOnEvent (Event& event) = 0;
 
@@ -4,6 +4,7 @@
 
 #include "../../cpoint.h"
 #include "../../cresourcedescription.h"
+#include "../../pixelbuffer.h"
 #include "linuxfactory.h"
 #include "cairobitmap.h"
 #include <memory>
@@ -103,11 +104,12 @@ class PixelAccess : public IPlatformBitmapPixelAccess
 public:
 	~PixelAccess () override;
 
-	bool init (Bitmap* bitmap, const SurfaceHandle& surface);
+	bool init (Bitmap* bitmap, const SurfaceHandle& surface, bool alphaPremultiplied);
 
 private:
 	uint8_t* address {nullptr};
 	uint32_t bytesPerRow {0};
+	bool alphaPremultiplied {true};
 
 	uint8_t* getAddress () const override { return address; }
 	uint32_t getBytesPerRow () const override { return bytesPerRow; }
@@ -120,6 +122,8 @@ private:
 #endif
 	}
 
+	uint32_t getAlphaByteIndex () const { return getPixelFormat () == kBGRA ? 3 : 0; }
+
 	SharedPointer<Bitmap> bitmap;
 	SurfaceHandle surface;
 };
@@ -219,10 +223,9 @@ SharedPointer<IPlatformBitmapPixelAccess> Bitmap::lockPixels (bool alphaPremulti
 {
 	if (locked)
 		return nullptr;
-#warning TODO: alphaPremultiplied is currently ignored, always treated as true
 	locked = true;
 	auto pixelAccess = owned (new CairoBitmapPrivate::PixelAccess ());
-	if (pixelAccess->init (this, surface))
+	if (pixelAccess->init (this, surface, alphaPremultiplied))
 		return pixelAccess;
 	return nullptr;
 }
@@ -250,7 +253,8 @@ PNGBitmapBuffer Bitmap::createMemoryPNGRepresentation () const
 namespace CairoBitmapPrivate {
 
 //-----------------------------------------------------------------------------
-bool PixelAccess::init (Bitmap* inBitmap, const SurfaceHandle& inSurface)
+bool PixelAccess::init (Bitmap* inBitmap, const SurfaceHandle& inSurface,
+						bool inAlphaPremultiplied)
 {
 	cairo_surface_flush (inSurface);
 	address = cairo_image_surface_get_data (inSurface);
@@ -269,12 +273,27 @@ bool PixelAccess::init (Bitmap* inBitmap, const SurfaceHandle& inSurface)
 	surface = inSurface;
 	bitmap = inBitmap;
 	bytesPerRow = cairo_image_surface_get_stride (surface);
+	alphaPremultiplied = inAlphaPremultiplied;
+	if (!alphaPremultiplied)
+	{
+		PixelBuffer::unpremultiplyAlpha (address, bytesPerRow,
+										 cairo_image_surface_get_width (surface),
+										 cairo_image_surface_get_height (surface),
+										 getAlphaByteIndex ());
+	}
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 PixelAccess::~PixelAccess ()
 {
+	if (!alphaPremultiplied)
+	{
+		PixelBuffer::premultiplyAlpha (address, bytesPerRow,
+									   cairo_image_surface_get_width (surface),
+									   cairo_image_surface_get_height (surface),
+									   getAlphaByteIndex ());
+	}
 	cairo_surface_mark_dirty (surface);
 	bitmap->unlock ();
 }
@@ -4,10 +4,13 @@
 
 #include "cairocontext.h"
 #include "../../cbitmap.h"
+#include "../../cdrawprofiler.h"
 #include "../../cgradient.h"
 #include "cairobitmap.h"
 #include "cairogradient.h"
 #include "cairopath.h"
+#include <algorithm>
+#include <cmath>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -50,6 +53,64 @@ inline bool needPixelAlignment (CDrawMode mode)
 	return (mode.integralMode () && mode.modeIgnoringIntegralMode () == kAntiAliasing);
 }
 
+//-----------------------------------------------------------------------------
+cairo_antialias_t convert (AntialiasQuality quality)
+{
+	switch (quality)
+	{
+		case AntialiasQuality::kFast: return CAIRO_ANTIALIAS_FAST;
+		case AntialiasQuality::kGood: return CAIRO_ANTIALIAS_GOOD;
+		case AntialiasQuality::kDefault:
+		case AntialiasQuality::kBest: break;
+	}
+	return CAIRO_ANTIALIAS_BEST;
+}
+
+//-----------------------------------------------------------------------------
+cairo_filter_t convert (BitmapInterpolationQuality quality)
+{
+	switch (quality)
+	{
+		case BitmapInterpolationQuality::kLow: return CAIRO_FILTER_FAST;
+		case BitmapInterpolationQuality::kHigh: return CAIRO_FILTER_BEST;
+		case BitmapInterpolationQuality::kDefault:
+		case BitmapInterpolationQuality::kMedium: break;
+	}
+	return CAIRO_FILTER_GOOD;
+}
+
+//-----------------------------------------------------------------------------
+inline bool isIntegral (double value)
+{
+	return std::abs (value - std::round (value)) < 0.0001;
+}
+
+//-----------------------------------------------------------------------------
+/** check if a bitmap with the scale factor drawn at the origin maps its pixels one to one onto
+ *	the device pixels, in which case no interpolation is needed
+ */
+bool isPixelExact (cairo_t* cr, double bitmapScaleFactor, CPoint origin)
+{
+	cairo_matrix_t matrix;
+	cairo_get_matrix (cr, &matrix);
+	if (matrix.xy != 0. || matrix.yx != 0.)
+		return false;
+	double scaleX = 1.;
+	double scaleY = 1.;
+	cairo_surface_get_device_scale (cairo_get_target (cr), &scaleX, &scaleY);
+	if (std::abs (matrix.xx * scaleX - bitmapScaleFactor) > 0.0001 ||
+		std::abs (matrix.yy * scaleY - bitmapScaleFactor) > 0.0001)
+		return false;
+	double offsetX = 0.;
+	double offsetY = 0.;
+	cairo_surface_get_device_offset (cairo_get_target (cr), &offsetX, &offsetY);
+	cairo_matrix_transform_point (&matrix, &origin.x, &origin.y);
+	return isIntegral (origin.x * scaleX + offsetX) && isIntegral (origin.y * scaleY + offsetY);
+}
+
+//-----------------------------------------------------------------------------
+constexpr size_t kMaxCachedBitmapPatterns = 16;
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -71,7 +132,7 @@ DrawBlock::DrawBlock (Context& context) : context (context)
 		auto matrix = convert (ct);
 		cairo_set_matrix (context.getCairo (), &matrix);
 		auto antialiasMode = context.getDrawMode ().modeIgnoringIntegralMode () == kAntiAliasing
-								 ? CAIRO_ANTIALIAS_BEST
+								 ? convert (context.getAntialiasQuality ())
 								 : CAIRO_ANTIALIAS_NONE;
 		cairo_set_antialias (context.getCairo (), antialiasMode);
 	}
@@ -139,6 +200,8 @@ void Context::beginDraw ()
 //-----------------------------------------------------------------------------
 void Context::endDraw ()
 {
+	// don't keep the bitmap surfaces alive after drawing
+	bitmapPatterns.clear ();
 	cairo_restore (cr);
 	if (surface)
 		cairo_surface_flush (surface);
@@ -387,14 +450,19 @@ void Context::drawPoint (const CPoint& point, const CColor& color)
 //-----------------------------------------------------------------------------
 void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offset, float alpha)
 {
+	CDrawProfiler::Scope profilerScope (getDrawProfiler (), CDrawProfiler::Category::Bitmap);
 	if (auto cd = DrawBlock::begin (*this))
 	{
 		double transformedScaleFactor = getScaleFactor ();
 		CGraphicsTransform t = getCurrentTransform ();
 		if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
 			transformedScaleFactor *= t.m11;
-		auto cairoBitmap =
-			bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor).cast<Bitmap> ();
+		// a scaled down copy only depends on the device scale factor, so that it is not created
+		// again for every step of a scale animation. Cairo filters the scaling of the transform.
+		auto platformBitmap = transformedScaleFactor > getScaleFactor ()
+								  ? bitmap->getBestPlatformBitmapForScaleFactor (transformedScaleFactor)
+								  : bitmap->getScaledPlatformBitmap (getScaleFactor ());
+		auto cairoBitmap = platformBitmap.cast<Bitmap> ();
 		if (cairoBitmap)
 		{
 			cairo_translate (cr, dest.left, dest.top);
@@ -402,13 +470,18 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
 			cairo_clip (cr);
 
 			// Setup a pattern for scaling bitmaps and take it as source afterwards.
-			auto pattern = cairo_pattern_create_for_surface (cairoBitmap->getSurface ());
+			const auto& pattern = getBitmapPattern (cairoBitmap);
 			cairo_matrix_t matrix;
-			cairo_pattern_get_matrix (pattern, &matrix);
 			cairo_matrix_init_scale (&matrix, cairoBitmap->getScaleFactor (),
 									 cairoBitmap->getScaleFactor ());
 			cairo_matrix_translate (&matrix, offset.x, offset.y);
 			cairo_pattern_set_matrix (pattern, &matrix);
+			// without scaling the pixels are copied as they are, which pixman does with a plain
+			// blit instead of interpolating
+			if (isPixelExact (cr, cairoBitmap->getScaleFactor (), {-offset.x, -offset.y}))
+				cairo_pattern_set_filter (pattern, CAIRO_FILTER_NEAREST);
+			else
+				cairo_pattern_set_filter (pattern, convert (getBitmapInterpolationQuality ()));
 			cairo_set_source (cr, pattern);
 
 			cairo_rectangle (cr, -offset.x, -offset.y, dest.getWidth () + offset.x,
@@ -422,13 +495,27 @@ void Context::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoint& offs
 			{
 				cairo_fill (cr);
 			}
-
-			cairo_pattern_destroy (pattern);
 		}
 	}
 	checkCairoStatus (cr);
 }
 
+//-----------------------------------------------------------------------------
+const PatternHandle& Context::getBitmapPattern (Bitmap* bitmap)
+{
+	cairo_surface_t* bitmapSurface = bitmap->getSurface ();
+	auto it = std::find_if (bitmapPatterns.begin (), bitmapPatterns.end (),
+							[&] (const BitmapPattern& p) { return p.surface == bitmapSurface; });
+	if (it != bitmapPatterns.end ())
+		return it->pattern;
+	// the pattern holds a reference to the surface, so the cached surface pointer stays valid
+	if (bitmapPatterns.size () >= kMaxCachedBitmapPatterns)
+		bitmapPatterns.erase (bitmapPatterns.begin ());
+	bitmapPatterns.push_back (
+		{bitmapSurface, PatternHandle (cairo_pattern_create_for_surface (bitmapSurface))});
+	return bitmapPatterns.back ().pattern;
+}
+
 //-----------------------------------------------------------------------------
 void Context::clearRect (const CRect& rect)
 {
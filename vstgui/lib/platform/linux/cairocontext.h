@@ -8,6 +8,7 @@
 #include "cairopath.h"
 
 #include "../../coffscreencontext.h"
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -65,9 +66,18 @@ private:
 	void setSourceColor (CColor color);
 	void setupCurrentStroke ();
 	void draw (CDrawStyle drawstyle);
+	const PatternHandle& getBitmapPattern (Bitmap* bitmap);
+
+	struct BitmapPattern
+	{
+		cairo_surface_t* surface;
+		PatternHandle pattern;
+	};
+	using BitmapPatternCache = std::vector<BitmapPattern>;
 
 	SurfaceHandle surface;
 	ContextHandle cr;
+	BitmapPatternCache bitmapPatterns;
 
 	PlatformGraphicsPathFactoryPtr graphicsPathFactory;
 };
@@ -0,0 +1,240 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cairotilerenderer.h"
+#include "cairocontext.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+struct TileRenderer::Impl
+{
+	struct Tile
+	{
+		CRect rect;
+		int32_t x;
+		int32_t y;
+		int32_t width;
+		int32_t height;
+	};
+	using TileList = std::vector<Tile>;
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workDone;
+	uint64_t generation {0};
+	uint32_t numFinished {0};
+	bool quit {false};
+
+	// the state of the current batch, only changed while the workers are idle
+	IPlatformFrameCallback* frame {nullptr};
+	unsigned char* data {nullptr};
+	cairo_format_t format {CAIRO_FORMAT_ARGB32};
+	int stride {0};
+	double scaleFactor {1.};
+	TileList tiles;
+	std::vector<CRect> tileRects;
+	std::vector<int32_t> tileGroups;
+	// the indices of the tiles of each group, a group is drawn by one thread
+	std::vector<std::vector<size_t>> groups;
+	std::atomic<size_t> nextGroup {0};
+
+	Impl (uint32_t numThreads)
+	{
+		for (auto i = 0u; i < numThreads; ++i)
+			threads.emplace_back ([this] () { workerLoop (); });
+	}
+
+	~Impl () noexcept
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			quit = true;
+		}
+		workAvailable.notify_all ();
+		for (auto& thread : threads)
+			thread.join ();
+	}
+
+	void workerLoop ()
+	{
+		uint64_t lastGeneration = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock (mutex);
+				workAvailable.wait (lock, [&] () { return quit || generation != lastGeneration; });
+				if (quit)
+					return;
+				lastGeneration = generation;
+			}
+			drawConcurrentGroups ();
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				++numFinished;
+			}
+			workDone.notify_one ();
+		}
+	}
+
+	void drawConcurrentGroups ()
+	{
+		for (auto index = nextGroup++; index < groups.size (); index = nextGroup++)
+		{
+			for (auto tileIndex : groups[index])
+				drawTile (tiles[tileIndex], true);
+		}
+	}
+
+	void drawTile (const Tile& tile, bool concurrently)
+	{
+		auto bytesPerPixel = 4;
+		SurfaceHandle surface (cairo_image_surface_create_for_data (
+			data + tile.y * stride + tile.x * bytesPerPixel, format, tile.width, tile.height,
+			stride));
+		cairo_surface_set_device_scale (surface, scaleFactor, scaleFactor);
+		cairo_surface_set_device_offset (surface, -tile.x, -tile.y);
+		auto context = makeOwned<Context> (tile.rect, surface);
+		context->beginDraw ();
+		context->setClipRect (tile.rect);
+		context->saveGlobalState ();
+		if (concurrently)
+			frame->platformDrawRectConcurrently (context, tile.rect);
+		else
+			frame->platformDrawRect (context, tile.rect);
+		context->restoreGlobalState ();
+		context->endDraw ();
+	}
+
+	void splitIntoTiles (const CRect& rect, int32_t surfaceWidth, int32_t surfaceHeight)
+	{
+		// round outwards to whole pixels, so that the tiles do not share any pixels
+		auto left = std::max (0, static_cast<int32_t> (std::floor (rect.left * scaleFactor)));
+		auto top = std::max (0, static_cast<int32_t> (std::floor (rect.top * scaleFactor)));
+		auto right =
+			std::min (surfaceWidth, static_cast<int32_t> (std::ceil (rect.right * scaleFactor)));
+		auto bottom =
+			std::min (surfaceHeight, static_cast<int32_t> (std::ceil (rect.bottom * scaleFactor)));
+		if (right <= left || bottom <= top)
+			return;
+		for (auto y = top; y < bottom; y += kTileSize)
+		{
+			for (auto x = left; x < right; x += kTileSize)
+			{
+				Tile tile;
+				tile.x = x;
+				tile.y = y;
+				tile.width = std::min (kTileSize, right - x);
+				tile.height = std::min (kTileSize, bottom - y);
+				tile.rect = CRect (x / scaleFactor, y / scaleFactor, (x + tile.width) / scaleFactor,
+								   (y + tile.height) / scaleFactor);
+				tiles.emplace_back (tile);
+			}
+		}
+	}
+
+	void assignGroups ()
+	{
+		groups.clear ();
+		tileGroups.assign (tiles.size (), -1);
+		if (tiles.size () < 2)
+			return;
+		tileRects.clear ();
+		for (const auto& tile : tiles)
+			tileRects.emplace_back (tile.rect);
+		groups.resize (frame->platformPrepareConcurrentDraw (tileRects, tileGroups));
+		for (size_t index = 0; index < tiles.size (); ++index)
+		{
+			if (tileGroups[index] >= 0)
+				groups[static_cast<size_t> (tileGroups[index])].emplace_back (index);
+		}
+	}
+
+	void drawTiles ()
+	{
+		if (!groups.empty ())
+		{
+			nextGroup = 0;
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				numFinished = 0;
+				++generation;
+			}
+			workAvailable.notify_all ();
+		}
+		for (size_t index = 0; index < tiles.size (); ++index)
+		{
+			if (tileGroups[index] < 0)
+				drawTile (tiles[index], false);
+		}
+		if (groups.empty ())
+			return;
+		drawConcurrentGroups ();
+		{
+			// wait until every worker has seen this batch, so that the batch state can be
+			// changed afterwards
+			std::unique_lock<std::mutex> lock (mutex);
+			workDone.wait (lock, [&] () { return numFinished == threads.size (); });
+		}
+		frame->platformDidDrawConcurrently ();
+	}
+};
+
+//------------------------------------------------------------------------
+TileRenderer::TileRenderer (uint32_t numThreads)
+{
+	impl = std::unique_ptr<Impl> (new Impl (numThreads));
+}
+
+//------------------------------------------------------------------------
+TileRenderer::~TileRenderer () noexcept = default;
+
+//------------------------------------------------------------------------
+uint32_t TileRenderer::getNumThreads () const
+{
+	return static_cast<uint32_t> (impl->threads.size ());
+}
+
+//------------------------------------------------------------------------
+void TileRenderer::draw (const SurfaceHandle& surface, double scaleFactor, const RectList& rects,
+						 IPlatformFrameCallback* frame)
+{
+	assert (cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_IMAGE);
+	auto format = cairo_image_surface_get_format (surface);
+	if (format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24)
+		return;
+	cairo_surface_flush (surface);
+	impl->frame = frame;
+	impl->data = cairo_image_surface_get_data (surface);
+	impl->format = format;
+	impl->stride = cairo_image_surface_get_stride (surface);
+	impl->scaleFactor = scaleFactor;
+	auto width = cairo_image_surface_get_width (surface);
+	auto height = cairo_image_surface_get_height (surface);
+	// the tiles of one rect never overlap, but the rounded tiles of different rects may, so the
+	// rects are drawn one after the other
+	for (const auto& rect : rects)
+	{
+		impl->tiles.clear ();
+		impl->splitIntoTiles (rect, width, height);
+		impl->assignGroups ();
+		impl->drawTiles ();
+	}
+	impl->frame = nullptr;
+	cairo_surface_mark_dirty (surface);
+}
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
@@ -0,0 +1,57 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cairoutils.h"
+#include "../../crect.h"
+#include "../iplatformframecallback.h"
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+
+//------------------------------------------------------------------------
+/** Draws the dirty regions of a frame into an image surface in tiles
+ *
+ *	Dirty rects larger than one tile are split into tiles. The frame groups the tiles, so that
+ *	every view is drawn in the tiles of one group only (see
+ *	IPlatformFrameCallback::platformPrepareConcurrentDraw). Groups which only contain thread safe
+ *	views (see CView::setThreadSafeDrawing) are drawn by the worker threads and the calling
+ *	thread, all other tiles are drawn on the calling thread. Every tile is drawn with its own
+ *	context into a surface sharing the pixel memory of the target surface.
+ */
+class TileRenderer
+{
+public:
+	using RectList = std::vector<CRect>;
+
+	static constexpr int32_t kTileSize = 256;
+
+	/** @param numThreads number of worker threads */
+	explicit TileRenderer (uint32_t numThreads);
+	~TileRenderer () noexcept;
+
+	/** draw the rects into the image surface
+	 *
+	 *	@param surface ARGB32 or RGB24 image surface
+	 *	@param scaleFactor scale factor of the surface
+	 *	@param rects rects to draw in frame coordinates
+	 *	@param frame the frame to draw
+	 */
+	void draw (const SurfaceHandle& surface, double scaleFactor, const RectList& rects,
+			   IPlatformFrameCallback* frame);
+
+	uint32_t getNumThreads () const;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+//------------------------------------------------------------------------
+} // Cairo
+} // VSTGUI
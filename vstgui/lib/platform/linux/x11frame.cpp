@@ -20,8 +20,11 @@
 #include "../common/genericoptionmenu.h"
 #include "cairobitmap.h"
 #include "cairocontext.h"
+#include "cairotilerenderer.h"
 #include "x11platform.h"
 #include "x11utils.h"
+#include "x11viewlayer.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <unordered_map>
@@ -165,8 +168,12 @@ struct RedrawTimerHandler
 //------------------------------------------------------------------------
 struct DrawHandler
 {
-	DrawHandler (const ChildWindow& window)
+	using ViewLayers = std::vector<ViewLayer*>;
+
+	DrawHandler (const ChildWindow& window, uint32_t numDrawThreads)
 	{
+		if (numDrawThreads > 0)
+			tileRenderer = std::make_unique<Cairo::TileRenderer> (numDrawThreads);
 		auto s = cairo_xcb_surface_create (RunLoop::instance ().getXcbConnection (),
 										   window.getID (), window.getVisual (),
 										   window.getSize ().x, window.getSize ().y);
@@ -183,31 +190,63 @@ struct DrawHandler
 	void onSizeChanged (const CPoint& size)
 	{
 		cairo_xcb_surface_set_size (windowSurface, size.x, size.y);
-		backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
-			windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
+		windowSize = size;
+		composeBuffer.reset ();
+		// the tile renderer needs direct access to the pixels of the back buffer
+		if (tileRenderer)
+			backBuffer = Cairo::SurfaceHandle (
+				cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size.x, size.y));
+		else
+			backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
+				windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
 		CRect r;
 		r.setSize (size);
 		drawContext = makeOwned<Cairo::Context> (r, backBuffer);
 	}
 
-	template<typename RectList, typename Proc>
-	void draw (const RectList& dirtyRects, Proc proc)
+	void draw (const CInvalidRectList& dirtyRects, CInvalidRectList damage,
+			   const ViewLayers& viewLayers, IPlatformFrameCallback* frame)
 	{
+		if (tileRenderer)
+		{
+			tileRenderer->draw (backBuffer, 1., dirtyRects.data (), frame);
+			for (auto rect : dirtyRects)
+				damage.add (rect);
+		}
+		else
+		{
+			drawContext->beginDraw ();
+			for (auto rect : dirtyRects)
+			{
+				drawContext->setClipRect (rect);
+				drawContext->saveGlobalState ();
+				frame->platformDrawRect (drawContext, rect);
+				drawContext->restoreGlobalState ();
+				damage.add (rect);
+			}
+			drawContext->endDraw ();
+		}
+		for (auto& layer : viewLayers)
+			layer->drawInvalidRects (damage);
 		CRect copyRect;
-		drawContext->beginDraw ();
-		for (auto rect : dirtyRects)
+		for (const auto& rect : damage)
 		{
-			drawContext->setClipRect (rect);
-			drawContext->saveGlobalState ();
-			proc (drawContext, rect);
-			drawContext->restoreGlobalState ();
 			if (copyRect.isEmpty ())
 				copyRect = rect;
 			else
 				copyRect.unite (rect);
 		}
-		drawContext->endDraw ();
-		blitBackbufferToWindow (copyRect);
+		if (copyRect.isEmpty ())
+			return;
+		if (viewLayers.empty ())
+		{
+			blitToWindow (backBuffer, copyRect);
+		}
+		else
+		{
+			composeViewLayers (damage, viewLayers);
+			blitToWindow (composeBuffer, copyRect);
+		}
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
@@ -215,14 +254,39 @@ private:
 	cairo_device_t* device = nullptr;
 	Cairo::SurfaceHandle windowSurface;
 	Cairo::SurfaceHandle backBuffer;
+	Cairo::SurfaceHandle composeBuffer;
 	SharedPointer<Cairo::Context> drawContext;
+	std::unique_ptr<Cairo::TileRenderer> tileRenderer;
+	CPoint windowSize;
 
-	void blitBackbufferToWindow (const CRect& rect)
+	void composeViewLayers (const CInvalidRectList& damage, const ViewLayers& viewLayers)
+	{
+		if (!composeBuffer)
+			composeBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
+				windowSurface, CAIRO_CONTENT_COLOR_ALPHA, windowSize.x, windowSize.y));
+		Cairo::ContextHandle context (cairo_create (composeBuffer));
+		for (const auto& rect : damage)
+		{
+			cairo_save (context);
+			cairo_rectangle (context, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
+			cairo_clip (context);
+			cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+			cairo_set_source_surface (context, backBuffer, 0, 0);
+			cairo_paint (context);
+			cairo_set_operator (context, CAIRO_OPERATOR_OVER);
+			for (const auto& layer : viewLayers)
+				layer->composite (context, rect);
+			cairo_restore (context);
+		}
+		cairo_surface_flush (composeBuffer);
+	}
+
+	void blitToWindow (const Cairo::SurfaceHandle& surface, const CRect& rect)
 	{
 		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
 		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
 		cairo_clip (windowContext);
-		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
+		cairo_set_source_surface (windowContext, surface, 0, 0);
 		cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (), rect.getHeight ());
 		cairo_fill (windowContext);
 		cairo_surface_flush (windowSurface);
@@ -315,7 +379,9 @@ private:
 };
 
 //------------------------------------------------------------------------
-struct Frame::Impl : IFrameEventHandler
+struct Frame::Impl
+: IFrameEventHandler
+, IViewLayerHost
 {
 	using RectList = CInvalidRectList;
 
@@ -326,19 +392,30 @@ struct Frame::Impl : IFrameEventHandler
 	std::unique_ptr<GenericOptionMenuTheme> genericOptionMenuTheme;
 	SharedPointer<RedrawTimerHandler> redrawTimer;
 	RectList dirtyRects;
+	RectList composeRects;
+	DrawHandler::ViewLayers viewLayers;
+	bool viewLayersSorted {true};
 	CCursorType currentCursor {kCursorDefault};
 	uint32_t pointerGrabed {0};
 	XdndHandler dndHandler;
 
 	//------------------------------------------------------------------------
-	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
-	: window (parent, size), drawHandler (window), frame (frame), dndHandler (&window, frame)
+	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame, uint32_t numDrawThreads)
+	: window (parent, size)
+	, drawHandler (window, numDrawThreads)
+	, frame (frame)
+	, dndHandler (&window, frame)
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
 	}
 
 	//------------------------------------------------------------------------
-	~Impl () noexcept { RunLoop::instance ().unregisterWindowEventHandler (window.getID ()); }
+	~Impl () noexcept
+	{
+		for (auto& layer : viewLayers)
+			layer->detachFromHost ();
+		RunLoop::instance ().unregisterWindowEventHandler (window.getID ());
+	}
 
 	//------------------------------------------------------------------------
 	void setSize (const CRect& size)
@@ -372,25 +449,61 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void redraw ()
 	{
-		drawHandler.draw (dirtyRects, [&] (CDrawContext* context, const CRect& rect) {
-			frame->platformDrawRect (context, rect);
-		});
+		if (!viewLayersSorted)
+		{
+			std::stable_sort (viewLayers.begin (), viewLayers.end (),
+							  ViewLayer::compositeOrderLess);
+			viewLayersSorted = true;
+		}
+		drawHandler.draw (dirtyRects, composeRects, viewLayers, frame);
 		dirtyRects.clear ();
+		composeRects.clear ();
 	}
 
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
 		dirtyRects.add (r);
+		scheduleRedraw ();
+	}
+
+	//------------------------------------------------------------------------
+	void scheduleRedraw ()
+	{
 		if (redrawTimer)
 			return;
 		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this] () {
-			if (dirtyRects.data ().empty ())
+			if (dirtyRects.data ().empty () && composeRects.data ().empty ())
 				return;
 			redraw ();
 		});
 	}
 
+	//------------------------------------------------------------------------
+	void registerViewLayer (ViewLayer* layer)
+	{
+		viewLayers.push_back (layer);
+		viewLayersSorted = false;
+	}
+
+	//------------------------------------------------------------------------
+	void invalidViewLayerComposition (const CRect& rect) override
+	{
+		composeRects.add (rect);
+		scheduleRedraw ();
+	}
+
+	//------------------------------------------------------------------------
+	void viewLayerOrderChanged () override { viewLayersSorted = false; }
+
+	//------------------------------------------------------------------------
+	void unregisterViewLayer (ViewLayer* layer) override
+	{
+		auto it = std::find (viewLayers.begin (), viewLayers.end (), layer);
+		if (it != viewLayers.end ())
+			viewLayers.erase (it);
+	}
+
 	//------------------------------------------------------------------------
 	void grabPointer ()
 	{
@@ -508,17 +621,16 @@ struct Frame::Impl : IFrameEventHandler
 	}
 
 	//------------------------------------------------------------------------
-	void onEvent (xcb_motion_notify_event_t& event) override
+	void onEvent (xcb_motion_notify_event_t& event, const MotionHistory& history) override
 	{
 		MouseMoveEvent moveEvent;
 		moveEvent.mousePosition (event.event_x, event.event_y);
+		moveEvent.coalescedPositions = history.data ();
+		moveEvent.numCoalescedPositions = history.size ();
 		setupMouseEventButtons (moveEvent, event.state);
 		setupEventModifiers (moveEvent.modifiers, event.state);
 		doubleClickDetector.onEvent (moveEvent, event.time);
 		frame->platformOnEvent (moveEvent);
-		// make sure we get more motion events
-		auto xcb = RunLoop::instance ().getXcbConnection ();
-		xcb_get_motion_events (xcb, window.getID (), event.time, event.time + 10000000);
 	}
 
 	//------------------------------------------------------------------------
@@ -650,7 +762,8 @@ Frame::Frame (IPlatformFrameCallback* frame, const CRect& size, uint32_t parent,
 		RunLoop::init (cfg->runLoop);
 	}
 
-	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame,
+											cfg ? cfg->numDrawThreads : 0));
 
 	frame->platformOnActivate (true);
 }
@@ -802,8 +915,13 @@ SharedPointer<IPlatformOpenGLView> Frame::createPlatformOpenGLView ()
 SharedPointer<IPlatformViewLayer> Frame::createPlatformViewLayer (
 	IPlatformViewLayerDelegate* drawDelegate, IPlatformViewLayer* parentLayer)
 {
-	// optional
-	return nullptr;
+	// the layer is only notified about later scale factor changes
+	auto cFrame = dynamic_cast<CFrame*> (frame);
+	auto scaleFactor = cFrame ? cFrame->getScaleFactor () : 1.;
+	auto layer = makeOwned<ViewLayer> (drawDelegate, dynamic_cast<ViewLayer*> (parentLayer),
+									   impl.get (), scaleFactor);
+	impl->registerViewLayer (layer);
+	return layer;
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -0,0 +1,72 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../cpoint.h"
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace X11 {
+
+using MotionHistory = std::vector<CPoint>;
+
+//------------------------------------------------------------------------
+/** Coalesces consecutive motion notify events of one window
+ *
+ *	Motion events are held back until an event of another type, a motion event of another window
+ *	or with another button and modifier state arrives, or the event queue is drained. Only the
+ *	newest event is dispatched, the positions of the events it replaced are passed along as
+ *	history, oldest first.
+ *
+ *	MotionEvent must provide the fields of xcb_motion_notify_event_t: event, state, event_x and
+ *	event_y.
+ */
+template<typename MotionEvent>
+class MotionEventCoalescer
+{
+public:
+	static constexpr size_t kMaxHistorySize = 256;
+
+	/** add a motion event, the pending event is dispatched first if the event cannot be coalesced
+	 *	with it
+	 */
+	template<typename Proc>
+	void add (const MotionEvent& event, Proc&& dispatch)
+	{
+		if (hasPending && (pending.event != event.event || pending.state != event.state))
+			flush (dispatch);
+		if (hasPending)
+		{
+			if (history.size () == kMaxHistorySize)
+				history.erase (history.begin ());
+			history.emplace_back (pending.event_x, pending.event_y);
+		}
+		pending = event;
+		hasPending = true;
+	}
+
+	/** dispatch the pending event, if any */
+	template<typename Proc>
+	void flush (Proc&& dispatch)
+	{
+		if (!hasPending)
+			return;
+		hasPending = false;
+		dispatch (pending, static_cast<const MotionHistory&> (history));
+		history.clear ();
+	}
+
+	bool hasPendingEvent () const { return hasPending; }
+
+private:
+	MotionEvent pending {};
+	MotionHistory history;
+	bool hasPending {false};
+};
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
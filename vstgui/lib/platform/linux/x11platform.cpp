@@ -119,6 +119,7 @@ struct RunLoop::Impl : IEventHandler
 	xkb_state* xkbUnprocessedState {nullptr};
 	xkb_keymap* xkbKeymap {nullptr};
 	WindowEventHandlerMap windowEventHandlerMap;
+	MotionEventCoalescer<xcb_motion_notify_event_t> motionEventCoalescer;
 	std::array<xcb_cursor_t, CCursorType::kCursorIBeam + 1> cursors {{XCB_CURSOR_NONE}};
 	KeyboardEvent lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar {0};
@@ -225,6 +226,14 @@ struct RunLoop::Impl : IEventHandler
 		}
 	}
 
+	//------------------------------------------------------------------------
+	void dispatchMotionEvent (xcb_motion_notify_event_t& event, const MotionHistory& history)
+	{
+		auto it = windowEventHandlerMap.find (event.event);
+		if (it != windowEventHandlerMap.end ())
+			it->second->onEvent (event, history);
+	}
+
 	//------------------------------------------------------------------------
 	void onKeyEvent (const xcb_key_press_event_t& event, bool isKeyDown)
 	{
@@ -273,9 +282,17 @@ struct RunLoop::Impl : IEventHandler
 
 	void onEvent () override
 	{
+		auto dispatchMotion = [this] (xcb_motion_notify_event_t& event,
+									  const MotionHistory& history) {
+			dispatchMotionEvent (event, history);
+		};
 		while (auto event = xcb_poll_for_event (xcbConnection))
 		{
 			auto type = event->response_type & ~0x80;
+			// consecutive motion events are coalesced, any other event must see the last motion
+			// first to keep the order
+			if (type != XCB_MOTION_NOTIFY)
+				motionEventCoalescer.flush (dispatchMotion);
 			switch (type)
 			{
 				case XCB_KEY_PRESS:
@@ -307,7 +324,7 @@ struct RunLoop::Impl : IEventHandler
 				case XCB_MOTION_NOTIFY:
 				{
 					auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
+					motionEventCoalescer.add (*ev, dispatchMotion);
 					break;
 				}
 				case XCB_ENTER_NOTIFY:
@@ -372,6 +389,7 @@ struct RunLoop::Impl : IEventHandler
 			}
 			std::free (event);
 		}
+		motionEventCoalescer.flush (dispatchMotion);
 		xcb_aux_sync (xcbConnection);
 		xcb_flush (xcbConnection);
 	}
@@ -6,6 +6,7 @@
 
 #include "../../vstguifwd.h"
 #include "x11frame.h"
+#include "x11motioncoalescer.h"
 #include <atomic>
 #include <memory>
 
@@ -37,7 +38,8 @@ struct IFrameEventHandler
 	virtual void onEvent (xcb_map_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_key_press_event_t& event) = 0;
 	virtual void onEvent (xcb_button_press_event_t& event) = 0;
-	virtual void onEvent (xcb_motion_notify_event_t& event) = 0;
+	/** history contains the positions of the coalesced motion events before this one */
+	virtual void onEvent (xcb_motion_notify_event_t& event, const MotionHistory& history) = 0;
 	virtual void onEvent (xcb_enter_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_focus_in_event_t& event) = 0;
 	virtual void onEvent (xcb_expose_event_t& event) = 0;
@@ -31,6 +31,18 @@ static xcb_visualtype_t* getVisualType (const xcb_screen_t* screen)
 //------------------------------------------------------------------------
 } // anonymous
 
+//------------------------------------------------------------------------
+uint32_t ChildWindow::getEventMask ()
+{
+	// no XCB_EVENT_MASK_POINTER_MOTION_HINT: the server must deliver every motion event, bursts of
+	// them are coalesced by the run loop
+	return XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE | XCB_EVENT_MASK_BUTTON_PRESS |
+		   XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_ENTER_WINDOW |
+		   XCB_EVENT_MASK_LEAVE_WINDOW | XCB_EVENT_MASK_POINTER_MOTION |
+		   XCB_EVENT_MASK_BUTTON_MOTION | XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_PROPERTY_CHANGE |
+		   XCB_EVENT_MASK_FOCUS_CHANGE;
+}
+
 //------------------------------------------------------------------------
 ChildWindow::ChildWindow (::Window parentId, CPoint size)
 	: size (size), id (xcb_generate_id (RunLoop::instance ().getXcbConnection ()))
@@ -48,12 +60,7 @@ ChildWindow::ChildWindow (::Window parentId, CPoint size)
 	xcb_params_cw_t params{};
 	params.back_pixel = XCB_BACK_PIXMAP_NONE;
 	params.backing_store = XCB_BACKING_STORE_WHEN_MAPPED;
-	params.event_mask =
-		XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE | XCB_EVENT_MASK_BUTTON_PRESS |
-		XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_ENTER_WINDOW | XCB_EVENT_MASK_LEAVE_WINDOW |
-		XCB_EVENT_MASK_POINTER_MOTION | XCB_EVENT_MASK_POINTER_MOTION_HINT |
-		XCB_EVENT_MASK_BUTTON_MOTION | XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_PROPERTY_CHANGE |
-		XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_FOCUS_CHANGE;
+	params.event_mask = getEventMask ();
 
 	xcb_aux_create_window (connection, XCB_COPY_FROM_PARENT, getID (), parentId, 0, 0, size.x,
 						   size.y, 0, XCB_WINDOW_CLASS_INPUT_OUTPUT, XCB_COPY_FROM_PARENT,
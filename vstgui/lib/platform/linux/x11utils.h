@@ -31,6 +31,9 @@ struct ChildWindow
 
 	const CPoint& getSize () const;
 
+	/** the events the window receives */
+	static uint32_t getEventMask ();
+
 private:
 	xcb_window_t id;
 	CPoint size;
@@ -0,0 +1,241 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "x11viewlayer.h"
+#include "cairocontext.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace X11 {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+uint64_t nextViewLayerSerial ()
+{
+	static std::atomic<uint64_t> serial {0};
+	return ++serial;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+ViewLayer::ViewLayer (IPlatformViewLayerDelegate* drawDelegate, ViewLayer* parentLayer,
+					  IViewLayerHost* host, double scaleFactor)
+: drawDelegate (drawDelegate)
+, parent (parentLayer)
+, host (host)
+, scaleFactor (scaleFactor)
+, serial (nextViewLayerSerial ())
+{
+}
+
+//------------------------------------------------------------------------
+ViewLayer::~ViewLayer () noexcept
+{
+	if (host)
+	{
+		invalidComposition ();
+		host->unregisterViewLayer (this);
+	}
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidRect (const CRect& rect)
+{
+	CRect r (rect);
+	r.bound (CRect (0, 0, size.getWidth (), size.getHeight ()));
+	if (r.isEmpty ())
+		return;
+	dirtyRects.add (r);
+	if (host)
+	{
+		r.offset (getGlobalOffset ());
+		host->invalidViewLayerComposition (r);
+	}
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setSize (const CRect& newSize)
+{
+	CRect r (newSize);
+	r.makeIntegral ();
+	if (r == size)
+		return;
+	invalidComposition ();
+	if (r.getWidth () != size.getWidth () || r.getHeight () != size.getHeight ())
+	{
+		surface.reset ();
+		drawContext = nullptr;
+		dirtyRects.clear ();
+		dirtyRects.add (CRect (0, 0, r.getWidth (), r.getHeight ()));
+	}
+	size = r;
+	invalidComposition ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setZIndex (uint32_t newZIndex)
+{
+	if (zIndex == newZIndex)
+		return;
+	zIndex = newZIndex;
+	if (host)
+		host->viewLayerOrderChanged ();
+	invalidComposition ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::setAlpha (float newAlpha)
+{
+	if (alpha == newAlpha)
+		return;
+	alpha = newAlpha;
+	invalidComposition ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::draw (CDrawContext* context, const CRect& updateRect)
+{
+	// the layer is composited by the frame after the back buffer was drawn
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::onScaleFactorChanged (double newScaleFactor)
+{
+	if (scaleFactor == newScaleFactor)
+		return;
+	scaleFactor = newScaleFactor;
+	surface.reset ();
+	drawContext = nullptr;
+	dirtyRects.clear ();
+	dirtyRects.add (CRect (0, 0, size.getWidth (), size.getHeight ()));
+	invalidComposition ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::drawInvalidRects (CInvalidRectList& damage)
+{
+	if (dirtyRects.data ().empty ())
+		return;
+	auto width = static_cast<int> (std::ceil (size.getWidth () * scaleFactor));
+	auto height = static_cast<int> (std::ceil (size.getHeight () * scaleFactor));
+	if (width <= 0 || height <= 0)
+	{
+		dirtyRects.clear ();
+		return;
+	}
+	if (!surface)
+	{
+		surface.assign (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+		{
+			surface.reset ();
+			dirtyRects.clear ();
+			return;
+		}
+		cairo_surface_set_device_scale (surface, scaleFactor, scaleFactor);
+		drawContext =
+			makeOwned<Cairo::Context> (CRect (0, 0, size.getWidth (), size.getHeight ()), surface);
+	}
+	auto offset = getGlobalOffset ();
+	drawContext->beginDraw ();
+	for (auto rect : dirtyRects)
+	{
+		drawContext->setClipRect (rect);
+		drawContext->clearRect (rect);
+		drawContext->saveGlobalState ();
+		drawDelegate->drawViewLayer (drawContext, rect);
+		drawContext->restoreGlobalState ();
+		rect.offset (offset);
+		damage.add (rect);
+	}
+	drawContext->endDraw ();
+	dirtyRects.clear ();
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::composite (cairo_t* context, const CRect& rect) const
+{
+	if (!surface)
+		return;
+	auto globalAlpha = getGlobalAlpha ();
+	if (globalAlpha <= 0.f)
+		return;
+	auto r = getGlobalRect ();
+	r.bound (rect);
+	if (r.isEmpty ())
+		return;
+	auto offset = getGlobalOffset ();
+	cairo_save (context);
+	cairo_rectangle (context, r.left, r.top, r.getWidth (), r.getHeight ());
+	cairo_clip (context);
+	cairo_set_source_surface (context, surface, offset.x, offset.y);
+	if (globalAlpha < 1.f)
+		cairo_paint_with_alpha (context, globalAlpha);
+	else
+		cairo_paint (context);
+	cairo_restore (context);
+}
+
+//------------------------------------------------------------------------
+CPoint ViewLayer::getGlobalOffset () const
+{
+	auto offset = size.getTopLeft ();
+	if (parent)
+		offset += parent->getGlobalOffset ();
+	return offset;
+}
+
+//------------------------------------------------------------------------
+CRect ViewLayer::getGlobalRect () const
+{
+	CRect r (0, 0, size.getWidth (), size.getHeight ());
+	r.offset (getGlobalOffset ());
+	return r;
+}
+
+//------------------------------------------------------------------------
+float ViewLayer::getGlobalAlpha () const
+{
+	return parent ? parent->getGlobalAlpha () * alpha : alpha;
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::invalidComposition ()
+{
+	if (!host)
+		return;
+	auto r = getGlobalRect ();
+	if (!r.isEmpty ())
+		host->invalidViewLayerComposition (r);
+}
+
+//------------------------------------------------------------------------
+void ViewLayer::collectOrderPath (OrderPath& path) const
+{
+	if (parent)
+		parent->collectOrderPath (path);
+	path.emplace_back (zIndex, serial);
+}
+
+//------------------------------------------------------------------------
+bool ViewLayer::compositeOrderLess (const ViewLayer* lhs, const ViewLayer* rhs)
+{
+	OrderPath lhsPath;
+	OrderPath rhsPath;
+	lhs->collectOrderPath (lhsPath);
+	rhs->collectOrderPath (rhsPath);
+	return std::lexicographical_compare (lhsPath.begin (), lhsPath.end (), rhsPath.begin (),
+										 rhsPath.end ());
+}
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
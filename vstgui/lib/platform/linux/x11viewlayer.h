@@ -0,0 +1,91 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformviewlayer.h"
+#include "../../cinvalidrectlist.h"
+#include "../../crect.h"
+#include "cairoutils.h"
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Cairo {
+class Context;
+} // Cairo
+
+namespace X11 {
+
+class ViewLayer;
+
+//------------------------------------------------------------------------
+class IViewLayerHost
+{
+public:
+	virtual ~IViewLayerHost () noexcept = default;
+
+	/** rect is in frame coordinates */
+	virtual void invalidViewLayerComposition (const CRect& rect) = 0;
+	virtual void viewLayerOrderChanged () = 0;
+	virtual void unregisterViewLayer (ViewLayer* layer) = 0;
+};
+
+//------------------------------------------------------------------------
+/** Software view layer
+ *
+ *	The content of the layer is cached in a cairo image surface and only redrawn when the layer
+ *	was invalidated. The frame composites all layers in z-order on top of its back buffer.
+ */
+class ViewLayer : public IPlatformViewLayer
+{
+public:
+	ViewLayer (IPlatformViewLayerDelegate* drawDelegate, ViewLayer* parentLayer,
+			   IViewLayerHost* host, double scaleFactor);
+	~ViewLayer () noexcept override;
+
+	void invalidRect (const CRect& size) override;
+	void setSize (const CRect& size) override;
+	void setZIndex (uint32_t zIndex) override;
+	void setAlpha (float alpha) override;
+	void draw (CDrawContext* context, const CRect& updateRect) override;
+	void onScaleFactorChanged (double newScaleFactor) override;
+
+	/** redraws the invalid parts of the cached surface and adds them in frame coordinates to
+	 *	damage */
+	void drawInvalidRects (CInvalidRectList& damage);
+	/** paints the cached surface onto context, rect is in frame coordinates */
+	void composite (cairo_t* context, const CRect& rect) const;
+
+	CRect getGlobalRect () const;
+	CPoint getGlobalOffset () const;
+	float getGlobalAlpha () const;
+
+	void detachFromHost () { host = nullptr; }
+
+	/** compositing order: parents before children, siblings sorted by z-index */
+	static bool compositeOrderLess (const ViewLayer* lhs, const ViewLayer* rhs);
+
+private:
+	using OrderPath = std::vector<std::pair<uint32_t, uint64_t>>;
+
+	void invalidComposition ();
+	void collectOrderPath (OrderPath& path) const;
+
+	IPlatformViewLayerDelegate* drawDelegate;
+	SharedPointer<ViewLayer> parent;
+	IViewLayerHost* host;
+	Cairo::SurfaceHandle surface;
+	SharedPointer<Cairo::Context> drawContext;
+	CInvalidRectList dirtyRects;
+	CRect size;
+	double scaleFactor;
+	float alpha {1.f};
+	uint32_t zIndex {0};
+	uint64_t serial;
+};
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
@@ -11,6 +11,7 @@
 #include "quartzgraphicspath.h"
 #include "cfontmac.h"
 #include "../../cbitmap.h"
+#include "../../cdrawprofiler.h"
 #include "../../cgradient.h"
 
 #ifndef CGFLOAT_DEFINED
@@ -666,6 +667,7 @@ void CGDrawContext::drawBitmap (CBitmap* bitmap, const CRect& inRect, const CPoi
 {
 	if (bitmap == nullptr || alpha == 0.f)
 		return;
+	CDrawProfiler::Scope profilerScope (getDrawProfiler (), CDrawProfiler::Category::Bitmap);
 	double transformedScaleFactor = scaleFactor;
 	CGraphicsTransform t = getCurrentTransform ();
 	if (t.m11 == t.m22 && t.m12 == 0 && t.m21 == 0)
@@ -40,6 +40,11 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** number of worker threads used to draw large dirty regions in tiles. Only views marked
+	 *	via CView::setThreadSafeDrawing are drawn on the worker threads. 0 disables the tiled
+	 *	drawing.
+	 */
+	uint32_t numDrawThreads {0};
 };
 
 //------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include "../win32support.h"
 #include "../win32factory.h"
+#include "../../../cdrawprofiler.h"
 #include "../../../cgradient.h"
 #include "d2dbitmap.h"
 #include "d2dgraphicspath.h"
@@ -412,6 +413,7 @@ void D2DDrawContext::drawBitmap (CBitmap* bitmap, const CRect& dest, const CPoin
 {
 	if (renderTarget == nullptr)
 		return;
+	CDrawProfiler::Scope profilerScope (getDrawProfiler (), CDrawProfiler::Category::Bitmap);
 	ConcatClip concatClip (*this, dest);
 	D2DApplyClip ac (this);
 	if (ac.isEmpty ())
@@ -104,6 +104,18 @@ enum class BitmapInterpolationQuality
 	kHigh			///< Bicubic interpolation (Bilinear on Windows)
 };
 
+//----------------------------
+// @brief Antialiasing Quality
+/// @ingroup new_in_4_11
+//----------------------------
+enum class AntialiasQuality
+{
+	kDefault = 0,	///< Let system decide
+	kFast,			///< Prefer speed over quality
+	kGood,			///< Balance between speed and quality
+	kBest			///< Prefer quality over speed
+};
+
 //-----------------------------------------------------------------------------
 enum class CSliderMode
 {
@@ -136,6 +148,7 @@ struct DragEventData;
 struct ModalViewSession;
 struct CListControlRowDesc;
 struct CNinePartTiledDescription;
+struct CMultiFrameBitmapDescription;
 
 using GradientColorStop = std::pair<double, CColor>;
 using GradientColorStopMap = std::multimap<double, CColor>;
@@ -175,9 +188,12 @@ class ITouchEvent;
 // classes
 class CBitmap;
 class CNinePartTiledBitmap;
+class CMultiFrameBitmap;
+class CBitmapCache;
 class CResourceDescription;
 class CLineStyle;
 class CDrawContext;
+class CDrawProfiler;
 class COffscreenContext;
 class CDropSource;
 class CFileExtension;
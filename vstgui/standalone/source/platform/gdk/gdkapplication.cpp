@@ -121,7 +121,10 @@ bool Application::init (int argc, char* argv[])
 //------------------------------------------------------------------------
 int Application::run ()
 {
-	return app->run ();
+	auto result = app->run ();
+	// write the pending preference changes while the timers are still available
+	prefs.flush ();
+	return result;
 }
 
 //------------------------------------------------------------------------
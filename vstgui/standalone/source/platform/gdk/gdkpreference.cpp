@@ -5,6 +5,7 @@
 #include "gdkpreference.h"
 #include "../../../include/iapplication.h"
 #include "../../../include/icommondirectories.h"
+#include "../../../../lib/cvstguitimer.h"
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -22,9 +23,35 @@ CREATE TABLE IF NOT EXISTS "store" (
 )__";
 
 //------------------------------------------------------------------------
-constexpr auto GetValueSQL = R"__(SELECT "value" FROM "store" WHERE "key" IS )__";
-constexpr auto SetValueSQL = R"__(INSERT INTO "store" VALUES )__";
-constexpr auto DeleteValueSQL = R"__(DELETE FROM "store" WHERE key=)__";
+constexpr auto GetValueSQL = R"__(SELECT "value" FROM "store" WHERE "key" = ?1)__";
+constexpr auto SetValueSQL = R"__(INSERT OR REPLACE INTO "store" ("key", "value") VALUES (?1, ?2))__";
+constexpr auto BeginTransactionSQL = "BEGIN TRANSACTION";
+constexpr auto CommitTransactionSQL = "COMMIT TRANSACTION";
+constexpr auto RollbackTransactionSQL = "ROLLBACK TRANSACTION";
+
+//------------------------------------------------------------------------
+constexpr auto FlushDelayMilliseconds = 500u;
+
+//------------------------------------------------------------------------
+bool execute (sqlite3* db, const char* sql)
+{
+	char* errorMsg = nullptr;
+	sqlite3_exec (db, sql, nullptr, nullptr, &errorMsg);
+	if (errorMsg)
+	{
+		printf ("%s\n", errorMsg);
+		sqlite3_free (errorMsg);
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool bindText (sqlite3_stmt* statement, int index, const std::string& text)
+{
+	return sqlite3_bind_text (statement, index, text.data (), static_cast<int> (text.size ()),
+	                          SQLITE_STATIC) == SQLITE_OK;
+}
 
 //------------------------------------------------------------------------
 } // anonymous
@@ -35,6 +62,12 @@ Preference::Preference () {}
 //------------------------------------------------------------------------
 Preference::~Preference () noexcept
 {
+	flush ();
+	flushTimer = nullptr;
+	if (getStatement)
+		sqlite3_finalize (getStatement);
+	if (setStatement)
+		sqlite3_finalize (setStatement);
 	if (db)
 		sqlite3_close (db);
 }
@@ -44,66 +77,105 @@ bool Preference::set (const UTF8String& key, const UTF8String& value)
 {
 	if (!prepare ())
 		return false;
-	if (get (key))
+	// a key which is not cached may still be stored in the database, so it is always written
+	auto it = cache.find (key.getString ());
+	if (it != cache.end () && it->second == value.getString ())
+		return true;
+	cache[key.getString ()] = value.getString ();
+	pendingWrites[key.getString ()] = value.getString ();
+	scheduleFlush ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+Optional<UTF8String> Preference::get (const UTF8String& key)
+{
+	auto it = cache.find (key.getString ());
+	if (it == cache.end ())
+	{
+		if (!prepare ())
+			return {};
+		std::string value;
+		if (bindText (getStatement, 1, key.getString ()))
+		{
+			auto res = sqlite3_step (getStatement);
+			if (res == SQLITE_ROW)
+			{
+				if (auto text = sqlite3_column_text (getStatement, 0))
+					value = reinterpret_cast<const char*> (text);
+			}
+			else if (res != SQLITE_DONE)
+				printf ("%s\n", sqlite3_errmsg (db));
+		}
+		sqlite3_reset (getStatement);
+		sqlite3_clear_bindings (getStatement);
+		it = cache.emplace (key.getString (), std::move (value)).first;
+	}
+	if (it->second.empty ())
+		return {};
+	return Optional<UTF8String> (UTF8String (it->second));
+}
+
+//------------------------------------------------------------------------
+bool Preference::flush ()
+{
+	if (flushTimer)
+	{
+		flushTimer->stop ();
+		flushTimer = nullptr;
+	}
+	if (pendingWrites.empty ())
+		return true;
+	if (!prepare () || !execute (db, BeginTransactionSQL))
+		return false;
+	for (const auto& entry : pendingWrites)
 	{
-		char* errorMsg = nullptr;
-		std::string sql = DeleteValueSQL;
-		sql += "\"" + key + "\"";
-		sqlite3_exec (db, sql.data (), nullptr, nullptr, &errorMsg);
-		if (errorMsg)
+		auto res = bindText (setStatement, 1, entry.first) &&
+		           bindText (setStatement, 2, entry.second) &&
+		           sqlite3_step (setStatement) == SQLITE_DONE;
+		sqlite3_reset (setStatement);
+		sqlite3_clear_bindings (setStatement);
+		if (!res)
 		{
-			printf ("%s\n", errorMsg);
-			sqlite3_free (errorMsg);
+			printf ("%s\n", sqlite3_errmsg (db));
+			execute (db, RollbackTransactionSQL);
 			return false;
 		}
 	}
-	char* errorMsg = nullptr;
-	std::string sql = SetValueSQL;
-	sql += "(\"" + key + "\",\"" + value + "\")";
-	sqlite3_exec (db, sql.data (), nullptr, nullptr, &errorMsg);
-	if (errorMsg)
+	if (!execute (db, CommitTransactionSQL))
 	{
-		printf ("%s\n", errorMsg);
-		sqlite3_free (errorMsg);
+		execute (db, RollbackTransactionSQL);
 		return false;
 	}
-
+	pendingWrites.clear ();
 	return true;
 }
 
 //------------------------------------------------------------------------
-Optional<UTF8String> Preference::get (const UTF8String& key)
+void Preference::scheduleFlush ()
 {
-	if (!prepare ())
-		return {};
-	std::string sql = GetValueSQL;
-	sql += "\"" + key + "\"";
-	UTF8String result;
-	char* errorMsg = nullptr;
-	sqlite3_exec (db, sql.data (),
-				  [](void* userData, int numColumns, char** cols, char** colNames) -> int {
-					  auto result = reinterpret_cast<UTF8String*> (userData);
-					  if (numColumns > 0)
-						  *result = cols[0];
-					  return 0;
-				  },
-				  &result, &errorMsg);
-	if (errorMsg)
+	if (flushTimer)
+		return;
+	flushTimer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { flush (); },
+	                                       FlushDelayMilliseconds);
+}
+
+//------------------------------------------------------------------------
+bool Preference::prepareStatement (const char* sql, sqlite3_stmt*& statement)
+{
+	if (sqlite3_prepare_v2 (db, sql, -1, &statement, nullptr) != SQLITE_OK)
 	{
-		printf ("%s\n", errorMsg);
-		sqlite3_free (errorMsg);
-		return {};
+		printf ("%s\n", sqlite3_errmsg (db));
+		return false;
 	}
-	if (result.empty ())
-		return {};
-	return Optional<UTF8String> (std::move (result));
+	return true;
 }
 
 //------------------------------------------------------------------------
 bool Preference::prepare ()
 {
 	if (db)
-		return true;
+		return getStatement && setStatement;
 	auto prefPath = IApplication::instance ().getCommonDirectories ().get (
 		CommonDirectoryLocation::AppPreferencesPath, "", true);
 	if (!prefPath)
@@ -111,15 +183,9 @@ bool Preference::prepare ()
 	*prefPath += "preferences.db";
 	if (sqlite3_open (prefPath->data (), &db) != 0)
 		return false;
-	char* errorMsg = nullptr;
-	sqlite3_exec (db, CreateTableSQL, [](void*, int, char**, char**) -> int { return 0; }, nullptr,
-				  &errorMsg);
-	if (errorMsg)
-	{
-		printf ("%s\n", errorMsg);
-		sqlite3_free (errorMsg);
-	}
-	return true;
+	execute (db, CreateTableSQL);
+	return prepareStatement (GetValueSQL, getStatement) &&
+	       prepareStatement (SetValueSQL, setStatement);
 }
 
 //------------------------------------------------------------------------
@@ -5,7 +5,10 @@
 #pragma once
 
 #include "../../../include/ipreference.h"
+#include "../../../../lib/vstguifwd.h"
 #include <sqlite3.h>
+#include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -14,6 +17,12 @@ namespace Platform {
 namespace GDK {
 
 //------------------------------------------------------------------------
+/** Preferences stored in a sqlite database
+ *
+ *	Values are cached in memory. Changed values are written in a single transaction a short
+ *	time after the first pending change or when flush is called. Further changes do not delay
+ *	the write, so a continuous stream of changes is still written regularly.
+ */
 class Preference : public IPreference
 {
 public:
@@ -23,10 +32,23 @@ public:
 	bool set (const UTF8String& key, const UTF8String& value) override;
 	Optional<UTF8String> get (const UTF8String& key) override;
 
+	/** write all pending changes to the database */
+	bool flush ();
+
 private:
 	bool prepare ();
-
-	sqlite3* db{nullptr};
+	bool prepareStatement (const char* sql, sqlite3_stmt*& statement);
+	void scheduleFlush ();
+
+	using ValueMap = std::unordered_map<std::string, std::string>;
+
+	sqlite3* db {nullptr};
+	sqlite3_stmt* getStatement {nullptr};
+	sqlite3_stmt* setStatement {nullptr};
+	/** values read from or written to the database, an empty value marks a missing key */
+	ValueMap cache;
+	ValueMap pendingWrites;
+	SharedPointer<CVSTGUITimer> flushTimer;
 };
 
 //------------------------------------------------------------------------
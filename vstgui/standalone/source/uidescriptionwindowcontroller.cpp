@@ -32,6 +32,9 @@
 #include "../include/iuidescwindow.h"
 #include "application.h"
 #include "shareduiresources.h"
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -72,6 +75,25 @@ private:
 	std::unique_ptr<Impl> impl;
 };
 
+class ValueWrapper;
+
+//------------------------------------------------------------------------
+/** Collects the value wrappers whose controls need to be redrawn.
+ *
+ *	Many value changes in one run loop cycle result in one invalidation pass.
+ */
+class InvalidationBatch : public std::enable_shared_from_this<InvalidationBatch>
+{
+public:
+	void add (ValueWrapper* wrapper);
+	void remove (ValueWrapper* wrapper);
+	void flush ();
+
+private:
+	std::vector<ValueWrapper*> wrappers;
+	bool scheduled {false};
+};
+
 //------------------------------------------------------------------------
 class ValueWrapper : public ValueListenerAdapter,
                      public IControlListener,
@@ -80,13 +102,17 @@ class ValueWrapper : public ValueListenerAdapter,
 public:
 	using ControlList = std::vector<CControl*>;
 
-	explicit ValueWrapper (const ValuePtr& value = nullptr) : value (value)
+	explicit ValueWrapper (const ValuePtr& value = nullptr,
+	                       InvalidationBatch* invalidationBatch = nullptr)
+	: value (value), invalidationBatch (invalidationBatch)
 	{
 		if (value)
 			value->registerListener (this);
 	}
 	~ValueWrapper () noexcept override
 	{
+		if (invalidationBatch && invalidationPending)
+			invalidationBatch->remove (this);
 		if (value)
 			value->unregisterListener (this);
 		for (auto& control : controls)
@@ -121,9 +147,22 @@ public:
 			updateControl = c;
 			c->setValueNormalized (newControlValue);
 			c->valueChanged ();
-			c->invalid ();
+			if (!invalidationBatch)
+				c->invalid ();
 			updateControl = nullptr;
 		}
+		if (invalidationBatch && !invalidationPending && !controls.empty ())
+		{
+			invalidationPending = true;
+			invalidationBatch->add (this);
+		}
+	}
+
+	void invalidControls ()
+	{
+		invalidationPending = false;
+		for (auto& c : controls)
+			c->invalid ();
 	}
 
 	void updateControlOnStateChange (CControl* control) const
@@ -267,10 +306,41 @@ protected:
 	ValuePtr value;
 	ControlList controls;
 	CControl* updateControl {nullptr};
+	InvalidationBatch* invalidationBatch {nullptr};
+	bool invalidationPending {false};
 };
 
 using ValueWrapperPtr = std::unique_ptr<ValueWrapper>;
 
+//------------------------------------------------------------------------
+void InvalidationBatch::add (ValueWrapper* wrapper)
+{
+	wrappers.emplace_back (wrapper);
+	if (scheduled)
+		return;
+	scheduled = true;
+	Async::schedule (Async::mainQueue (), [weakThis = weak_from_this ()] () {
+		if (auto self = weakThis.lock ())
+			self->flush ();
+	});
+}
+
+//------------------------------------------------------------------------
+void InvalidationBatch::remove (ValueWrapper* wrapper)
+{
+	wrappers.erase (std::remove (wrappers.begin (), wrappers.end (), wrapper), wrappers.end ());
+}
+
+//------------------------------------------------------------------------
+void InvalidationBatch::flush ()
+{
+	scheduled = false;
+	auto pending = std::move (wrappers);
+	wrappers.clear ();
+	for (auto wrapper : pending)
+		wrapper->invalidControls ();
+}
+
 //------------------------------------------------------------------------
 struct WindowController::Impl : public IController, public ICommandHandler
 {
@@ -590,12 +660,26 @@ struct WindowController::Impl : public IController, public ICommandHandler
 		if (!modelHandler)
 			return;
 		valueWrappers.reserve (modelHandler->getValues ().size ());
+		valueIndices.reserve (modelHandler->getValues ().size ());
 		for (auto& value : modelHandler->getValues ())
 		{
-			valueWrappers.emplace_back (std::make_unique<ValueWrapper> (value));
+			valueIndices.emplace (value->getID ().getString (),
+			                      static_cast<int32_t> (valueWrappers.size ()));
+			valueWrappers.emplace_back (
+			    std::make_unique<ValueWrapper> (value, invalidationBatch.get ()));
 		}
 	}
 
+	ValueWrapper* getValueWrapper (CControl* control) const
+	{
+		if (control->getTag () < 0)
+			return nullptr;
+		auto index = static_cast<ValueWrapperList::size_type> (control->getTag ());
+		if (index < valueWrappers.size ())
+			return valueWrappers[index].get ();
+		return nullptr;
+	}
+
 	// IController
 	void valueChanged (CControl* control) override {}
 	int32_t controlModifierClicked (CControl* control, CButtonState button) override { return 0; }
@@ -603,27 +687,20 @@ struct WindowController::Impl : public IController, public ICommandHandler
 	void controlEndEdit (CControl* control) override {}
 	void controlTagWillChange (CControl* control) override
 	{
-		if (control->getTag () < 0)
-			return;
-		auto index = static_cast<ValueWrapperList::size_type> (control->getTag ());
-		if (index < valueWrappers.size ())
-			valueWrappers[index]->removeControl (control);
+		if (auto valueWrapper = getValueWrapper (control))
+			valueWrapper->removeControl (control);
 	}
 	void controlTagDidChange (CControl* control) override
 	{
-		if (control->getTag () < 0)
-			return;
-		auto index = static_cast<ValueWrapperList::size_type> (control->getTag ());
-		if (index < valueWrappers.size ())
-			valueWrappers[index]->addControl (control);
+		if (auto valueWrapper = getValueWrapper (control))
+			valueWrapper->addControl (control);
 	}
 
 	int32_t getTagForName (UTF8StringPtr name, int32_t registeredTag) const override
 	{
-		if (auto index =
-		        indexOfTest (valueWrappers.begin (), valueWrappers.end (),
-		                     [&] (const ValueWrapperPtr& v) { return v->getID () == name; }))
-			return *index;
+		auto it = valueIndices.find (name);
+		if (it != valueIndices.end ())
+			return it->second;
 		return registeredTag;
 	}
 
@@ -640,11 +717,8 @@ struct WindowController::Impl : public IController, public ICommandHandler
 		{
 			if (control->getListener () == nullptr)
 				control->setListener (this);
-			auto index = static_cast<ValueWrapperList::size_type> (control->getTag ());
-			if (index < valueWrappers.size ())
-			{
-				valueWrappers[index]->updateControlOnStateChange (control);
-			}
+			if (auto valueWrapper = getValueWrapper (control))
+				valueWrapper->updateControlOnStateChange (control);
 		}
 		return view;
 	}
@@ -665,7 +739,9 @@ struct WindowController::Impl : public IController, public ICommandHandler
 	CPoint maxSize;
 	ModelBindingPtr modelBinding;
 	CustomizationPtr customization;
+	std::shared_ptr<InvalidationBatch> invalidationBatch {std::make_shared<InvalidationBatch> ()};
 	ValueWrapperList valueWrappers;
+	std::unordered_map<std::string, int32_t> valueIndices;
 };
 
 #if VSTGUI_LIVE_EDITING
@@ -807,23 +883,21 @@ struct WindowController::EditImpl : WindowController::Impl
 	{
 		std::list<const std::string*> tagNames;
 		uiDesc->collectControlTagNames (tagNames);
+		std::unordered_set<std::string> existingTagNames;
+		existingTagNames.reserve (tagNames.size ());
+		for (auto& name : tagNames)
+			existingTagNames.emplace (*name);
 		int32_t index = 0;
 		for (auto& v : valueWrappers)
 		{
-			auto it = std::find_if (tagNames.begin (), tagNames.end (),
-			                        [&] (const std::string* name) { return v->getID () == *name; });
-			auto create = it == tagNames.end ();
+			auto create = existingTagNames.find (v->getID ().getString ()) == existingTagNames.end ();
 			uiDesc->changeControlTagString (v->getID (), std::to_string (index), create);
 			++index;
 		}
 		// now remove all old tags
 		for (auto& name : tagNames)
 		{
-			auto it = std::find_if (valueWrappers.begin (), valueWrappers.end (),
-			                        [&] (const ValueWrapperList::value_type& value) {
-				                        return value->getID () == *name;
-			                        });
-			if (it == valueWrappers.end ())
+			if (valueIndices.find (*name) == valueIndices.end ())
 				uiDesc->removeTag (name->data ());
 		}
 	}
@@ -0,0 +1,128 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Benchmark {
+
+//------------------------------------------------------------------------
+/** State of one benchmark run
+ *
+ *	Only the code inside the keepRunning loop is measured, everything before it is setup:
+ *	@code
+ *	BENCHMARK (Suite, Name)
+ *	{
+ *		auto data = createData ();
+ *		while (state.keepRunning ())
+ *			process (data);
+ *	}
+ *	@endcode
+ */
+class State
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit State (uint64_t iterations) : iterations (iterations) {}
+
+	bool keepRunning ()
+	{
+		if (current == 0)
+			start = Clock::now ();
+		if (current == iterations)
+		{
+			end = Clock::now ();
+			finished = true;
+			return false;
+		}
+		++current;
+		return true;
+	}
+
+	/** number of items processed per iteration, reported as items per second */
+	void setItemsPerIteration (uint64_t items) { itemsPerIteration = items; }
+	/** memory used per item, reported as bytes per item, see getAllocatedBytes () */
+	void setBytesPerItem (double bytes) { bytesPerItem = bytes; }
+
+	/** false if the benchmark returned without running the loop */
+	bool isFinished () const { return finished; }
+	uint64_t getIterations () const { return iterations; }
+	uint64_t getItemsPerIteration () const { return itemsPerIteration; }
+	double getBytesPerItem () const { return bytesPerItem; }
+	Clock::duration getElapsed () const { return end - start; }
+
+private:
+	uint64_t iterations;
+	uint64_t current {0};
+	uint64_t itemsPerIteration {0};
+	double bytesPerItem {0.};
+	bool finished {false};
+	Clock::time_point start;
+	Clock::time_point end;
+};
+
+/** total number of bytes allocated with operator new since the start of the program */
+uint64_t getAllocatedBytes ();
+
+//------------------------------------------------------------------------
+using Function = std::function<void (State&)>;
+
+//------------------------------------------------------------------------
+struct Entry
+{
+	std::string suite;
+	std::string name;
+	Function function;
+};
+
+//------------------------------------------------------------------------
+class Registry
+{
+public:
+	using Entries = std::vector<Entry>;
+
+	static Registry& instance ()
+	{
+		static Registry gInstance;
+		return gInstance;
+	}
+
+	void add (Entry&& entry) { entries.emplace_back (std::move (entry)); }
+
+	Entries::const_iterator begin () const { return entries.begin (); }
+	Entries::const_iterator end () const { return entries.end (); }
+
+private:
+	Entries entries;
+};
+
+//------------------------------------------------------------------------
+struct Registrar
+{
+	Registrar (const char* suite, const char* name, Function&& function)
+	{
+		Registry::instance ().add ({suite, name, std::move (function)});
+	}
+};
+
+//------------------------------------------------------------------------
+} // Benchmark
+} // VSTGUI
+
+#define VSTGUI_BENCHMARK_NAME(suite, name) suite##name##Benchmark
+#define VSTGUI_BENCHMARK_REGISTRAR(suite, name) suite##name##BenchmarkRegistrar
+
+#define BENCHMARK(suite, name)                                                                     \
+	static void VSTGUI_BENCHMARK_NAME (suite, name) (VSTGUI::Benchmark::State & state);            \
+	static VSTGUI::Benchmark::Registrar VSTGUI_BENCHMARK_REGISTRAR (suite, name) (                 \
+		#suite, #name, VSTGUI_BENCHMARK_NAME (suite, name));                                       \
+	static void VSTGUI_BENCHMARK_NAME (suite, name) (VSTGUI::Benchmark::State & state)
@@ -0,0 +1,100 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmapfilter.h"
+#include "vstgui/lib/ccolor.h"
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createInputBitmap ()
+{
+	auto bitmap = makeOwned<CBitmap> (256., 256.);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		uint8_t value = 0;
+		do
+		{
+			accessor->setColor (CColor (value, 255 - value, value / 2, 200));
+			++value;
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+void runFilter (State& state, IdStringPtr name,
+				const std::function<void (BitmapFilter::IFilter&)>& setup = {})
+{
+	using namespace BitmapFilter;
+	auto input = createInputBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (name));
+	if (!filter)
+		return;
+	filter->setProperty (Standard::Property::kInputBitmap, input.get ());
+	if (setup)
+		setup (*filter);
+	state.setItemsPerIteration (256 * 256);
+	while (state.keepRunning ())
+		filter->run ();
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, BoxBlur)
+{
+	runFilter (state, BitmapFilter::Standard::kBoxBlur, [] (BitmapFilter::IFilter& filter) {
+		filter.setProperty (BitmapFilter::Standard::Property::kRadius, 8);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, Grayscale)
+{
+	runFilter (state, BitmapFilter::Standard::kGrayscale);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, ReplaceColor)
+{
+	runFilter (state, BitmapFilter::Standard::kReplaceColor, [] (BitmapFilter::IFilter& filter) {
+		filter.setProperty (BitmapFilter::Standard::Property::kInputColor, kRedCColor);
+		filter.setProperty (BitmapFilter::Standard::Property::kOutputColor, kBlueCColor);
+	});
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, FusedColorChain)
+{
+	using namespace BitmapFilter;
+	auto input = createInputBitmap ();
+	auto replaceColor = owned (Factory::getInstance ().createFilter (Standard::kReplaceColor));
+	auto grayscale = owned (Factory::getInstance ().createFilter (Standard::kGrayscale));
+	auto setColor = owned (Factory::getInstance ().createFilter (Standard::kSetColor));
+	if (!replaceColor || !grayscale || !setColor)
+		return;
+	replaceColor->setProperty (Standard::Property::kInputColor, kRedCColor);
+	replaceColor->setProperty (Standard::Property::kOutputColor, kBlueCColor);
+	setColor->setProperty (Standard::Property::kInputColor, kBlackCColor);
+	FilterList filters {replaceColor, grayscale, setColor};
+	state.setItemsPerIteration (256 * 256);
+	while (state.keepRunning ())
+		runFilters (input, filters);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (BitmapFilter, ScaleBilinear)
+{
+	runFilter (state, BitmapFilter::Standard::kScaleBilinear, [] (BitmapFilter::IFilter& filter) {
+		filter.setProperty (BitmapFilter::Standard::Property::kOutputRect, CRect (0, 0, 100, 300));
+	});
+}
+
+} // VSTGUI
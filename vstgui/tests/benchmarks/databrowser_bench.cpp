@@ -0,0 +1,135 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cdatabrowser.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/idatabrowserdelegate.h"
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter, public NonAtomicReferenceCounted
+{
+public:
+	explicit Delegate (int32_t numRows) : numRows (numRows) {}
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 4; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 18.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return 100.;
+	}
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1.;
+		color = kGreyCColor;
+		return true;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+					 int32_t flags, CDataBrowser* browser) override
+	{
+		context->setFillColor ((flags & kRowSelected) ? kBlueCColor : kWhiteCColor);
+		context->drawRect (size, kDrawFilled);
+	}
+
+private:
+	int32_t numRows;
+};
+
+constexpr int32_t kNumRows = 1000000;
+constexpr CCoord kWidth = 400.;
+constexpr CCoord kHeight = 300.;
+
+//------------------------------------------------------------------------
+SharedPointer<CDataBrowser> createBrowser (int32_t numRows)
+{
+	auto browser = makeOwned<CDataBrowser> (
+		CRect (0, 0, kWidth, kHeight), makeOwned<Delegate> (numRows),
+		CDataBrowser::kDrawRowLines | CDataBrowser::kDrawColumnLines |
+			CDataBrowser::kMultiSelectionStyle | CScrollView::kVerticalScrollbar);
+	browser->recalculateLayout (true);
+	return browser;
+}
+
+//------------------------------------------------------------------------
+void selectEveryOtherRow (CDataBrowser* browser, int32_t numRows)
+{
+	for (auto row = 0; row < numRows; row += 2)
+		browser->selectRow (row);
+}
+
+//------------------------------------------------------------------------
+void drawBrowser (State& state, CDataBrowser* browser)
+{
+	auto context = COffscreenContext::create ({kWidth, kHeight});
+	if (!context)
+		return;
+	while (state.keepRunning ())
+	{
+		context->beginDraw ();
+		browser->drawRect (context, browser->getViewSize ());
+		context->endDraw ();
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DataBrowser, Draw1MRowsAtTop)
+{
+	auto browser = createBrowser (kNumRows);
+	drawBrowser (state, browser);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DataBrowser, Draw1MRowsAtBottom)
+{
+	auto browser = createBrowser (kNumRows);
+	browser->makeRowVisible (kNumRows - 1);
+	drawBrowser (state, browser);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DataBrowser, Draw1MRowsWith500kSelected)
+{
+	auto browser = createBrowser (kNumRows);
+	selectEveryOtherRow (browser, kNumRows);
+	browser->makeRowVisible (kNumRows / 2);
+	drawBrowser (state, browser);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DataBrowser, Select100kRows)
+{
+	auto browser = createBrowser (kNumRows);
+	state.setItemsPerIteration (100000);
+	while (state.keepRunning ())
+	{
+		selectEveryOtherRow (browser, 200000);
+		browser->unselectAll ();
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DataBrowser, CellAtPoint)
+{
+	auto browser = createBrowser (kNumRows);
+	browser->makeRowVisible (kNumRows / 2);
+	state.setItemsPerIteration (100);
+	while (state.keepRunning ())
+	{
+		for (auto i = 0; i < 100; ++i)
+		{
+			auto cell = browser->getCellAt (CPoint (3. * i + 1., 2.5 * i + 1.));
+			if (!cell.isValid ())
+				return;
+		}
+	}
+}
+
+} // anonymous
+} // VSTGUI
@@ -0,0 +1,90 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cframe.h"
+#include <vector>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+// 30 groups of 10 rows with 10 views
+constexpr uint32_t kNumGroups = 30;
+constexpr uint32_t kNumRows = 10;
+constexpr uint32_t kNumColumns = 10;
+constexpr uint32_t kNumDirtyViews = 10;
+constexpr CCoord kCellSize = 10.;
+
+//------------------------------------------------------------------------
+struct Editor
+{
+	CFrame* frame {nullptr};
+	std::vector<CView*> views;
+
+	Editor ()
+	{
+		auto groupWidth = kCellSize * kNumColumns;
+		auto groupHeight = kCellSize * kNumRows;
+		frame = new CFrame (CRect (0, 0, groupWidth * kNumGroups, groupHeight), nullptr);
+		for (auto g = 0u; g < kNumGroups; ++g)
+		{
+			auto left = groupWidth * g;
+			auto group = new CViewContainer (CRect (left, 0, left + groupWidth, groupHeight));
+			for (auto r = 0u; r < kNumRows; ++r)
+			{
+				auto top = kCellSize * r;
+				auto row = new CViewContainer (CRect (0, top, groupWidth, top + kCellSize));
+				for (auto c = 0u; c < kNumColumns; ++c)
+				{
+					auto x = kCellSize * c;
+					auto view = new CView (CRect (x, 0, x + kCellSize, kCellSize));
+					row->addView (view);
+					views.emplace_back (view);
+				}
+				group->addView (row);
+			}
+			frame->addView (group);
+		}
+		frame->openHeadless ();
+	}
+
+	~Editor () { frame->close (); }
+};
+
+//------------------------------------------------------------------------
+void idleWithDirtyViews (State& state, bool eventDriven)
+{
+	Editor editor;
+	editor.frame->setEventDrivenIdle (eventDriven);
+	editor.frame->idle ();
+	size_t next = 0;
+	state.setItemsPerIteration (editor.views.size ());
+	while (state.keepRunning ())
+	{
+		for (auto i = 0u; i < kNumDirtyViews; ++i)
+		{
+			// spread the dirty views over the groups
+			next = (next + 997) % editor.views.size ();
+			editor.views[next]->setDirty (true);
+		}
+		editor.frame->idle ();
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DirtyViews, PollingIdle3000Views)
+{
+	idleWithDirtyViews (state, false);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (DirtyViews, EventDrivenIdle3000Views)
+{
+	idleWithDirtyViews (state, true);
+}
+
+} // anonymous
+} // VSTGUI
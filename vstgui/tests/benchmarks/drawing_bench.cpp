@@ -0,0 +1,112 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/ccolor.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/cviewcontainer.h"
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+//------------------------------------------------------------------------
+class FillView : public CView
+{
+public:
+	FillView (const CRect& size, const CColor& color) : CView (size), color (color) {}
+
+	void draw (CDrawContext* context) override
+	{
+		context->setFillColor (color);
+		context->drawRect (getViewSize (), kDrawFilled);
+		setDirty (false);
+	}
+
+private:
+	CColor color;
+};
+
+constexpr CCoord kSurfaceSize = 512.;
+
+//------------------------------------------------------------------------
+SharedPointer<CViewContainer> createDeepTree (uint32_t depth)
+{
+	CRect size (0, 0, kSurfaceSize, kSurfaceSize);
+	auto root = makeOwned<CViewContainer> (size);
+	root->setBackgroundColor (kGreyCColor);
+	auto parent = root.get ();
+	for (auto i = 0u; i < depth; ++i)
+	{
+		size.inset (2, 2);
+		CRect childSize (0, 0, size.getWidth (), size.getHeight ());
+		childSize.offset (2, 2);
+		auto container = new CViewContainer (childSize);
+		container->setBackgroundColor (CColor (static_cast<uint8_t> (i * 3), 100, 100));
+		container->addView (new FillView (CRect (0, 0, 8, 8), kRedCColor));
+		parent->addView (container);
+		parent = container;
+	}
+	return root;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CViewContainer> createWideTree (uint32_t columns, uint32_t rows)
+{
+	auto root = makeOwned<CViewContainer> (CRect (0, 0, kSurfaceSize, kSurfaceSize));
+	root->setBackgroundColor (kGreyCColor);
+	auto cellWidth = kSurfaceSize / columns;
+	auto cellHeight = kSurfaceSize / rows;
+	for (auto row = 0u; row < rows; ++row)
+	{
+		for (auto column = 0u; column < columns; ++column)
+		{
+			CRect r (0, 0, cellWidth - 1, cellHeight - 1);
+			r.offset (column * cellWidth, row * cellHeight);
+			root->addView (new FillView (r, (row + column) % 2 ? kRedCColor : kBlueCColor));
+		}
+	}
+	return root;
+}
+
+//------------------------------------------------------------------------
+void drawContainer (State& state, CViewContainer* container, const CRect& updateRect)
+{
+	auto context = COffscreenContext::create ({kSurfaceSize, kSurfaceSize});
+	if (!context)
+		return;
+	while (state.keepRunning ())
+	{
+		context->beginDraw ();
+		container->drawRect (context, updateRect);
+		context->endDraw ();
+	}
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, DrawDeepTree)
+{
+	auto container = createDeepTree (100);
+	drawContainer (state, container, container->getViewSize ());
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, DrawWideTree)
+{
+	auto container = createWideTree (64, 64);
+	state.setItemsPerIteration (64 * 64);
+	drawContainer (state, container, container->getViewSize ());
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CViewContainer, DrawWideTreePartial)
+{
+	auto container = createWideTree (64, 64);
+	drawContainer (state, container, CRect (100, 100, 132, 132));
+}
+
+} // VSTGUI
@@ -0,0 +1,141 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/platform/iplatformframecallback.h"
+
+#if LINUX
+#include "vstgui/lib/platform/linux/cairotilerenderer.h"
+#include <thread>
+#endif
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+constexpr CCoord kWidth = 1280.;
+constexpr CCoord kHeight = 800.;
+constexpr CCoord kCellSize = 40.;
+constexpr CCoord kGroupSize = kCellSize * 4.;
+
+//------------------------------------------------------------------------
+class ShapeView : public CView
+{
+public:
+	ShapeView (const CRect& size, const CColor& color) : CView (size), color (color)
+	{
+		setThreadSafeDrawing (true);
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		auto r = getViewSize ();
+		r.inset (2., 2.);
+		context->setDrawMode (kAntiAliasing);
+		context->setFillColor (color);
+		context->drawEllipse (r, kDrawFilled);
+		r.inset (6., 6.);
+		context->setFrameColor (kBlackCColor);
+		context->setLineWidth (1.5);
+		context->drawRect (r, kDrawStroked);
+		setDirty (false);
+	}
+
+private:
+	CColor color;
+};
+
+//------------------------------------------------------------------------
+CFrame* createFrame (double scaleFactor)
+{
+	auto frame = new CFrame (CRect (0, 0, kWidth, kHeight), nullptr);
+	frame->setBackgroundColor (kGreyCColor);
+	frame->setThreadSafeDrawing (true);
+	for (auto top = 0.; top < kHeight; top += kGroupSize)
+	{
+		for (auto left = 0.; left < kWidth; left += kGroupSize)
+		{
+			auto group = new CViewContainer (CRect (left, top, left + kGroupSize, top + kGroupSize));
+			group->setBackgroundColor (kWhiteCColor);
+			group->setThreadSafeDrawing (true);
+			for (auto y = 0.; y < kGroupSize; y += kCellSize)
+			{
+				for (auto x = 0.; x < kGroupSize; x += kCellSize)
+				{
+					CColor color (static_cast<uint8_t> (left + x), static_cast<uint8_t> (top + y), 128);
+					group->addView (
+						new ShapeView (CRect (x, y, x + kCellSize, y + kCellSize), color));
+				}
+			}
+			frame->addView (group);
+		}
+	}
+	frame->openHeadless (scaleFactor);
+	return frame;
+}
+
+//------------------------------------------------------------------------
+void drawFrame (State& state, double scaleFactor)
+{
+	auto frame = createFrame (scaleFactor);
+	if (auto context = COffscreenContext::create ({kWidth, kHeight}, scaleFactor))
+	{
+		while (state.keepRunning ())
+		{
+			context->beginDraw ();
+			frame->drawRect (context, frame->getViewSize ());
+			context->endDraw ();
+		}
+	}
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (FrameDraw, FullRedraw1x)
+{
+	drawFrame (state, 1.);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (FrameDraw, FullRedraw2x)
+{
+	drawFrame (state, 2.);
+}
+
+#if LINUX
+//------------------------------------------------------------------------
+void drawFrameTiled (State& state, double scaleFactor)
+{
+	auto frame = createFrame (scaleFactor);
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (
+		CAIRO_FORMAT_ARGB32, static_cast<int> (kWidth * scaleFactor),
+		static_cast<int> (kHeight * scaleFactor)));
+	// the calling thread draws tiles, too
+	auto numWorkers = std::max (1u, std::thread::hardware_concurrency ()) - 1;
+	Cairo::TileRenderer renderer (numWorkers);
+	Cairo::TileRenderer::RectList rects {frame->getViewSize ()};
+	auto frameCallback = dynamic_cast<IPlatformFrameCallback*> (frame);
+	while (state.keepRunning ())
+		renderer.draw (surface, scaleFactor, rects, frameCallback);
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (FrameDraw, FullRedrawTiled1x)
+{
+	drawFrameTiled (state, 1.);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (FrameDraw, FullRedrawTiled2x)
+{
+	drawFrameTiled (state, 2.);
+}
+#endif // LINUX
+
+} // anonymous
+} // VSTGUI
@@ -0,0 +1,69 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cinvalidrectlist.h"
+#include <random>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+//------------------------------------------------------------------------
+std::vector<CRect> createRandomRects (size_t count)
+{
+	std::vector<CRect> rects;
+	std::mt19937 random (42);
+	std::uniform_int_distribution<int> position (0, 1000);
+	std::uniform_int_distribution<int> extent (1, 50);
+	for (auto i = 0u; i < count; ++i)
+	{
+		CRect r (0, 0, extent (random), extent (random));
+		r.offset (position (random), position (random));
+		rects.emplace_back (r);
+	}
+	return rects;
+}
+
+//------------------------------------------------------------------------
+void addAll (State& state, const std::vector<CRect>& rects)
+{
+	CInvalidRectList list;
+	state.setItemsPerIteration (rects.size ());
+	while (state.keepRunning ())
+	{
+		list.clear ();
+		for (const auto& r : rects)
+			list.add (r);
+	}
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (CInvalidRectList, AddRandom100)
+{
+	addAll (state, createRandomRects (100));
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CInvalidRectList, AddRandom1000)
+{
+	addAll (state, createRandomRects (1000));
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (CInvalidRectList, AddOverlappingGrid)
+{
+	std::vector<CRect> rects;
+	for (auto y = 0; y < 32; ++y)
+	{
+		for (auto x = 0; x < 32; ++x)
+			rects.emplace_back (CRect (x * 10, y * 10, x * 10 + 15, y * 10 + 15));
+	}
+	addAll (state, rects);
+}
+
+} // VSTGUI
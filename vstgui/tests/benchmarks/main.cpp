@@ -0,0 +1,290 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/vstguiinit.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+using namespace VSTGUI::Benchmark;
+
+//------------------------------------------------------------------------
+// count the allocated bytes for the memory benchmarks
+static std::atomic<uint64_t> gAllocatedBytes {0};
+
+//------------------------------------------------------------------------
+void* operator new (size_t size)
+{
+	gAllocatedBytes += size;
+	if (auto ptr = std::malloc (size ? size : 1))
+		return ptr;
+	throw std::bad_alloc ();
+}
+
+//------------------------------------------------------------------------
+void operator delete (void* ptr) noexcept
+{
+	std::free (ptr);
+}
+
+//------------------------------------------------------------------------
+void operator delete (void* ptr, size_t) noexcept
+{
+	std::free (ptr);
+}
+
+//------------------------------------------------------------------------
+uint64_t VSTGUI::Benchmark::getAllocatedBytes ()
+{
+	return gAllocatedBytes;
+}
+
+namespace {
+
+//------------------------------------------------------------------------
+struct Options
+{
+	std::string jsonPath;
+	std::string filter;
+	std::string label;
+	uint32_t samples {5};
+	double minSampleTime {0.05};
+};
+
+//------------------------------------------------------------------------
+struct Result
+{
+	std::string name;
+	uint64_t iterations {0};
+	std::vector<double> nsPerIteration;
+	uint64_t itemsPerIteration {0};
+	double bytesPerItem {0.};
+
+	double min () const { return *std::min_element (nsPerIteration.begin (), nsPerIteration.end ()); }
+	double max () const { return *std::max_element (nsPerIteration.begin (), nsPerIteration.end ()); }
+	double mean () const
+	{
+		double sum = 0.;
+		for (auto v : nsPerIteration)
+			sum += v;
+		return sum / static_cast<double> (nsPerIteration.size ());
+	}
+	double median () const
+	{
+		auto values = nsPerIteration;
+		std::sort (values.begin (), values.end ());
+		auto mid = values.size () / 2;
+		return (values.size () % 2) ? values[mid] : (values[mid - 1] + values[mid]) / 2.;
+	}
+};
+
+//------------------------------------------------------------------------
+double toSeconds (State::Clock::duration d)
+{
+	return std::chrono::duration<double> (d).count ();
+}
+
+//------------------------------------------------------------------------
+bool run (const Entry& entry, const Options& options, Result& result)
+{
+	result.name = entry.suite + "/" + entry.name;
+
+	// find the number of iterations needed to run at least the minimum sample time
+	uint64_t iterations = 1;
+	while (true)
+	{
+		State state (iterations);
+		entry.function (state);
+		if (!state.isFinished ())
+			return false;
+		auto elapsed = toSeconds (state.getElapsed ());
+		if (elapsed >= options.minSampleTime || iterations >= (1ull << 40))
+			break;
+		auto factor = elapsed > 0. ? (options.minSampleTime * 1.2) / elapsed : 10.;
+		factor = std::min (std::max (factor, 2.), 10.);
+		iterations = static_cast<uint64_t> (static_cast<double> (iterations) * factor);
+	}
+
+	result.iterations = iterations;
+	for (auto i = 0u; i < options.samples; ++i)
+	{
+		State state (iterations);
+		entry.function (state);
+		result.itemsPerIteration = state.getItemsPerIteration ();
+		result.bytesPerItem = state.getBytesPerItem ();
+		result.nsPerIteration.emplace_back (toSeconds (state.getElapsed ()) * 1e9 /
+											static_cast<double> (iterations));
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+std::string escapeJSON (const std::string& str)
+{
+	std::string result;
+	for (auto c : str)
+	{
+		switch (c)
+		{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			case '\n': result += "\\n"; break;
+			case '\t': result += "\\t"; break;
+			default:
+			{
+				if (static_cast<unsigned char> (c) < 0x20)
+					continue;
+				result += c;
+			}
+		}
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+std::string toJSON (const std::vector<Result>& results, const Options& options)
+{
+	std::ostringstream stream;
+	stream.precision (17);
+	stream << "{\n";
+	stream << "  \"label\": \"" << escapeJSON (options.label) << "\",\n";
+	stream << "  \"samples\": " << options.samples << ",\n";
+	stream << "  \"benchmarks\": [";
+	bool first = true;
+	for (const auto& result : results)
+	{
+		stream << (first ? "\n" : ",\n");
+		first = false;
+		stream << "    {\n";
+		stream << "      \"name\": \"" << escapeJSON (result.name) << "\",\n";
+		stream << "      \"iterations\": " << result.iterations << ",\n";
+		stream << "      \"min_ns\": " << result.min () << ",\n";
+		stream << "      \"median_ns\": " << result.median () << ",\n";
+		stream << "      \"mean_ns\": " << result.mean () << ",\n";
+		stream << "      \"max_ns\": " << result.max ();
+		if (result.itemsPerIteration)
+		{
+			stream << ",\n      \"items_per_second\": "
+				   << static_cast<double> (result.itemsPerIteration) * 1e9 / result.median ();
+		}
+		if (result.bytesPerItem > 0.)
+			stream << ",\n      \"bytes_per_item\": " << result.bytesPerItem;
+		stream << "\n    }";
+	}
+	stream << "\n  ]\n}\n";
+	return stream.str ();
+}
+
+//------------------------------------------------------------------------
+void printUsage ()
+{
+	printf ("usage: vstgui_benchmarks [--filter text] [--json path|-] [--label text] "
+			"[--samples n] [--min-time ms]\n");
+}
+
+//------------------------------------------------------------------------
+bool parseOptions (int argc, char* argv[], Options& options)
+{
+	for (auto i = 1; i < argc; ++i)
+	{
+		UTF8StringView arg (argv[i]);
+		auto hasValue = i + 1 < argc;
+		if (arg == "--filter" && hasValue)
+			options.filter = argv[++i];
+		else if (arg == "--json" && hasValue)
+			options.jsonPath = argv[++i];
+		else if (arg == "--label" && hasValue)
+			options.label = argv[++i];
+		else if (arg == "--samples" && hasValue)
+			options.samples =
+				std::max<uint32_t> (1, static_cast<uint32_t> (UTF8StringView (argv[++i]).toInteger ()));
+		else if (arg == "--min-time" && hasValue)
+			options.minSampleTime = UTF8StringView (argv[++i]).toDouble () / 1000.;
+		else
+			return false;
+	}
+	return true;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions (argc, argv, options))
+	{
+		printUsage ();
+		return -1;
+	}
+
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	CoInitialize (nullptr);
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+
+	auto printToStdOut = options.jsonPath != "-";
+	std::vector<Result> results;
+	for (const auto& entry : Registry::instance ())
+	{
+		if (!options.filter.empty () &&
+			(entry.suite + "/" + entry.name).find (options.filter) == std::string::npos)
+			continue;
+		Result result;
+		if (!run (entry, options, result))
+		{
+			if (printToStdOut)
+				printf ("%-48s skipped\n", result.name.data ());
+			continue;
+		}
+		if (printToStdOut)
+		{
+			printf ("%-48s %14.1f ns (min %.1f, max %.1f) %12llu iterations\n", result.name.data (),
+					result.median (), result.min (), result.max (),
+					static_cast<unsigned long long> (result.iterations));
+			if (result.bytesPerItem > 0.)
+				printf ("%-48s %14.1f bytes per item\n", "", result.bytesPerItem);
+		}
+		results.emplace_back (std::move (result));
+	}
+
+	if (options.jsonPath == "-")
+	{
+		std::cout << toJSON (results, options);
+	}
+	else if (!options.jsonPath.empty ())
+	{
+		std::ofstream stream (options.jsonPath);
+		if (!stream)
+		{
+			printf ("Could not write %s\n", options.jsonPath.data ());
+			VSTGUI::exit ();
+			return -1;
+		}
+		stream << toJSON (results, options);
+	}
+
+	VSTGUI::exit ();
+	return 0;
+}
@@ -0,0 +1,45 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/pixelbuffer.h"
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+constexpr uint32_t kWidth = 1024;
+constexpr uint32_t kHeight = 1024;
+
+//------------------------------------------------------------------------
+void convert (State& state, PixelBuffer::Format srcFormat, PixelBuffer::Format dstFormat)
+{
+	std::vector<uint8_t> buffer (kWidth * kHeight * 4);
+	for (auto i = 0u; i < buffer.size (); ++i)
+		buffer[i] = static_cast<uint8_t> (i);
+	// convert forth and back to always work on the same data
+	state.setItemsPerIteration (kWidth * kHeight * 2);
+	while (state.keepRunning ())
+	{
+		PixelBuffer::convert (srcFormat, dstFormat, buffer.data (), kWidth * 4, kWidth, kHeight);
+		PixelBuffer::convert (dstFormat, srcFormat, buffer.data (), kWidth * 4, kWidth, kHeight);
+	}
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (PixelBuffer, ConvertARGBToBGRA)
+{
+	convert (state, PixelBuffer::Format::ARGB, PixelBuffer::Format::BGRA);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (PixelBuffer, ConvertRGBAToABGR)
+{
+	convert (state, PixelBuffer::Format::RGBA, PixelBuffer::Format::ABGR);
+}
+
+} // VSTGUI
@@ -0,0 +1,60 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/iplatformfont.h"
+#include "vstgui/lib/platform/iplatformstring.h"
+#include "vstgui/lib/platform/platformfactory.h"
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+constexpr auto kShortText = "Cutoff";
+constexpr auto kLongText =
+	"The quick brown fox jumps over the lazy dog. 0123456789 Frequency Resonance Envelope";
+
+//------------------------------------------------------------------------
+void measureWithContext (State& state, UTF8StringPtr text)
+{
+	auto context = COffscreenContext::create ({16, 16});
+	if (!context)
+		return;
+	context->beginDraw ();
+	context->setFont (kNormalFont);
+	while (state.keepRunning ())
+		context->getStringWidth (text);
+	context->endDraw ();
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (Text, MeasureShortString)
+{
+	measureWithContext (state, kShortText);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (Text, MeasureLongString)
+{
+	measureWithContext (state, kLongText);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (Text, MeasurePlatformStringWithoutContext)
+{
+	auto painter = kNormalFont->getFontPainter ();
+	auto string = getPlatformFactory ().createString (kLongText);
+	if (!painter || !string)
+		return;
+	while (state.keepRunning ())
+		painter->getStringWidth (nullptr, string, true);
+}
+
+} // VSTGUI
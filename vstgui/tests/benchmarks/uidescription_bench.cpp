@@ -0,0 +1,113 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cview.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+#include <sstream>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+constexpr uint32_t kNumColors = 200;
+constexpr uint32_t kNumColumns = 40;
+constexpr uint32_t kNumRows = 50;
+
+//------------------------------------------------------------------------
+std::string createLargeUIDesc ()
+{
+	std::ostringstream stream;
+	stream << "<vstgui-ui-description version=\"1\">\n";
+	stream << "\t<colors>\n";
+	for (auto i = 0u; i < kNumColors; ++i)
+	{
+		stream << "\t\t<color name=\"color" << i << "\" red=\"" << (i % 256) << "\" green=\""
+			   << ((i * 7) % 256) << "\" blue=\"" << ((i * 13) % 256) << "\" alpha=\"255\"/>\n";
+	}
+	stream << "\t</colors>\n";
+	stream << "\t<control-tags>\n";
+	for (auto i = 0u; i < kNumColumns * kNumRows; ++i)
+		stream << "\t\t<control-tag name=\"tag" << i << "\" tag=\"" << i << "\"/>\n";
+	stream << "\t</control-tags>\n";
+	stream << "\t<template name=\"view\" class=\"CViewContainer\" size=\"" << kNumColumns * 20
+		   << ", " << kNumRows * 20 << "\" background-color=\"color0\">\n";
+	for (auto row = 0u; row < kNumRows; ++row)
+	{
+		stream << "\t\t<view class=\"CViewContainer\" origin=\"0, " << row * 20 << "\" size=\""
+			   << kNumColumns * 20 << ", 20\">\n";
+		for (auto column = 0u; column < kNumColumns; ++column)
+		{
+			auto index = row * kNumColumns + column;
+			if (index % 2)
+			{
+				stream << "\t\t\t<view class=\"CTextLabel\" origin=\"" << column * 20
+					   << ", 0\" size=\"20, 20\" title=\"L" << index << "\" font-color=\"color"
+					   << (index % kNumColors) << "\"/>\n";
+			}
+			else
+			{
+				stream << "\t\t\t<view class=\"CSlider\" origin=\"" << column * 20
+					   << ", 0\" size=\"20, 20\" control-tag=\"tag" << index
+					   << "\" frame-color=\"color" << (index % kNumColors) << "\"/>\n";
+			}
+		}
+		stream << "\t\t</view>\n";
+	}
+	stream << "\t</template>\n";
+	stream << "</vstgui-ui-description>\n";
+	return stream.str ();
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UIDescription> parse (const std::string& xml)
+{
+	MemoryContentProvider provider (xml.data (), static_cast<uint32_t> (xml.size ()));
+	auto description = makeOwned<UIDescription> (&provider);
+	if (!description->parse ())
+		return nullptr;
+	return description;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+BENCHMARK (UIDescription, Parse)
+{
+	auto xml = createLargeUIDesc ();
+	while (state.keepRunning ())
+		parse (xml);
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (UIDescription, CreateView)
+{
+	auto description = parse (createLargeUIDesc ());
+	if (!description)
+		return;
+	state.setItemsPerIteration (kNumColumns * kNumRows);
+	while (state.keepRunning ())
+	{
+		if (auto view = description->createView ("view", nullptr))
+			view->forget ();
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (UIDescription, ParseAndCreateView)
+{
+	auto xml = createLargeUIDesc ();
+	while (state.keepRunning ())
+	{
+		if (auto description = parse (xml))
+		{
+			if (auto view = description->createView ("view", nullptr))
+				view->forget ();
+		}
+	}
+}
+
+} // VSTGUI
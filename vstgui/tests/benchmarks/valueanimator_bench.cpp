@@ -0,0 +1,65 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/animation/valueanimator.h"
+#include <vector>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+using Animation::Easing;
+using Animation::ValueAnimator;
+
+constexpr uint32_t kNumAnimations = 10000;
+constexpr uint64_t kFrameTime = 1000000 / 60;
+
+//------------------------------------------------------------------------
+void applyValue (void* object, uint32_t tag, float value)
+{
+	static_cast<float*> (object)[tag] = value;
+}
+
+//------------------------------------------------------------------------
+void runAnimations (State& state, const Easing& easing)
+{
+	std::vector<float> values (kNumAnimations);
+	ValueAnimator animator (0);
+	uint64_t time = 0;
+	// every animation is restarted by the tick after it has finished
+	uint64_t duration = 200 * kFrameTime;
+	auto addAnimations = [&] () {
+		while (animator.getNumAnimations () < kNumAnimations)
+		{
+			auto index = static_cast<uint32_t> (animator.getNumAnimations ());
+			animator.add ({applyValue, values.data (), index}, 0.f, 1.f,
+						  duration + (index % 100) * kFrameTime, easing);
+		}
+	};
+	addAnimations ();
+	state.setItemsPerIteration (kNumAnimations);
+	while (state.keepRunning ())
+	{
+		animator.tick (time);
+		time += kFrameTime;
+		if (animator.getNumAnimations () < kNumAnimations)
+			addAnimations ();
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ValueAnimator, Linear10k)
+{
+	runAnimations (state, Easing::linear ());
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ValueAnimator, CubicBezier10k)
+{
+	runAnimations (state, Easing::cubicBezier (0.42f, 0.f, 0.58f, 1.f));
+}
+
+} // anonymous
+} // VSTGUI
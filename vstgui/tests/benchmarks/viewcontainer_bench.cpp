@@ -0,0 +1,97 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include <vector>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+// one container with 100 x 100 children
+constexpr uint32_t kNumRows = 100;
+constexpr uint32_t kNumColumns = 100;
+constexpr CCoord kCellSize = 8.;
+constexpr CCoord kWidth = kCellSize * kNumColumns;
+constexpr CCoord kHeight = kCellSize * kNumRows;
+constexpr uint32_t kNumPoints = 1000;
+
+//------------------------------------------------------------------------
+struct Editor
+{
+	CFrame* frame {nullptr};
+	CViewContainer* container {nullptr};
+
+	Editor ()
+	{
+		frame = new CFrame (CRect (0, 0, kWidth, kHeight), nullptr);
+		container = new CViewContainer (CRect (0, 0, kWidth, kHeight));
+		container->setTransparency (true);
+		for (auto r = 0u; r < kNumRows; ++r)
+		{
+			for (auto c = 0u; c < kNumColumns; ++c)
+			{
+				CRect size (0, 0, kCellSize, kCellSize);
+				size.offset (kCellSize * c, kCellSize * r);
+				container->addView (new CView (size));
+			}
+		}
+		frame->addView (container);
+		frame->openHeadless ();
+	}
+
+	~Editor () { frame->close (); }
+};
+
+//------------------------------------------------------------------------
+void drawRect (State& state, const CRect& updateRect)
+{
+	Editor editor;
+	auto context = COffscreenContext::create ({kWidth, kHeight});
+	if (!context)
+		return;
+	state.setItemsPerIteration (kNumRows * kNumColumns);
+	context->beginDraw ();
+	while (state.keepRunning ())
+		editor.container->drawRect (context, updateRect);
+	context->endDraw ();
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ViewContainer, DrawAll10kViews)
+{
+	drawRect (state, CRect (0, 0, kWidth, kHeight));
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ViewContainer, DrawSmallRect10kViews)
+{
+	drawRect (state, CRect (kWidth / 2., kHeight / 2., kWidth / 2. + 20., kHeight / 2. + 20.));
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ViewContainer, GetViewAt10kViews)
+{
+	Editor editor;
+	std::vector<CPoint> points;
+	uint32_t seed = 1;
+	for (auto i = 0u; i < kNumPoints; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		points.emplace_back ((seed >> 8) % static_cast<uint32_t> (kWidth),
+							 (seed >> 20) % static_cast<uint32_t> (kHeight));
+	}
+	state.setItemsPerIteration (kNumPoints);
+	while (state.keepRunning ())
+	{
+		for (const auto& p : points)
+			editor.container->getViewAt (p);
+	}
+}
+
+} // anonymous
+} // VSTGUI
@@ -0,0 +1,92 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "benchmark.h"
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cviewcontainer.h"
+#include <cstdio>
+#include <vector>
+
+namespace VSTGUI {
+namespace {
+
+using Benchmark::State;
+
+// 100 containers with 100 views
+constexpr uint32_t kNumContainers = 100;
+constexpr uint32_t kNumViewsPerContainer = 100;
+constexpr uint32_t kNumViews = kNumContainers * kNumViewsPerContainer;
+constexpr CViewAttributeID kCustomAttribute = 'Bcus';
+
+//------------------------------------------------------------------------
+/** the views are set up like the views of an editor: all views have a background, some are
+ *	transparent, have a mouseable area differing from the view size or a custom attribute
+ */
+SharedPointer<CViewContainer> createEditor (CBitmap* background, std::vector<CView*>* views)
+{
+	auto editor = makeOwned<CViewContainer> (CRect (0, 0, 1000, 1000));
+	for (auto c = 0u; c < kNumContainers; ++c)
+	{
+		auto container = new CViewContainer (CRect (0, 0, 100, 100));
+		for (auto i = 0u; i < kNumViewsPerContainer; ++i)
+		{
+			CRect r (0, 0, 10, 10);
+			r.offset ((i % 10) * 10., (i / 10) * 10.);
+			auto view = new CView (r);
+			view->setBackground (background);
+			if (i % 4 == 0)
+				view->setAlphaValue (0.5f);
+			if (i % 2 == 0)
+				view->setMouseableArea (r.inset (1., 1.));
+			if (i % 10 == 0)
+				view->setAttribute (kCustomAttribute, i);
+			container->addView (view);
+			if (views)
+				views->emplace_back (view);
+		}
+		editor->addView (container);
+	}
+	return editor;
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ViewMemory, Create10kViews)
+{
+	auto background = makeOwned<CBitmap> (10., 10.);
+	state.setItemsPerIteration (kNumViews);
+	while (state.keepRunning ())
+	{
+		auto allocatedBytes = Benchmark::getAllocatedBytes ();
+		auto editor = createEditor (background, nullptr);
+		state.setBytesPerItem (
+			static_cast<double> (Benchmark::getAllocatedBytes () - allocatedBytes) / kNumViews);
+	}
+}
+
+//------------------------------------------------------------------------
+BENCHMARK (ViewMemory, HotGetters10kViews)
+{
+	auto background = makeOwned<CBitmap> (10., 10.);
+	std::vector<CView*> views;
+	auto editor = createEditor (background, &views);
+	state.setItemsPerIteration (kNumViews);
+	float alpha = 0.f;
+	CCoord width = 0.;
+	uint32_t numBackgrounds = 0;
+	while (state.keepRunning ())
+	{
+		for (auto view : views)
+		{
+			alpha += view->getAlphaValue ();
+			width += view->getMouseableArea ().getWidth ();
+			if (view->getDrawBackground ())
+				++numBackgrounds;
+		}
+	}
+	if (alpha == 0.f || width == 0. || numBackgrounds == 0)
+		printf ("unexpected result\n");
+}
+
+} // anonymous
+} // VSTGUI
@@ -4,6 +4,7 @@
 
 #include "../../../../lib/animation/animations.h"
 #include "../../../../lib/controls/ccontrol.h"
+#include "../../../../lib/cframe.h"
 #include "../../../../lib/cview.h"
 #include "../../../../lib/cviewcontainer.h"
 #include "../../unittests.h"
@@ -72,6 +73,94 @@ TEST_CASE (ViewSizeAnimationTest, UnfinishedAnimation)
 	EXPECT (view.getViewSize () == CRect (10, 10, 100, 100));
 }
 
+//-----------------------------------------------------------------------------
+TEST_CASE (SnapshotTransformAnimationTest, Animation)
+{
+	CRect r (0, 0, 100, 100);
+	auto frame = owned (new CFrame (CRect (0, 0, 400, 400), nullptr));
+	auto container = new CViewContainer (CRect (0, 0, 400, 400));
+	auto view = new CView (r);
+	container->addView (view);
+	frame->addView (container);
+	frame->attached (frame);
+
+	SnapshotTransformAnimation a (CRect (100, 0, 300, 100), 0.5f);
+	a.animationStart (view, "");
+	EXPECT (view->isVisible () == false);
+	EXPECT (container->getNbViews () == 2);
+	auto snapshot = container->getView (0);
+	EXPECT (snapshot != view);
+	a.animationTick (view, "", 0.5f);
+	EXPECT (view->getViewSize () == r);
+	EXPECT (snapshot->getViewSize () == CRect (50, 0, 200, 100));
+	EXPECT (snapshot->getAlphaValue () == 0.75f);
+	a.animationFinished (view, "", false);
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (view->isVisible ());
+	EXPECT (view->getViewSize () == CRect (100, 0, 300, 100));
+	EXPECT (view->getAlphaValue () == 0.5f);
+	frame->removed (frame);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (SnapshotTransformAnimationTest, FadeInFromZeroAlpha)
+{
+	CRect r (0, 0, 100, 100);
+	auto frame = owned (new CFrame (CRect (0, 0, 400, 400), nullptr));
+	auto view = new CView (r);
+	view->setAlphaValue (0.f);
+	frame->addView (view);
+	frame->attached (frame);
+
+	SnapshotTransformAnimation a (r, 1.f);
+	a.animationStart (view, "");
+	EXPECT (frame->getNbViews () == 2);
+	auto snapshot = frame->getView (0);
+	EXPECT (snapshot != view);
+	a.animationTick (view, "", 0.5f);
+	EXPECT (view->getAlphaValue () == 0.f);
+	EXPECT (snapshot->getAlphaValue () == 0.5f);
+	a.animationFinished (view, "", false);
+	EXPECT (frame->getNbViews () == 1);
+	EXPECT (view->isVisible ());
+	EXPECT (view->getAlphaValue () == 1.f);
+	frame->removed (frame);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (SnapshotTransformAnimationTest, CanceledAnimation)
+{
+	CRect r (0, 0, 100, 100);
+	auto frame = owned (new CFrame (CRect (0, 0, 400, 400), nullptr));
+	auto view = new CView (r);
+	frame->addView (view);
+	frame->attached (frame);
+
+	SnapshotTransformAnimation a (CRect (100, 0, 300, 100), 0.f);
+	a.animationStart (view, "");
+	a.animationTick (view, "", 0.5f);
+	a.animationFinished (view, "", true);
+	EXPECT (frame->getNbViews () == 1);
+	EXPECT (view->isVisible ());
+	EXPECT (view->getViewSize () == r);
+	EXPECT (view->getAlphaValue () == 1.f);
+	frame->removed (frame);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (SnapshotTransformAnimationTest, AnimatesViewWithoutFrame)
+{
+	TestView view;
+	SnapshotTransformAnimation a (CRect (10, 10, 100, 100), 0.f);
+	a.animationStart (&view, "");
+	a.animationTick (&view, "", 0.5f);
+	EXPECT (view.getViewSize () == CRect (5, 5, 50, 50));
+	EXPECT (view.getAlphaValue () == 0.5f);
+	a.animationFinished (&view, "", false);
+	EXPECT (view.getViewSize () == CRect (10, 10, 100, 100));
+	EXPECT (view.getAlphaValue () == 0.f);
+}
+
 //-----------------------------------------------------------------------------
 TEST_CASE (ControlValueAnimationTest, Animation)
 {
@@ -244,4 +333,62 @@ TEST_CASE (ExchangeViewAnimationTest, PushInOutFromRight)
 	container->removed (parentContainer);
 }
 
+//-----------------------------------------------------------------------------
+TEST_CASE (ExchangeViewAnimationTest, PushInOutFromLeftWithSnapshots)
+{
+	CRect r (0, 0, 100, 100);
+	auto frame = owned (new CFrame (r, nullptr));
+	auto container = new CViewContainer (r);
+	auto oldView = new CView (r);
+	auto newView = new CView (r);
+	container->addView (oldView);
+	frame->addView (container);
+	frame->attached (frame);
+	ExchangeViewAnimation a (oldView, newView, ExchangeViewAnimation::kPushInOutFromLeft, true);
+	a.animationStart (container, "");
+	EXPECT (container->getNbViews () == 4);
+	EXPECT (newView->isVisible () == false);
+	EXPECT (oldView->isVisible () == false);
+	a.animationTick (container, "", 0.5f);
+	// only the snapshots are moved
+	EXPECT (oldView->getViewSize () == r);
+	EXPECT (newView->getViewSize () == CRect (-100, 0, 0, 100));
+	a.animationTick (container, "", 1.f);
+	a.animationFinished (container, "", false);
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (oldView->isAttached () == false);
+	EXPECT (newView->isVisible ());
+	EXPECT (newView->getViewSize () == r);
+	frame->removed (frame);
+}
+
+TEST_CASE (ExchangeViewAnimationTest, AlphaValueFadeWithSnapshots)
+{
+	CRect r (0, 0, 100, 100);
+	auto frame = owned (new CFrame (r, nullptr));
+	auto container = new CViewContainer (r);
+	auto oldView = new CView (r);
+	auto newView = new CView (r);
+	container->addView (oldView);
+	frame->addView (container);
+	frame->attached (frame);
+	ExchangeViewAnimation a (oldView, newView, ExchangeViewAnimation::kAlphaValueFade, true);
+	a.animationStart (container, "");
+	// the new view is faded in from an alpha value of 0 and still gets a snapshot
+	EXPECT (container->getNbViews () == 4);
+	EXPECT (newView->isVisible () == false);
+	EXPECT (oldView->isVisible () == false);
+	a.animationTick (container, "", 0.5f);
+	// only the snapshots are faded
+	EXPECT (oldView->getAlphaValue () == 1.f);
+	EXPECT (newView->getAlphaValue () == 0.f);
+	a.animationTick (container, "", 1.f);
+	a.animationFinished (container, "", false);
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (oldView->isAttached () == false);
+	EXPECT (newView->isVisible ());
+	EXPECT (newView->getAlphaValue () == 1.f);
+	frame->removed (frame);
+}
+
 } // VSTGUI
@@ -7,6 +7,7 @@
 #include "../../../../lib/cview.h"
 #include "../../../../lib/cviewcontainer.h"
 #include "../../unittests.h"
+#include <cmath>
 
 namespace VSTGUI {
 using namespace Animation;
@@ -95,4 +96,107 @@ TEST_CASE (TimingFunctionTest, CubicBezierTimingFunction)
 	EXPECT (f.getPosition (100) == 1.0f);
 }
 
+namespace {
+
+//-----------------------------------------------------------------------------
+struct CSSReference
+{
+	float x1, y1, x2, y2;
+	// the positions at the times 0.1, 0.25, 0.5, 0.75 and 0.9
+	float positions[5];
+};
+
+constexpr float kReferenceTimes[] = {0.1f, 0.25f, 0.5f, 0.75f, 0.9f};
+
+// calculated with a double precision bisection of the curve parameter
+constexpr CSSReference kCSSReferences[] = {
+	// ease
+	{0.25f, 0.1f, 0.25f, 1.f, {0.094796f, 0.408511f, 0.802403f, 0.960459f, 0.994316f}},
+	// ease-in
+	{0.42f, 0.f, 1.f, 1.f, {0.017027f, 0.093465f, 0.315357f, 0.621862f, 0.839428f}},
+	// ease-out
+	{0.f, 0.f, 0.58f, 1.f, {0.160572f, 0.378138f, 0.684643f, 0.906535f, 0.982973f}},
+	// ease-in-out
+	{0.42f, 0.f, 0.58f, 1.f, {0.019722f, 0.129162f, 0.5f, 0.870838f, 0.980278f}},
+	// overshooting on both ends
+	{0.68f, -0.55f, 0.265f, 1.55f, {-0.066291f, -0.082807f, 0.60668f, 1.089166f, 1.062373f}},
+	// flat in x at x = 0.5
+	{1.f, 0.f, 0.f, 1.f, {0.003762f, 0.029725f, 0.5f, 0.970275f, 0.996238f}},
+	// flat in x at both ends
+	{0.f, 1.f, 1.f, 0.f, {0.3874f, 0.479055f, 0.5f, 0.520945f, 0.6126f}},
+};
+
+//-----------------------------------------------------------------------------
+double referenceBezier (const CSSReference& ref, double x)
+{
+	auto bezier = [] (double p1, double p2, double t) {
+		return 3. * (1. - t) * (1. - t) * t * p1 + 3. * (1. - t) * t * t * p2 + t * t * t;
+	};
+	auto low = 0.;
+	auto high = 1.;
+	for (auto i = 0; i < 64; ++i)
+	{
+		auto t = (low + high) * 0.5;
+		if (bezier (ref.x1, ref.x2, t) < x)
+			low = t;
+		else
+			high = t;
+	}
+	return bezier (ref.y1, ref.y2, (low + high) * 0.5);
+}
+
+} // anonymous
+
+TEST_CASE (TimingFunctionTest, CubicBezierCurveCSSReference)
+{
+	for (const auto& ref : kCSSReferences)
+	{
+		CubicBezierCurve curve (ref.x1, ref.y1, ref.x2, ref.y2);
+		EXPECT (curve.evaluate (0.f) == 0.f);
+		EXPECT (curve.evaluate (1.f) == 1.f);
+		for (auto i = 0u; i < 5; ++i)
+			EXPECT (std::abs (curve.evaluate (kReferenceTimes[i]) - ref.positions[i]) < 1e-4f);
+	}
+}
+
+TEST_CASE (TimingFunctionTest, CubicBezierCurveFlatInX)
+{
+	// where the curve is flat in x newton's method does not converge
+	for (const auto& ref : {kCSSReferences[5], kCSSReferences[6]})
+	{
+		CubicBezierCurve curve (ref.x1, ref.y1, ref.x2, ref.y2);
+		for (auto i = 0; i <= 1000; ++i)
+		{
+			auto x = static_cast<float> (i) / 1000.f;
+			EXPECT (std::abs (curve.evaluate (x) - referenceBezier (ref, x)) < 1e-4);
+		}
+		for (auto x : {0.4996f, 0.49999f, 0.50001f, 0.5004f, 0.00005f, 0.99995f})
+			EXPECT (std::abs (curve.evaluate (x) - referenceBezier (ref, x)) < 1e-4);
+	}
+}
+
+TEST_CASE (TimingFunctionTest, CubicBezierTimingFunctionPresets)
+{
+	auto ease = CubicBezierTimingFunction::easy (1000);
+	EXPECT (std::abs (ease.getPosition (250) - kCSSReferences[0].positions[1]) < 1e-4f);
+	auto easeIn = CubicBezierTimingFunction::easyIn (1000);
+	EXPECT (std::abs (easeIn.getPosition (250) - kCSSReferences[1].positions[1]) < 1e-4f);
+	auto easeOut = CubicBezierTimingFunction::easyOut (1000);
+	EXPECT (std::abs (easeOut.getPosition (250) - kCSSReferences[2].positions[1]) < 1e-4f);
+	auto easeInOut = CubicBezierTimingFunction::easyInOut (1000);
+	EXPECT (std::abs (easeInOut.getPosition (250) - kCSSReferences[3].positions[1]) < 1e-4f);
+	EXPECT (std::abs (easeInOut.getPosition (900) - kCSSReferences[3].positions[4]) < 1e-4f);
+}
+
+TEST_CASE (TimingFunctionTest, CubicBezierCurveClampsX)
+{
+	// control points outside of [0..1] in x are clamped
+	CubicBezierCurve clamped (-1.f, 0.f, 2.f, 1.f);
+	CubicBezierCurve reference (0.f, 0.f, 1.f, 1.f);
+	for (auto x = 0.f; x <= 1.f; x += 0.125f)
+		EXPECT (std::abs (clamped.evaluate (x) - reference.evaluate (x)) < 1e-6f);
+	EXPECT (clamped.evaluate (-1.f) == 0.f);
+	EXPECT (clamped.evaluate (2.f) == 1.f);
+}
+
 } // VSTGUI
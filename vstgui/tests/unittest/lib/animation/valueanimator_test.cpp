@@ -0,0 +1,131 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/animation/valueanimator.h"
+#include "../../unittests.h"
+#include <cmath>
+#include <vector>
+
+namespace VSTGUI {
+using namespace Animation;
+
+namespace {
+
+//-----------------------------------------------------------------------------
+struct Values
+{
+	std::vector<float> values;
+
+	Values (size_t size) : values (size, -1.f) {}
+
+	static void apply (void* object, uint32_t tag, float value)
+	{
+		static_cast<Values*> (object)->values[tag] = value;
+	}
+
+	ValueAnimator::Target target (uint32_t tag) { return {apply, this, tag}; }
+};
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+TEST_CASE (ValueAnimatorTest, LinearAnimation)
+{
+	ValueAnimator animator (0);
+	Values values (1);
+	auto handle = animator.add (values.target (0), 10.f, 20.f, 1000);
+	EXPECT (animator.isRunning (handle));
+	animator.tick (5000);
+	EXPECT_EQ (values.values[0], 10.f);
+	animator.tick (5500);
+	EXPECT_EQ (values.values[0], 15.f);
+	animator.tick (6000);
+	EXPECT_EQ (values.values[0], 20.f);
+	EXPECT_FALSE (animator.isRunning (handle));
+	EXPECT_EQ (animator.getNumAnimations (), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (ValueAnimatorTest, RemoveAnimation)
+{
+	ValueAnimator animator (0);
+	Values values (3);
+	ValueAnimator::Handle handles[3];
+	for (auto i = 0u; i < 3; ++i)
+		handles[i] = animator.add (values.target (i), 0.f, 1.f, 1000);
+	animator.tick (0);
+	EXPECT (animator.remove (handles[0]));
+	EXPECT_FALSE (animator.remove (handles[0]));
+	EXPECT_FALSE (animator.isRunning (handles[0]));
+	EXPECT (animator.isRunning (handles[1]));
+	EXPECT (animator.isRunning (handles[2]));
+	animator.tick (500);
+	EXPECT_EQ (values.values[0], 0.f);
+	EXPECT_EQ (values.values[1], 0.5f);
+	EXPECT_EQ (values.values[2], 0.5f);
+
+	// the slot of the removed animation is reused, the old handle stays invalid
+	auto handle = animator.add (values.target (0), 1.f, 0.f, 1000);
+	EXPECT_EQ (handle.slot, handles[0].slot);
+	EXPECT_FALSE (animator.isRunning (handles[0]));
+	EXPECT (animator.isRunning (handle));
+
+	animator.removeAll (&values);
+	EXPECT_EQ (animator.getNumAnimations (), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (ValueAnimatorTest, AddAndRemoveWhileTicking)
+{
+	struct Chain
+	{
+		ValueAnimator* animator;
+		ValueAnimator::Handle next;
+		Values values {2};
+
+		static void apply (void* object, uint32_t tag, float value)
+		{
+			auto self = static_cast<Chain*> (object);
+			self->values.values[tag] = value;
+			if (tag == 0 && value == 1.f)
+				self->next = self->animator->add ({Values::apply, &self->values, 1}, 0.f, 1.f, 100);
+		}
+	};
+	ValueAnimator animator (0);
+	Chain chain;
+	chain.animator = &animator;
+	animator.add ({Chain::apply, &chain, 0}, 0.f, 1.f, 100);
+	animator.tick (0);
+	animator.tick (100);
+	EXPECT_EQ (chain.values.values[0], 1.f);
+	EXPECT (animator.isRunning (chain.next));
+	EXPECT_EQ (chain.values.values[1], -1.f);
+	animator.tick (150);
+	animator.tick (200);
+	EXPECT_EQ (chain.values.values[1], 0.5f);
+	animator.tick (250);
+	EXPECT_EQ (chain.values.values[1], 1.f);
+	EXPECT_EQ (animator.getNumAnimations (), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (ValueAnimatorTest, Easing)
+{
+	EXPECT_EQ (Easing::linear ().evaluate (0.25f), 0.25f);
+	EXPECT_EQ (Easing::power (2.f).evaluate (0.5f), 0.25f);
+	EXPECT_EQ (Easing::power (2.f).evaluate (1.5f), 1.f);
+
+	// a cubic bezier curve with the control points on the diagonal is linear
+	auto linearBezier = Easing::cubicBezier (0.25f, 0.25f, 0.75f, 0.75f);
+	for (auto t = 0.f; t <= 1.f; t += 0.125f)
+		EXPECT (std::abs (linearBezier.evaluate (t) - t) < 1e-5f);
+
+	// ease-in-out is symmetric
+	auto easeInOut = Easing::cubicBezier (0.42f, 0.f, 0.58f, 1.f);
+	EXPECT (std::abs (easeInOut.evaluate (0.5f) - 0.5f) < 1e-5f);
+	EXPECT (std::abs (easeInOut.evaluate (0.2f) + easeInOut.evaluate (0.8f) - 1.f) < 1e-5f);
+	EXPECT (easeInOut.evaluate (0.2f) < 0.2f);
+}
+
+} // VSTGUI
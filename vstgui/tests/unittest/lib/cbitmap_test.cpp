@@ -7,6 +7,7 @@
 #include "../../../lib/platform/iplatformbitmap.h"
 #include "../../../lib/platform/platformfactory.h"
 #include "../unittests.h"
+#include <cstdlib>
 
 namespace VSTGUI {
 
@@ -33,6 +34,56 @@ TEST_CASE (CBitmap, ScaleFactor)
 	EXPECT_EQ (bitmap.getBestPlatformBitmapForScaleFactor (2.6), b2);
 }
 
+//------------------------------------------------------------------------
+TEST_CASE (CBitmap, ScaledPlatformBitmap)
+{
+	auto b2 = getPlatformFactory ().createBitmap (CPoint (8, 8));
+	b2->setScaleFactor (2.);
+	{
+		// vertical stripes of 0 and 200
+		auto pixelAccess = b2->lockPixels (true);
+		for (auto y = 0u; y < 8u; ++y)
+		{
+			auto row = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow ();
+			for (auto x = 0u; x < 8u * 4u; ++x)
+				row[x] = (x / 4u) % 2u ? 200 : 0;
+		}
+	}
+	CBitmap bitmap (b2);
+	EXPECT_EQ (bitmap.getScaledPlatformBitmap (2.), b2);
+	EXPECT_EQ (bitmap.getScaledPlatformBitmap (3.), b2);
+
+	auto s1 = bitmap.getScaledPlatformBitmap (1.);
+	EXPECT (s1 && s1 != b2);
+	EXPECT_EQ (s1->getScaleFactor (), 1.);
+	EXPECT_EQ (s1->getSize (), CPoint (4, 4));
+	{
+		auto pixelAccess = s1->lockPixels (true);
+		for (auto y = 0u; y < 4u; ++y)
+		{
+			auto row = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow ();
+			for (auto x = 0u; x < 4u * 4u; ++x)
+				EXPECT_EQ (row[x], 100);
+		}
+	}
+	EXPECT_EQ (bitmap.getScaledPlatformBitmap (1.), s1);
+
+	auto s15 = bitmap.getScaledPlatformBitmap (1.5);
+	EXPECT (s15 && s15 != s1);
+	EXPECT_EQ (s15->getScaleFactor (), 1.5);
+	EXPECT_EQ (s15->getSize (), CPoint (6, 6));
+	EXPECT_EQ (bitmap.getScaledPlatformBitmap (1.), s1);
+
+	// only the copies of the two most recently used scale factors are kept
+	auto s125 = bitmap.getScaledPlatformBitmap (1.25);
+	EXPECT_EQ (s125->getSize (), CPoint (5, 5));
+	EXPECT_EQ (bitmap.getScaledPlatformBitmap (1.), s1);
+	EXPECT_NE (bitmap.getScaledPlatformBitmap (1.5), s15);
+
+	bitmap.releaseScaledPlatformBitmaps ();
+	EXPECT_NE (bitmap.getScaledPlatformBitmap (1.), s1);
+}
+
 //------------------------------------------------------------------------
 TEST_CASE (CBitmap, PixelAccess)
 {
@@ -91,4 +142,100 @@ TEST_CASE (CBitmap, PixelAccess2)
 	}
 }
 
+//------------------------------------------------------------------------
+TEST_CASE (CBitmap, PixelAccessRows)
+{
+	CBitmap bitmap (5, 3);
+	auto accessor = owned (CBitmapPixelAccess::create (&bitmap));
+	EXPECT (accessor);
+	EXPECT (accessor->isAlphaPremultiplied ());
+	EXPECT (accessor->getBytesPerRow () >= 5 * 4);
+	auto order = accessor->getComponentOrder ();
+	for (auto y = 0u; y < accessor->getBitmapHeight (); ++y)
+	{
+		auto row = reinterpret_cast<uint8_t*> (accessor->getRow (y));
+		for (auto x = 0u; x < accessor->getBitmapWidth (); ++x, row += 4)
+		{
+			row[order.red] = static_cast<uint8_t> (x * 10);
+			row[order.green] = static_cast<uint8_t> (y * 10);
+			row[order.blue] = 1;
+			row[order.alpha] = 255;
+		}
+	}
+	do
+	{
+		CColor color;
+		accessor->getColor (color);
+		EXPECT_EQ (color, CColor (static_cast<uint8_t> (accessor->getX () * 10),
+								  static_cast<uint8_t> (accessor->getY () * 10), 1, 255));
+	} while (++(*accessor));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmap, PixelAccessStraightAlpha)
+{
+	CBitmap bitmap (10, 10);
+	CColor color (255, 100, 2, 150);
+	if (auto accessor = owned (CBitmapPixelAccess::create (&bitmap, false)))
+	{
+		EXPECT_FALSE (accessor->isAlphaPremultiplied ());
+		do
+		{
+			accessor->setColor (color);
+		} while (++(*accessor));
+	}
+	auto isClose = [] (uint8_t a, uint8_t b) { return std::abs (a - b) <= 1; };
+	if (auto accessor = owned (CBitmapPixelAccess::create (&bitmap, false)))
+	{
+		do
+		{
+			CColor c;
+			accessor->getColor (c);
+			EXPECT (isClose (c.red, color.red));
+			EXPECT (isClose (c.green, color.green));
+			EXPECT (isClose (c.blue, color.blue));
+			EXPECT_EQ (c.alpha, color.alpha);
+		} while (++(*accessor));
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CMultiFrameBitmap, Description)
+{
+	CMultiFrameBitmapDescription desc;
+	desc.frameSize = {10, 10};
+	desc.numFrames = 10;
+	desc.framesPerRow = 4;
+	CMultiFrameBitmap bitmap (getPlatformFactory ().createBitmap ({40, 30}), desc);
+	EXPECT_EQ (bitmap.getNumFrames (), 10);
+	EXPECT_EQ (bitmap.getNumFramesPerRow (), 4);
+	EXPECT_EQ (bitmap.getFrameSize (), CPoint (10, 10));
+
+	desc.numFrames = 13;
+	EXPECT_FALSE (bitmap.setMultiFrameDesc (desc));
+	desc.numFrames = 12;
+	EXPECT_TRUE (bitmap.setMultiFrameDesc (desc));
+	desc.framesPerRow = 5;
+	EXPECT_FALSE (bitmap.setMultiFrameDesc (desc));
+	desc.framesPerRow = 0;
+	EXPECT_FALSE (bitmap.setMultiFrameDesc (desc));
+	EXPECT_EQ (bitmap.getNumFrames (), 12);
+	EXPECT_EQ (bitmap.getNumFramesPerRow (), 4);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CMultiFrameBitmap, FrameOffset)
+{
+	CMultiFrameBitmapDescription desc;
+	desc.frameSize = {10, 20};
+	desc.numFrames = 6;
+	desc.framesPerRow = 4;
+	CMultiFrameBitmap bitmap (getPlatformFactory ().createBitmap ({40, 40}), desc);
+	EXPECT_EQ (bitmap.calcFrameOffset (0), CPoint (0, 0));
+	EXPECT_EQ (bitmap.calcFrameOffset (3), CPoint (30, 0));
+	EXPECT_EQ (bitmap.calcFrameOffset (4), CPoint (0, 20));
+	EXPECT_EQ (bitmap.calcFrameOffset (5), CPoint (10, 20));
+	EXPECT_EQ (bitmap.calcFrameOffset (100), CPoint (10, 20));
+}
+
 } // VSTGUI
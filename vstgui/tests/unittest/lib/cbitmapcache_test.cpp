@@ -0,0 +1,200 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmapcache.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include "../../../lib/platform/platformfactory.h"
+#include "../unittests.h"
+#include <thread>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+PNGBitmapBuffer createPNGData (CPoint size)
+{
+	auto platformBitmap = getPlatformFactory ().createBitmap (size);
+	return getPlatformFactory ().createBitmapMemoryPNGRepresentation (platformBitmap);
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr loadFromPNGData (const PNGBitmapBuffer& data)
+{
+	return CBitmapCache::instance ().loadBitmapFromMemory (data.data (),
+														   static_cast<uint32_t> (data.size ()));
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, ShareIdenticalContent)
+{
+	auto& cache = CBitmapCache::instance ();
+	cache.resetStatistics ();
+	auto data = createPNGData ({8, 8});
+	EXPECT_FALSE (data.empty ());
+	auto b1 = loadFromPNGData (data);
+	auto b2 = loadFromPNGData (data);
+	EXPECT (b1);
+	EXPECT_EQ (b1, b2);
+	EXPECT_TRUE (cache.isCached (b1));
+	auto statistics = cache.getStatistics ();
+	EXPECT_EQ (statistics.hits, 1u);
+	EXPECT_EQ (statistics.misses, 1u);
+	EXPECT (statistics.residentBytes >= 8u * 8u * 4u);
+
+	b1 = b2 = nullptr;
+	cache.trim (0);
+	EXPECT_EQ (cache.getStatistics ().residentBytes, 0u);
+	EXPECT_EQ (cache.getStatistics ().numEntries, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, DisabledCacheDoesNotShare)
+{
+	auto& cache = CBitmapCache::instance ();
+	cache.resetStatistics ();
+	cache.setEnabled (false);
+	EXPECT_FALSE (cache.isEnabled ());
+	auto data = createPNGData ({8, 8});
+	auto b1 = loadFromPNGData (data);
+	auto b2 = loadFromPNGData (data);
+	cache.setEnabled (true);
+	EXPECT (b1);
+	EXPECT (b2);
+	EXPECT_NE (b1, b2);
+	EXPECT_FALSE (cache.isCached (b1));
+	EXPECT_EQ (cache.getStatistics ().numEntries, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, EvictLeastRecentlyUsed)
+{
+	auto& cache = CBitmapCache::instance ();
+	cache.resetStatistics ();
+	auto smallData = createPNGData ({8, 8});
+	auto largeData = createPNGData ({16, 16});
+	auto smallBitmap = makeOwned<CBitmap> (loadFromPNGData (smallData));
+	auto largeBitmap = makeOwned<CBitmap> (loadFromPNGData (largeData));
+	EXPECT_EQ (cache.getStatistics ().residentBytes, (8u * 8u + 16u * 16u) * 4u);
+
+	largeBitmap->getBestPlatformBitmapForScaleFactor (1.);
+	smallBitmap->getBestPlatformBitmapForScaleFactor (1.);
+	cache.setMemoryBudget (16u * 16u * 4u - 1u);
+	auto statistics = cache.getStatistics ();
+	EXPECT_EQ (statistics.evictions, 1u);
+	EXPECT_EQ (statistics.residentBytes, 8u * 8u * 4u);
+	EXPECT_TRUE (largeBitmap->isLoaded ());
+	EXPECT_EQ (largeBitmap->getSize (), CPoint (16, 16));
+
+	// using the evicted bitmap decodes it again and evicts the other one
+	EXPECT (largeBitmap->getPlatformBitmap ());
+	statistics = cache.getStatistics ();
+	EXPECT_EQ (statistics.misses, 3u);
+	EXPECT_EQ (statistics.evictions, 2u);
+	EXPECT_EQ (statistics.residentBytes, 16u * 16u * 4u);
+	EXPECT_EQ (smallBitmap->getSize (), CPoint (8, 8));
+
+	cache.setMemoryBudget (0);
+	smallBitmap = nullptr;
+	largeBitmap = nullptr;
+	EXPECT_EQ (cache.getStatistics ().residentBytes, 0u);
+	EXPECT_EQ (cache.getStatistics ().numEntries, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, PixelAccessDetachesSharedBitmap)
+{
+	auto data = createPNGData ({8, 8});
+	auto b1 = makeOwned<CBitmap> (loadFromPNGData (data));
+	auto b2 = makeOwned<CBitmap> (loadFromPNGData (data));
+	EXPECT_EQ (b1->getPlatformBitmap (), b2->getPlatformBitmap ());
+	auto accessor = owned (CBitmapPixelAccess::create (b1));
+	EXPECT (accessor);
+	EXPECT_NE (b1->getPlatformBitmap (), b2->getPlatformBitmap ());
+	EXPECT_FALSE (CBitmapCache::instance ().isCached (b1->getPlatformBitmap ()));
+	EXPECT_TRUE (CBitmapCache::instance ().isCached (b2->getPlatformBitmap ()));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, ScaleFactorIsPartOfTheKey)
+{
+	auto& cache = CBitmapCache::instance ();
+	cache.resetStatistics ();
+	auto data = createPNGData ({8, 8});
+	auto size = static_cast<uint32_t> (data.size ());
+	auto b1 = cache.loadBitmapFromMemory (data.data (), size);
+	auto b2 = cache.loadBitmapFromMemory (data.data (), size, 2.);
+	auto b3 = cache.loadBitmapFromMemory (data.data (), size, 2.);
+	EXPECT_NE (b1, b2);
+	EXPECT_EQ (b2, b3);
+	EXPECT_EQ (b1->getScaleFactor (), 1.);
+	EXPECT_EQ (b2->getScaleFactor (), 2.);
+	EXPECT_EQ (cache.getStatistics ().misses, 2u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, SetScaleFactorKeepsSharedBitmap)
+{
+	auto& cache = CBitmapCache::instance ();
+	cache.resetStatistics ();
+	auto data = createPNGData ({8, 8});
+	auto b1 = makeOwned<CBitmap> (loadFromPNGData (data));
+	auto b2 = makeOwned<CBitmap> (loadFromPNGData (data));
+	b1->setPlatformBitmapScaleFactor (2.);
+	EXPECT_NE (b1->getPlatformBitmap (), b2->getPlatformBitmap ());
+	EXPECT_EQ (b1->getPlatformBitmap ()->getScaleFactor (), 2.);
+	EXPECT_EQ (b2->getPlatformBitmap ()->getScaleFactor (), 1.);
+	EXPECT_TRUE (cache.isCached (b1->getPlatformBitmap ()));
+
+	// the only user of a bitmap takes it over without decoding it again
+	b2 = nullptr;
+	auto b3 = makeOwned<CBitmap> (loadFromPNGData (data));
+	auto misses = cache.getStatistics ().misses;
+	b3->setPlatformBitmapScaleFactor (3.);
+	EXPECT_EQ (b3->getPlatformBitmap ()->getScaleFactor (), 3.);
+	EXPECT_EQ (cache.getStatistics ().misses, misses);
+	EXPECT_TRUE (cache.isCached (b3->getPlatformBitmap ()));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapCache, EvictWhileDrawingOnAnotherThread)
+{
+	auto& cache = CBitmapCache::instance ();
+	auto smallData = createPNGData ({8, 8});
+	auto largeData = createPNGData ({16, 16});
+	auto smallBitmap = makeOwned<CBitmap> (loadFromPNGData (smallData));
+	auto largeBitmap = makeOwned<CBitmap> (loadFromPNGData (largeData));
+	// only one of the bitmaps fits, using one of them evicts the other
+	cache.setMemoryBudget (16u * 16u * 4u);
+
+	constexpr auto kNumIterations = 200;
+	auto numLargeBitmaps = 0;
+	std::thread thread ([&] () {
+		for (auto i = 0; i < kNumIterations; ++i)
+		{
+			auto platformBitmap = largeBitmap->getBestPlatformBitmapForScaleFactor (1.);
+			if (platformBitmap && platformBitmap->getSize () == CPoint (16, 16))
+				++numLargeBitmaps;
+		}
+	});
+	auto numSmallBitmaps = 0;
+	for (auto i = 0; i < kNumIterations; ++i)
+	{
+		auto platformBitmap = smallBitmap->getBestPlatformBitmapForScaleFactor (1.);
+		if (platformBitmap && platformBitmap->getSize () == CPoint (8, 8))
+			++numSmallBitmaps;
+	}
+	thread.join ();
+	EXPECT_EQ (numLargeBitmaps, kNumIterations);
+	EXPECT_EQ (numSmallBitmaps, kNumIterations);
+
+	cache.setMemoryBudget (0);
+	smallBitmap = nullptr;
+	largeBitmap = nullptr;
+	EXPECT_EQ (cache.getStatistics ().residentBytes, 0u);
+}
+
+} // VSTGUI
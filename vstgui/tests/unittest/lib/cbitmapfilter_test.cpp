@@ -0,0 +1,159 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/cbitmapfilter.h"
+#include "../../../lib/ccolor.h"
+#include "../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+using namespace BitmapFilter;
+
+// odd width, so that the filters need to handle the pixels which do not fill a vector
+constexpr uint32_t kWidth = 7;
+constexpr uint32_t kHeight = 3;
+
+//------------------------------------------------------------------------
+CColor testColor (uint32_t index)
+{
+	if (index % 5 == 0)
+		return kRedCColor;
+	return CColor (static_cast<uint8_t> (index * 37), static_cast<uint8_t> (255 - index * 11),
+				   static_cast<uint8_t> (index * 101), 255);
+}
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createBitmap ()
+{
+	auto bitmap = makeOwned<CBitmap> (kWidth, kHeight);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		uint32_t index = 0;
+		do
+		{
+			accessor->setColor (testColor (index++));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+std::vector<CColor> getColors (CBitmap* bitmap)
+{
+	std::vector<CColor> colors;
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		CColor color;
+		do
+		{
+			accessor->getColor (color);
+			colors.emplace_back (color);
+		} while (++(*accessor));
+	}
+	return colors;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<IFilter> createFilter (IdStringPtr name)
+{
+	return owned (Factory::getInstance ().createFilter (name));
+}
+
+//------------------------------------------------------------------------
+class FailingFilter : public FilterBase
+{
+public:
+	FailingFilter () : FilterBase ("A Failing Filter") {}
+
+	bool run (bool replaceInputBitmap) override { return false; }
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterTest, Grayscale)
+{
+	auto bitmap = createBitmap ();
+	auto filter = createFilter (Standard::kGrayscale);
+	filter->setProperty (Standard::Property::kInputBitmap, bitmap.get ());
+	EXPECT (filter->run (true));
+	auto colors = getColors (bitmap);
+	EXPECT_EQ (colors.size (), kWidth * kHeight);
+	for (auto i = 0u; i < colors.size (); ++i)
+	{
+		auto luma = testColor (i).getLuma ();
+		EXPECT_EQ (colors[i], CColor (luma, luma, luma, 255));
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterTest, SetColorIgnoresAlpha)
+{
+	auto bitmap = makeOwned<CBitmap> (kWidth, kHeight);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		uint8_t alpha = 0;
+		do
+		{
+			accessor->setColor (CColor (0, 0, 0, alpha));
+			alpha += 10;
+		} while (++(*accessor));
+	}
+	auto filter = createFilter (Standard::kSetColor);
+	filter->setProperty (Standard::Property::kInputBitmap, bitmap.get ());
+	filter->setProperty (Standard::Property::kInputColor, CColor (10, 20, 30, 40));
+	EXPECT (filter->run (false));
+	auto output =
+		dynamic_cast<CBitmap*> (filter->getProperty (Standard::Property::kOutputBitmap).getObject ());
+	EXPECT (output && output != bitmap);
+	auto colors = getColors (output);
+	for (auto i = 0u; i < colors.size (); ++i)
+		EXPECT_EQ (colors[i], CColor (10, 20, 30, static_cast<uint8_t> (i * 10)));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterTest, RunFiltersFusesPixelFilters)
+{
+	auto replaceColor = createFilter (Standard::kReplaceColor);
+	replaceColor->setProperty (Standard::Property::kInputColor, kRedCColor);
+	replaceColor->setProperty (Standard::Property::kOutputColor, kBlueCColor);
+	auto grayscale = createFilter (Standard::kGrayscale);
+
+	// the filters one after the other
+	auto expected = createBitmap ();
+	replaceColor->setProperty (Standard::Property::kInputBitmap, expected.get ());
+	EXPECT (replaceColor->run (true));
+	grayscale->setProperty (Standard::Property::kInputBitmap, expected.get ());
+	EXPECT (grayscale->run (true));
+
+	auto bitmap = createBitmap ();
+	EXPECT (runFilters (bitmap, {replaceColor, grayscale}));
+	EXPECT (getColors (bitmap) == getColors (expected));
+	auto blueLuma = kBlueCColor.getLuma ();
+	EXPECT_EQ (getColors (bitmap)[0], CColor (blueLuma, blueLuma, blueLuma, 255));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterTest, RunFiltersReplacesPlatformBitmap)
+{
+	auto setColor = createFilter (Standard::kSetColor);
+	setColor->setProperty (Standard::Property::kInputColor, kGreenCColor);
+	auto scale = createFilter (Standard::kScaleLinear);
+	scale->setProperty (Standard::Property::kOutputRect, CRect (0, 0, 2, 2));
+	auto failing = makeOwned<FailingFilter> ();
+
+	auto bitmap = createBitmap ();
+	// the failing filter is skipped, the others are still run
+	EXPECT_FALSE (runFilters (bitmap, {setColor, failing, scale}));
+	EXPECT_EQ (bitmap->getWidth (), 2.);
+	EXPECT_EQ (bitmap->getHeight (), 2.);
+	for (const auto& color : getColors (bitmap))
+		EXPECT_EQ (color, kGreenCColor);
+}
+
+} // VSTGUI
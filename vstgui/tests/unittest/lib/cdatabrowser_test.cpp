@@ -0,0 +1,91 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/idatabrowserdelegate.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class Delegate : public DataBrowserDelegateAdapter, public NonAtomicReferenceCounted
+{
+public:
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return 100; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 1; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 10.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		return 100.;
+	}
+	void dbSelectionChanged (CDataBrowser* browser) override { ++numSelectionChanges; }
+	void dbDrawCell (CDrawContext* drawContext, const CRect& size, int32_t row, int32_t column,
+					 int32_t flags, CDataBrowser* browser) override
+	{
+	}
+
+	uint32_t numSelectionChanges {0};
+};
+
+//------------------------------------------------------------------------
+SharedPointer<CDataBrowser> createBrowser (Delegate* delegate)
+{
+	auto browser = makeOwned<CDataBrowser> (CRect (0, 0, 100, 100), delegate,
+											CDataBrowser::kMultiSelectionStyle);
+	browser->recalculateLayout (true);
+	return browser;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, UnselectRowKeepsSelectionOrder)
+{
+	auto delegate = makeOwned<Delegate> ();
+	auto browser = createBrowser (delegate);
+	for (auto row : {7, 1, 5, 3, 9})
+		browser->selectRow (row);
+	browser->unselectRow (7);
+	browser->unselectRow (3);
+	EXPECT_FALSE (browser->isRowSelected (7));
+	EXPECT_FALSE (browser->isRowSelected (3));
+	EXPECT_TRUE (browser->isRowSelected (5));
+	EXPECT_EQ (browser->getSelectedRow (), 1);
+	EXPECT_EQ (browser->getSelection (), CDataBrowser::Selection ({1, 5, 9}));
+	EXPECT_EQ (delegate->numSelectionChanges, 7u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, ReselectedRowMovesToTheEnd)
+{
+	auto delegate = makeOwned<Delegate> ();
+	auto browser = createBrowser (delegate);
+	for (auto row : {1, 2, 3, 4})
+		browser->selectRow (row);
+	browser->unselectRow (2);
+	browser->selectRow (2);
+	browser->unselectRow (4);
+	EXPECT_TRUE (browser->isRowSelected (2));
+	EXPECT_EQ (browser->getSelection (), CDataBrowser::Selection ({1, 3, 2}));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, UnselectAllAfterUnselectRow)
+{
+	auto delegate = makeOwned<Delegate> ();
+	auto browser = createBrowser (delegate);
+	for (auto row : {1, 2, 3, 4})
+		browser->selectRow (row);
+	browser->unselectRow (1);
+	browser->unselectAll ();
+	EXPECT_EQ (browser->getSelectedRow (), CDataBrowser::kNoSelection);
+	EXPECT_TRUE (browser->getSelection ().empty ());
+	EXPECT_EQ (delegate->numSelectionChanges, 6u);
+	browser->unselectAll ();
+	EXPECT_EQ (delegate->numSelectionChanges, 6u);
+}
+
+} // VSTGUI
@@ -0,0 +1,29 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdrawcontext.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+TEST_CASE (CDrawContextTest, RestoreGlobalStateRestoresQualities)
+{
+	auto drawContext = COffscreenContext::create ({10., 10.});
+	if (!drawContext)
+		return;
+	drawContext->beginDraw ();
+	drawContext->setAntialiasQuality (AntialiasQuality::kBest);
+	drawContext->setBitmapInterpolationQuality (BitmapInterpolationQuality::kHigh);
+	drawContext->saveGlobalState ();
+	drawContext->setAntialiasQuality (AntialiasQuality::kFast);
+	drawContext->setBitmapInterpolationQuality (BitmapInterpolationQuality::kLow);
+	drawContext->restoreGlobalState ();
+	EXPECT (drawContext->getAntialiasQuality () == AntialiasQuality::kBest);
+	EXPECT (drawContext->getBitmapInterpolationQuality () == BitmapInterpolationQuality::kHigh);
+	drawContext->endDraw ();
+}
+
+} // VSTGUI
@@ -0,0 +1,112 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdrawprofiler.h"
+#include "../../../lib/cview.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct ChildView : CView
+{
+	ChildView () : CView (CRect (0, 0, 10, 10)) {}
+};
+
+//------------------------------------------------------------------------
+struct ParentView : CView
+{
+	ParentView () : CView (CRect (0, 0, 10, 10)) {}
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CDrawProfiler, RingBufferKeepsLatestFrames)
+{
+	auto profiler = makeOwned<CDrawProfiler> (3);
+	EXPECT_EQ (profiler->getNumFrames (), 0u);
+	for (auto i = 0; i < 5; ++i)
+	{
+		profiler->onInvalidRect (CRect (0, 0, 10, 10));
+		profiler->onInvalidRect (CRect (0, 0, 5, 2));
+		profiler->beginFrame (CRect (0, 0, 10, 10));
+		profiler->endFrame ();
+	}
+	EXPECT_EQ (profiler->getNumFrames (), 3u);
+	EXPECT_EQ (profiler->getFrame (0).index, 2u);
+	EXPECT_EQ (profiler->getLastFrame ().index, 4u);
+	EXPECT_EQ (profiler->getLastFrame ().numInvalidations, 2u);
+	EXPECT_EQ (profiler->getLastFrame ().invalidArea, 110.);
+
+	profiler->clear ();
+	EXPECT_EQ (profiler->getNumFrames (), 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDrawProfiler, ViewClassTimes)
+{
+	auto profiler = makeOwned<CDrawProfiler> ();
+	auto parent = makeOwned<ParentView> ();
+	auto child = makeOwned<ChildView> ();
+
+	profiler->beginFrame (CRect (0, 0, 10, 10));
+	profiler->beginView (parent);
+	profiler->beginView (child);
+	{
+		CDrawProfiler::Scope scope (profiler, CDrawProfiler::Category::Text);
+	}
+	profiler->endView ();
+	profiler->beginView (child);
+	{
+		CDrawProfiler::Scope scope (profiler, CDrawProfiler::Category::Bitmap);
+	}
+	profiler->endView ();
+	profiler->endView ();
+	profiler->endFrame ();
+
+	const auto& frame = profiler->getLastFrame ();
+	EXPECT_EQ (frame.numViewsDrawn, 3u);
+	EXPECT_EQ (frame.numTextCalls, 1u);
+	EXPECT_EQ (frame.numBitmapCalls, 1u);
+	EXPECT_EQ (frame.viewClassTimes.size (), 2u);
+	EXPECT_EQ (frame.viewEvents.size (), 3u);
+
+	double exclusiveSum = 0.;
+	for (const auto& classTime : frame.viewClassTimes)
+	{
+		EXPECT_EQ (classTime.count,
+				   classTime.className.find ("ChildView") != std::string::npos ? 2u : 1u);
+		exclusiveSum += classTime.duration;
+	}
+	// the exclusive class times must not count the child views twice
+	EXPECT (exclusiveSum <= frame.duration);
+
+	// operations outside of a frame are not recorded
+	{
+		CDrawProfiler::Scope scope (profiler, CDrawProfiler::Category::Text);
+	}
+	EXPECT_EQ (profiler->getLastFrame ().numTextCalls, 1u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDrawProfiler, ChromeTrace)
+{
+	auto profiler = makeOwned<CDrawProfiler> ();
+	auto view = makeOwned<ChildView> ();
+	profiler->beginFrame (CRect (0, 0, 10, 10));
+	profiler->beginView (view);
+	profiler->endView ();
+	profiler->endFrame ();
+
+	auto trace = profiler->createChromeTrace ();
+	EXPECT_EQ (trace.find ("{\"traceEvents\":["), 0u);
+	EXPECT_NE (trace.find ("\"name\":\"Frame 0\""), std::string::npos);
+	EXPECT_NE (trace.find ("ChildView"), std::string::npos);
+	EXPECT_NE (trace.find ("\"ph\":\"X\""), std::string::npos);
+}
+
+} // VSTGUI
@@ -2,12 +2,16 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "../../../lib/cbitmap.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/cframe.h"
+#include "../../../lib/controls/ccontrol.h"
+#include "../../../lib/coffscreencontext.h"
 #include "../../../lib/events.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
 #include "platform_helper.h"
+#include <algorithm>
 #include <vector>
 
 namespace VSTGUI {
@@ -637,6 +641,168 @@ TEST_CASE (CFrameTest, SetPosition)
 	frame->close ();
 }
 
+TEST_CASE (CFrameTest, CoalescedMousePositionsAreTransformed)
+{
+	struct MoveView : CView
+	{
+		using CView::CView;
+		void onMouseMoveEvent (MouseMoveEvent& event) override
+		{
+			for (auto i = 0u; i < event.numCoalescedPositions; ++i)
+			{
+				CPoint p (event.coalescedPositions[i]);
+				getParentView ()->translateToLocal (p, true);
+				positions.push_back (p);
+			}
+			mousePosition = event.mousePosition;
+			event.consumed = true;
+		}
+		std::vector<CPoint> positions;
+		CPoint mousePosition;
+	};
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new CViewContainer (CRect (10, 10, 100, 100));
+	auto view = new MoveView (CRect (0, 0, 50, 50));
+	container->addView (view);
+	frame->addView (container);
+	frame->attached (frame);
+	EXPECT (frame->setZoom (2.));
+
+	CPoint coalescedPositions[] = {{22., 22.}, {24., 26.}};
+	MouseMoveEvent event ({30., 30.});
+	event.coalescedPositions = coalescedPositions;
+	event.numCoalescedPositions = 2;
+	frame->dispatchEvent (event);
+	EXPECT (event.consumed);
+	EXPECT_EQ (view->mousePosition, CPoint (15., 15.));
+	EXPECT_EQ (view->positions.size (), 2u);
+	EXPECT_EQ (view->positions[0], CPoint (11., 11.));
+	EXPECT_EQ (view->positions[1], CPoint (12., 13.));
+	frame->removed (nullptr);
+}
+
+TEST_CASE (CFrameTest, OpenHeadless)
+{
+	struct DrawCountView : CView
+	{
+		DrawCountView () : CView (CRect (10, 10, 20, 20)) {}
+		void draw (CDrawContext* context) override { ++drawCount; }
+		uint32_t drawCount {0};
+	};
+
+	auto frame = new CFrame (CRect (0, 0, 100, 50), nullptr);
+	auto view = new DrawCountView ();
+	frame->addView (view);
+	EXPECT (frame->openHeadless (2.));
+	EXPECT (frame->isAttached ());
+	EXPECT (view->isAttached ());
+	EXPECT (frame->openHeadless () == false);
+	EXPECT_EQ (frame->getScaleFactor (), 2.);
+
+	auto bitmap = frame->renderOffscreen ();
+	EXPECT (bitmap);
+	EXPECT_EQ (bitmap->getWidth (), 100.);
+	EXPECT_EQ (bitmap->getHeight (), 50.);
+	EXPECT_EQ (view->drawCount, 1u);
+	frame->close ();
+}
+
+TEST_CASE (CFrameTest, DrawConcurrently)
+{
+	struct DirtyView : CView
+	{
+		DirtyView (const CRect& r) : CView (r) {}
+		void draw (CDrawContext* context) override
+		{
+			drawnConcurrently = isDrawingConcurrently ();
+			setDirty (false);
+		}
+		bool drawnConcurrently {false};
+	};
+
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	auto view1 = new DirtyView (CRect (0, 0, 50, 50));
+	auto view2 = new DirtyView (CRect (50, 50, 100, 100));
+	frame->addView (view1);
+	frame->addView (view2);
+	EXPECT (frame->openHeadless ());
+	auto platformFrameCallback = dynamic_cast<IPlatformFrameCallback*> (frame);
+	// view1 crosses the first two rects, view2 is in the third, no view is in the fourth
+	std::vector<CRect> rects = {CRect (0, 0, 40, 40), CRect (40, 0, 80, 40),
+								CRect (60, 60, 100, 100), CRect (0, 60, 40, 100)};
+	std::vector<int32_t> groups;
+	EXPECT_EQ (platformFrameCallback->platformPrepareConcurrentDraw (rects, groups), 0u);
+	EXPECT_EQ (groups.size (), 4u);
+	EXPECT (std::all_of (groups.begin (), groups.end (), [] (int32_t g) { return g == -1; }));
+	frame->setThreadSafeDrawing (true);
+	view1->setThreadSafeDrawing (true);
+	EXPECT_EQ (platformFrameCallback->platformPrepareConcurrentDraw (rects, groups), 2u);
+	EXPECT (groups[0] >= 0);
+	EXPECT_EQ (groups[0], groups[1]);
+	EXPECT_EQ (groups[2], -1);
+	EXPECT (groups[3] >= 0);
+	EXPECT (groups[3] != groups[0]);
+
+	// the dirty state is only reset on the main thread
+	view1->setDirty (true);
+	auto drawContext = COffscreenContext::create ({100, 100});
+	drawContext->beginDraw ();
+	platformFrameCallback->platformDrawRectConcurrently (drawContext, rects[0]);
+	platformFrameCallback->platformDrawRectConcurrently (drawContext, rects[1]);
+	drawContext->endDraw ();
+	EXPECT (view1->drawnConcurrently);
+	EXPECT (view1->isDirty ());
+	EXPECT (CView::isDrawingConcurrently () == false);
+	platformFrameCallback->platformDidDrawConcurrently ();
+	EXPECT (view1->isDirty () == false);
+	frame->close ();
+}
+
+TEST_CASE (CFrameTest, EventDrivenIdle)
+{
+	struct Control : CControl
+	{
+		Control () : CControl (CRect (20, 20, 40, 40)) {}
+		void draw (CDrawContext* context) override {}
+		CLASS_METHODS (Control, CControl)
+	};
+
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	auto view = new View ();
+	auto control = new Control ();
+	frame->addView (view);
+	frame->addView (control);
+	EXPECT (frame->openHeadless ());
+	frame->setEventDrivenIdle (true);
+	EXPECT (frame->isEventDrivenIdle ());
+
+	auto& counters = CView::getIdleCounters ();
+	uint64_t checks = counters.dirtyViewChecks;
+	frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 1);
+	// no work is done while nothing changes
+	for (auto i = 0; i < 10; ++i)
+		frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 1);
+
+	view->setDirty (true);
+	frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 2);
+	frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 2);
+
+	control->setValue (0.5f);
+	frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 3);
+
+	// without the event driven mode every idle checks the views
+	frame->setEventDrivenIdle (false);
+	frame->idle ();
+	frame->idle ();
+	EXPECT_EQ (counters.dirtyViewChecks, checks + 5);
+	frame->close ();
+}
+
 #if 0
 TEST_CASE (CFrameTest, CollectInvalidRectsOnMouseDown)
 {
@@ -117,6 +117,81 @@ TEST_CASE (CListControlTest, RowRect)
 	}
 }
 
+TEST_CASE (CListControlTest, VariableRowHeights)
+{
+	struct Configurator : StaticListControlConfigurator
+	{
+		Configurator () : StaticListControlConfigurator (10.) {}
+		CListControlRowDesc getRowDesc (int32_t row) const override
+		{
+			return {getRowHeight () * (row + 1), getFlags ()};
+		}
+	};
+
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	listControl->setMin (0.f);
+	listControl->setMax (3.f);
+	listControl->setConfigurator (makeOwned<Configurator> ());
+	EXPECT_EQ (listControl->getHeight (), 100.);
+
+	auto rr = listControl->getRowRect (2);
+	EXPECT (rr);
+	if (rr)
+	{
+		EXPECT_EQ (*rr, CRect (0, 30, 100, 60));
+	}
+	EXPECT_EQ (*listControl->getRowAtPoint (CPoint (0, 0)), 0);
+	EXPECT_EQ (*listControl->getRowAtPoint (CPoint (0, 29)), 1);
+	EXPECT_EQ (*listControl->getRowAtPoint (CPoint (0, 30)), 2);
+	EXPECT_EQ (*listControl->getRowAtPoint (CPoint (0, 99)), 3);
+	EXPECT_FALSE (listControl->getRowAtPoint (CPoint (0, 100)));
+}
+
+TEST_CASE (CListControlTest, UniformRowHeightIsExplicit)
+{
+	auto configurator = makeOwned<StaticListControlConfigurator> (10.);
+	EXPECT_FALSE (configurator->getUniformRowHeight ());
+	configurator->setUniformRowHeight (true);
+	EXPECT_TRUE (configurator->hasUniformRowHeight ());
+	EXPECT_EQ (*configurator->getUniformRowHeight (), 10.);
+	configurator->setRowHeight (12.);
+	EXPECT_EQ (*configurator->getUniformRowHeight (), 12.);
+}
+
+TEST_CASE (CListControlTest, UniformRowsAreQueriedLazily)
+{
+	struct Configurator : StaticListControlConfigurator
+	{
+		Configurator () : StaticListControlConfigurator (10.) {}
+		Optional<CCoord> getUniformRowHeight () const override { return makeOptional (getRowHeight ()); }
+		CListControlRowDesc getRowDesc (int32_t row) const override
+		{
+			++numQueries;
+			return StaticListControlConfigurator::getRowDesc (row);
+		}
+		mutable uint32_t numQueries {0};
+	};
+
+	auto configurator = makeOwned<Configurator> ();
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	listControl->setMin (0.f);
+	listControl->setMax (99999.f);
+	listControl->setConfigurator (configurator);
+	EXPECT_EQ (configurator->numQueries, 0u);
+	EXPECT_EQ (listControl->getHeight (), 1000000.);
+	EXPECT_EQ (*listControl->getRowAtPoint (CPoint (0, 500005)), 50000);
+	auto rr = listControl->getRowRect (99999);
+	EXPECT (rr);
+	if (rr)
+	{
+		EXPECT_EQ (*rr, CRect (0, 999990, 100, 1000000));
+	}
+
+	dispatchMouseEvent<MouseMoveEvent> (listControl, {10., 55.});
+	EXPECT_EQ (*listControl->getHoveredRow (), 5);
+	EXPECT (configurator->numQueries < 5u);
+}
+
 TEST_CASE (CListControlTest, KeyDownOnUnselectableRows)
 {
 	constexpr auto rowHeight = 20;
@@ -0,0 +1,69 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/cbitmap.h"
+#include "../../../../lib/controls/cbuttons.h"
+#include "../../../../lib/controls/cswitch.h"
+#include "../../../../lib/platform/platformfactory.h"
+#include "../../unittests.h"
+#include "../eventhelpers.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+SharedPointer<CMultiFrameBitmap> createGridBitmap ()
+{
+	// 4 frames of 10 x 10 in a 2 x 2 grid
+	CMultiFrameBitmapDescription desc;
+	desc.frameSize = {10, 10};
+	desc.numFrames = 4;
+	desc.framesPerRow = 2;
+	return makeOwned<CMultiFrameBitmap> (getPlatformFactory ().createBitmap ({20, 20}), desc);
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CSwitchTest, VerticalSwitchUsesMultiFrameBitmap)
+{
+	auto bitmap = createGridBitmap ();
+	auto s = owned (new CVerticalSwitch (CRect (0, 0, 10, 10), nullptr, 0, bitmap));
+	EXPECT_EQ (s->getNumSubPixmaps (), 4);
+	EXPECT_EQ (s->getHeightOfOneImage (), 10.);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CSwitchTest, HorizontalSwitchUsesFrameGrid)
+{
+	auto bitmap = createGridBitmap ();
+	auto s = owned (new CHorizontalSwitch (CRect (0, 0, 10, 10), nullptr, 0, bitmap));
+	EXPECT_EQ (s->getNumSubPixmaps (), 4);
+	EXPECT_EQ (s->getHeightOfOneImage (), 10.);
+
+	// each position is a quarter of the frame width, not of the bitmap width
+	EXPECT_EQ (dispatchMouseEvent<MouseDownEvent> (s, {8., 5.}, MouseButton::Left),
+			   EventConsumeState::Handled);
+	EXPECT_EQ (s->getValueNormalized (), 1.f);
+	dispatchMouseEvent<MouseUpEvent> (s, {8., 5.}, MouseButton::Left);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CSwitchTest, KickButtonUsesMultiFrameBitmap)
+{
+	CMultiFrameBitmapDescription desc;
+	desc.frameSize = {10, 8};
+	desc.numFrames = 2;
+	desc.framesPerRow = 2;
+	auto bitmap =
+		makeOwned<CMultiFrameBitmap> (getPlatformFactory ().createBitmap ({20, 8}), desc);
+	auto b = owned (new CKickButton (CRect (0, 0, 10, 10), nullptr, 0, bitmap));
+	EXPECT_EQ (b->getHeightOfOneImage (), 8.);
+	EXPECT_EQ (b->getNumSubPixmaps (), 2);
+	EXPECT_TRUE (b->sizeToFit ());
+	EXPECT_EQ (b->getViewSize (), CRect (0, 0, 10, 8));
+}
+
+} // VSTGUI
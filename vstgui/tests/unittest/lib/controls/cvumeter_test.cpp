@@ -0,0 +1,182 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/cbitmap.h"
+#include "../../../../lib/cframe.h"
+#include "../../../../lib/controls/cvumeter.h"
+#include "../../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class InvalidRectRecorder : public CViewContainer
+{
+public:
+	using CViewContainer::CViewContainer;
+
+	void invalidRect (const CRect& rect) override { rects.push_back (rect); }
+
+	std::vector<CRect> rects;
+};
+
+//------------------------------------------------------------------------
+CVuMeter* createMeter (const CRect& size)
+{
+	auto onBitmap = makeOwned<CBitmap> (size.getWidth (), size.getHeight ());
+	auto offBitmap = makeOwned<CBitmap> (size.getWidth (), size.getHeight ());
+	auto meter = new CVuMeter (size, onBitmap, offBitmap, 10, CVuMeter::kVertical);
+	meter->setDecreaseStepValue (0.1f);
+	return meter;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CVuMeterTest, InvalidateOnlyChangedLeds)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new InvalidRectRecorder (CRect (0, 0, 100, 100));
+	auto meter = createMeter (CRect (0, 0, 10, 100));
+	container->addView (meter);
+	frame->addView (container);
+	frame->attached (frame);
+
+	meter->setValue (1.f);
+	meter->setOldValue (1.f);
+	meter->onIdle ();
+	EXPECT (container->rects.empty ());
+
+	meter->setValue (0.5f);
+	meter->onIdle ();
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 0, 10, 10));
+
+	container->rects.clear ();
+	meter->onIdle ();
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 10, 10, 20));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CVuMeterTest, PeakHold)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new InvalidRectRecorder (CRect (0, 0, 100, 100));
+	auto meter = createMeter (CRect (0, 0, 10, 100));
+	container->addView (meter);
+	frame->addView (container);
+	frame->attached (frame);
+
+	meter->setValue (1.f);
+	meter->setOldValue (1.f);
+	meter->setPeakHoldTime (1000000);
+	EXPECT_EQ (meter->getPeakValue (), 1.f);
+
+	meter->setValue (0.f);
+	meter->onIdle ();
+	EXPECT_EQ (meter->getPeakValue (), 1.f);
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 0, 10, 10));
+
+	// the peak LED stays lit, only the LED below it changes
+	container->rects.clear ();
+	meter->onIdle ();
+	EXPECT_EQ (meter->getPeakValue (), 1.f);
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 10, 10, 20));
+
+	container->rects.clear ();
+	meter->resetPeak ();
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 0, 10, 10));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CVuMeterTest, IdleOnlyWhileDecaying)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new InvalidRectRecorder (CRect (0, 0, 100, 100));
+	auto meter = createMeter (CRect (0, 0, 10, 100));
+	meter->setValue (0.f);
+	meter->setOldValue (0.f);
+	container->addView (meter);
+	frame->addView (container);
+	frame->attached (frame);
+	EXPECT_FALSE (meter->wantsIdle ());
+	// a meter at rest does not keep the idle timer running
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	meter->setValue (0.f);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+
+	// a rising value is shown when the frame picks up the dirty meter, without idle
+	meter->setValue (0.5f);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	EXPECT (meter->isDirty ());
+	frame->idle ();
+	EXPECT_FALSE (meter->isDirty ());
+	EXPECT_EQ (meter->getOldValue (), 0.5f);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+
+	// the setter may be called from any thread, the decay starts on the main thread
+	meter->setValue (0.2f);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	frame->idle ();
+	EXPECT (CView::isIdleTimerRunning ());
+	container->removeView (meter);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CVuMeterTest, SetDirtyOnMainThread)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new InvalidRectRecorder (CRect (0, 0, 100, 100));
+	auto meter = createMeter (CRect (0, 0, 10, 100));
+	meter->setValue (0.5f);
+	meter->setOldValue (0.5f);
+	container->addView (meter);
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto oldDirtyCallAlwaysOnMainThread = CView::kDirtyCallAlwaysOnMainThread;
+	CView::kDirtyCallAlwaysOnMainThread = true;
+	meter->setValue (0.2f);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	meter->setDirty (true);
+	EXPECT (CView::isIdleTimerRunning ());
+	CView::kDirtyCallAlwaysOnMainThread = oldDirtyCallAlwaysOnMainThread;
+	container->removeView (meter);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CVuMeterTest, BatchUpdate)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new InvalidRectRecorder (CRect (0, 0, 100, 100));
+	CVuMeter* meters[] = {createMeter (CRect (0, 0, 10, 100)), createMeter (CRect (20, 0, 30, 100))};
+	for (auto meter : meters)
+	{
+		container->addView (meter);
+		meter->setValue (0.f);
+		meter->setOldValue (0.f);
+	}
+	frame->addView (container);
+	frame->attached (frame);
+
+	float values[] = {0.5f, 0.3f};
+	CVuMeter::setValues (meters, values, 2);
+	EXPECT_EQ (meters[0]->getOldValue (), 0.5f);
+	EXPECT_EQ (meters[1]->getOldValue (), 0.3f);
+	EXPECT_EQ (container->rects.size (), 1u);
+	EXPECT_EQ (container->rects[0], CRect (0, 50, 30, 100));
+
+	container->rects.clear ();
+	CVuMeter::setValues (meters, values, 2);
+	EXPECT (container->rects.empty ());
+}
+
+} // VSTGUI
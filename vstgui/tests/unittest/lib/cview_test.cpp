@@ -2,6 +2,7 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "../../../lib/cbitmap.h"
 #include "../../../lib/cstring.h"
 #include "../../../lib/cgraphicspath.h"
 #include "../../../lib/coffscreencontext.h"
@@ -17,6 +18,7 @@
 #include <CoreFoundation/CoreFoundation.h>
 #endif
 
+#include <algorithm>
 #include <array>
 
 namespace VSTGUI {
@@ -158,6 +160,77 @@ TEST_CASE (CViewTest, ResizeAttribute)
 	EXPECT (secondData == 32);
 }
 
+TEST_CASE (CViewTest, ManyAttributes)
+{
+	auto v = owned (new View ());
+	// small attributes are stored inline, large ones on the heap
+	std::array<uint8_t, 64> largeData;
+	for (auto i = 0u; i < largeData.size (); ++i)
+		largeData[i] = static_cast<uint8_t> (i);
+	for (CViewAttributeID id = 20; id > 0; --id)
+	{
+		auto result = (id % 2) ? v->setAttribute (id, id)
+							   : v->setAttribute (id, id * 3, largeData.data ());
+		EXPECT (result);
+	}
+	EXPECT (v->removeAttribute (5));
+	EXPECT (v->removeAttribute (6));
+	for (CViewAttributeID id = 1; id <= 20; ++id)
+	{
+		uint32_t size = 0;
+		EXPECT (v->getAttributeSize (id, size) == (id != 5 && id != 6));
+		if (id == 5 || id == 6)
+			continue;
+		if (id % 2)
+		{
+			CViewAttributeID value = 0;
+			EXPECT (v->getAttribute (id, value));
+			EXPECT_EQ (value, id);
+		}
+		else
+		{
+			std::array<uint8_t, 64> data {};
+			uint32_t outSize = 0;
+			EXPECT (v->getAttribute (id, static_cast<uint32_t> (data.size ()), data.data (), outSize));
+			EXPECT_EQ (outSize, id * 3);
+			EXPECT (std::equal (data.begin (), data.begin () + outSize, largeData.begin ()));
+		}
+	}
+	// a copy of the view has the same attributes
+	auto copy = owned (new View (*v));
+	uint32_t size = 0;
+	EXPECT (copy->getAttributeSize (20, size));
+	EXPECT_EQ (size, 60u);
+	EXPECT_FALSE (copy->getAttributeSize (5, size));
+}
+
+TEST_CASE (CViewTest, HotProperties)
+{
+	auto v = owned (new View ());
+	EXPECT_EQ (v->getAlphaValue (), 1.f);
+	v->setAlphaValue (0.25f);
+	EXPECT_EQ (v->getAlphaValue (), 0.25f);
+	EXPECT (v->getMouseableArea () == v->getViewSize ());
+	v->setMouseableArea (CRect (2, 2, 5, 5));
+	EXPECT (v->getMouseableArea () == CRect (2, 2, 5, 5));
+	auto bitmap = makeOwned<CBitmap> (10., 10.);
+	v->setBackground (bitmap);
+	EXPECT (v->getBackground () == bitmap);
+	EXPECT (v->getDrawBackground () == bitmap);
+	auto disabledBitmap = makeOwned<CBitmap> (10., 10.);
+	v->setDisabledBackground (disabledBitmap);
+	v->setMouseEnabled (false);
+	EXPECT (v->getDrawBackground () == disabledBitmap);
+
+	auto copy = owned (new View (*v));
+	EXPECT_EQ (copy->getAlphaValue (), 0.25f);
+	EXPECT (copy->getMouseableArea () == CRect (2, 2, 5, 5));
+	EXPECT (copy->getBackground () == bitmap);
+	EXPECT (copy->getDisabledBackground () == disabledBitmap);
+	v->setBackground (nullptr);
+	EXPECT (v->getBackground () == nullptr);
+}
+
 TEST_CASE (CViewTest, ViewListener)
 {
 	ViewListener listener;
@@ -483,6 +556,25 @@ TEST_CASE (CViewTest, ViewEventListenerKeyEvent)
 	EXPECT_TRUE (v->eventCalled (EventType::KeyUp));
 }
 
+TEST_CASE (CViewTest, RequestIdle)
+{
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (50, 50, 100, 100)));
+	auto v = new View ();
+	container->addView (v);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	// only attached views can request idle
+	v->requestIdle ();
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	container->attached (parent);
+	v->requestIdle ();
+	v->requestIdle ();
+	EXPECT (CView::isIdleTimerRunning ());
+	container->removeView (v);
+	EXPECT_FALSE (CView::isIdleTimerRunning ());
+	container->removed (parent);
+}
+
 #if MAC // TODO: Make test work on other platforms too.
 
 TEST_CASE (CViewTest, IdleAfterAttached)
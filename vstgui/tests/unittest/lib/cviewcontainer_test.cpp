@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
@@ -638,4 +639,286 @@ TEST_CASE (CViewContainerTest, GetContainerAt)
 	EXPECT (res == c1);
 }
 
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, InvalidateDirtyDescendants)
+{
+	struct DirtyCheckView : CView
+	{
+		DirtyCheckView () : CView (CRect (0, 0, 10, 10)) {}
+		bool isDirty () const override
+		{
+			++numChecks;
+			return CView::isDirty ();
+		}
+		void invalid () override { ++numInvalids; }
+
+		mutable uint32_t numChecks {0};
+		uint32_t numInvalids {0};
+	};
+
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto dirtyBranch = new CViewContainer (CRect (0, 0, 50, 50));
+	auto cleanBranch = new CViewContainer (CRect (50, 50, 100, 100));
+	auto dirtyView = new DirtyCheckView ();
+	auto cleanView = new DirtyCheckView ();
+	dirtyBranch->addView (dirtyView);
+	cleanBranch->addView (cleanView);
+	container->addView (dirtyBranch);
+	container->addView (cleanBranch);
+	container->attached (parent);
+	container->invalidateDirtyDescendants ();
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+
+	dirtyView->numInvalids = cleanView->numChecks = 0;
+	dirtyView->setDirty (true);
+	EXPECT (dirtyBranch->hasDirtyDescendant ());
+	EXPECT (container->hasDirtyDescendant ());
+	EXPECT_FALSE (cleanBranch->hasDirtyDescendant ());
+
+	// the clean branch is not visited
+	container->invalidateDirtyDescendants ();
+	EXPECT_EQ (dirtyView->numInvalids, 1u);
+	EXPECT_EQ (cleanView->numChecks, 0u);
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+	EXPECT_FALSE (dirtyBranch->hasDirtyDescendant ());
+
+	container->removed (parent);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, InvalidateDirtyDescendantsResetsInvisibleChild)
+{
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto branch = new CViewContainer (CRect (0, 0, 50, 50));
+	auto view = new CView (CRect (0, 0, 10, 10));
+	branch->addView (view);
+	container->addView (branch);
+	container->attached (parent);
+
+	view->setDirty (true);
+	branch->setVisible (false);
+	container->invalidateDirtyDescendants ();
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+	EXPECT_FALSE (branch->hasDirtyDescendant ());
+
+	// a later change in the branch must reach the container again
+	branch->setVisible (true);
+	view->setDirty (true);
+	EXPECT (container->hasDirtyDescendant ());
+
+	container->removed (parent);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, InvalidateDirtyDescendantsResetsDirtyContainer)
+{
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto branch = new CViewContainer (CRect (0, 0, 50, 50));
+	auto view = new CView (CRect (0, 0, 10, 10));
+	branch->addView (view);
+	container->addView (branch);
+	container->attached (parent);
+
+	view->setDirty (true);
+	container->setDirty (true);
+	container->invalidateDirtyDescendants ();
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+	EXPECT_FALSE (branch->hasDirtyDescendant ());
+
+	container->setDirty (false);
+	view->setDirty (true);
+	EXPECT (container->hasDirtyDescendant ());
+
+	container->removed (parent);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, DirtyDescendantMovesWithReaddedContainer)
+{
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto first = new CViewContainer (CRect (0, 0, 50, 50));
+	auto second = new CViewContainer (CRect (50, 50, 100, 100));
+	auto branch = new CViewContainer (CRect (0, 0, 20, 20));
+	auto view = new CView (CRect (0, 0, 10, 10));
+	branch->addView (view);
+	first->addView (branch);
+	container->addView (first);
+	container->addView (second);
+	container->attached (parent);
+
+	view->setDirty (true);
+	first->removeView (branch, false);
+	container->invalidateDirtyDescendants ();
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+	EXPECT_FALSE (first->hasDirtyDescendant ());
+
+	// the marked branch is found in its new place
+	second->addView (branch);
+	EXPECT (second->hasDirtyDescendant ());
+	EXPECT (container->hasDirtyDescendant ());
+	container->invalidateDirtyDescendants ();
+	EXPECT_FALSE (branch->hasDirtyDescendant ());
+	EXPECT_FALSE (container->hasDirtyDescendant ());
+
+	view->setDirty (true);
+	EXPECT (second->hasDirtyDescendant ());
+	EXPECT (container->hasDirtyDescendant ());
+
+	container->removed (parent);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, AddAndRemoveViewsWhileIterating)
+{
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	CView* views[6];
+	for (auto& view : views)
+		view = new CView (CRect (0, 0, 10, 10));
+	for (auto i = 0u; i < 4; ++i)
+		container->addView (views[i]);
+
+	std::vector<CView*> visited;
+	container->forEachChild ([&] (CView* view) {
+		visited.emplace_back (view);
+		if (view != views[1])
+			return;
+		// remove the current view and the next one, insert one before and one after the
+		// current view
+		container->removeView (views[1]);
+		container->removeView (views[2]);
+		container->addView (views[4], views[0]);
+		container->addView (views[5]);
+		EXPECT_EQ (container->getNbViews (), 4u);
+		EXPECT_FALSE (container->isChild (views[2]));
+		EXPECT_EQ (container->getView (1), views[0]);
+	});
+	EXPECT_EQ (visited.size (), 4u);
+	EXPECT_EQ (visited[0], views[0]);
+	EXPECT_EQ (visited[1], views[1]);
+	EXPECT_EQ (visited[2], views[3]);
+	EXPECT_EQ (visited[3], views[5]);
+
+	EXPECT_EQ (container->getNbViews (), 4u);
+	EXPECT_EQ (container->getView (0), views[4]);
+	EXPECT_EQ (container->getView (1), views[0]);
+	EXPECT_EQ (container->getView (2), views[3]);
+	EXPECT_EQ (container->getView (3), views[5]);
+	EXPECT (container->changeViewZOrder (views[4], 3));
+	EXPECT_EQ (container->getView (2), views[5]);
+	EXPECT_EQ (container->getView (3), views[4]);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, GetViewAtFollowsChildBounds)
+{
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto v1 = new TestView1 ();
+	auto v2 = new TestView2 ();
+	container->addView (v1);
+	container->addView (v2);
+	container->attached (parent);
+	EXPECT_EQ (container->getViewAt (CPoint (5, 5)), v1);
+	EXPECT_EQ (container->getViewAt (CPoint (15, 15)), v2);
+
+	v1->setViewSize (CRect (50, 50, 60, 60));
+	v1->setMouseableArea (v1->getViewSize ());
+	EXPECT_EQ (container->getViewAt (CPoint (5, 5)), nullptr);
+	EXPECT_EQ (container->getViewAt (CPoint (55, 55)), v1);
+
+	v2->setMouseableArea (CRect (10, 10, 15, 15));
+	EXPECT_EQ (container->getViewAt (CPoint (17, 17)), nullptr);
+	EXPECT_EQ (container->getViewAt (CPoint (12, 12)), v2);
+
+	auto v3 = new TestView1 ();
+	container->addView (v3, v2);
+	EXPECT_EQ (container->getViewAt (CPoint (5, 5)), v3);
+
+	container->removed (parent);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, GetChildrenAsList)
+{
+	struct Container : CViewContainer
+	{
+		using CViewContainer::CViewContainer;
+		using CViewContainer::getChildren;
+	};
+	auto container = owned (new Container (CRect (0, 0, 100, 100)));
+	auto v1 = new TestView1 ();
+	auto v2 = new TestView2 ();
+	container->addView (v1);
+	container->addView (v2);
+	const CViewContainer::ViewList& children = container->getChildren ();
+	EXPECT_EQ (children.size (), 2u);
+	EXPECT_EQ (children.front (), v1);
+	EXPECT_EQ (children.back (), v2);
+
+	// the list follows the changes of the children
+	auto v3 = new TestView1 ();
+	container->addView (v3, v2);
+	EXPECT_EQ (children.size (), 3u);
+	EXPECT_EQ (*std::next (children.begin ()), v3);
+	EXPECT (container->changeViewZOrder (v1, 2));
+	EXPECT_EQ (children.front (), v3);
+	EXPECT_EQ (children.back (), v1);
+	container->forEachChild ([&] (CView* view) {
+		if (view == v3)
+			container->removeView (v3);
+	});
+	EXPECT_EQ (children.size (), 2u);
+	EXPECT_EQ (children.front (), v2);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CViewContainerTest, DrawViewsDrawingOutsideTheirBounds)
+{
+	struct ShadowView : CView
+	{
+		using CView::CView;
+		bool checkUpdate (const CRect& updateRect) const override
+		{
+			return CView::checkUpdate (updateRect) || shadowRect.rectOverlap (updateRect);
+		}
+		void drawRect (CDrawContext* pContext, const CRect& updateRect) override
+		{
+			++numDraws;
+			lastUpdateRect = updateRect;
+		}
+		CRect shadowRect {0, 0, 60, 60};
+		CRect lastUpdateRect;
+		uint32_t numDraws {0};
+	};
+	auto drawContext = COffscreenContext::create ({100., 100.});
+	if (!drawContext)
+		return;
+	auto parent = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto shadowView = new ShadowView (CRect (50, 50, 60, 60));
+	container->addView (new TestView1 ());
+	container->addView (shadowView);
+	container->attached (parent);
+
+	drawContext->beginDraw ();
+	// skipped by its bounds
+	container->drawRect (drawContext, CRect (0, 0, 5, 5));
+	EXPECT_EQ (shadowView->numDraws, 0u);
+	// the flag is picked up by the container the view is already added to
+	shadowView->setDrawsOutsideBounds (true);
+	container->drawRect (drawContext, CRect (0, 0, 5, 5));
+	EXPECT_EQ (shadowView->numDraws, 1u);
+	EXPECT_EQ (shadowView->lastUpdateRect, CRect (0, 0, 5, 5));
+	shadowView->setDrawsOutsideBounds (false);
+	container->drawRect (drawContext, CRect (0, 0, 5, 5));
+	EXPECT_EQ (shadowView->numDraws, 1u);
+	drawContext->endDraw ();
+
+	container->removed (parent);
+}
+
 } // namespaces
@@ -4,6 +4,8 @@
 
 #include "../../../lib/pixelbuffer.h"
 #include "../unittests.h"
+#include <cstdlib>
+#include <vector>
 
 namespace VSTGUI {
 using namespace PixelBuffer;
@@ -92,4 +94,74 @@ TEST_CASE (PixelBufferTest, BGRA_2_ARGB)
 	EXPECT (pixel == 0x44332211);
 }
 
+TEST_CASE (PixelBufferTest, PremultiplyAlpha)
+{
+	uint8_t pixels[] = {200, 100, 50, 128, 255, 255, 255, 255, 10, 20, 30, 0};
+	premultiplyAlpha (pixels, sizeof (pixels), 3, 1, 3);
+	EXPECT (pixels[0] == 100 && pixels[1] == 50 && pixels[2] == 25 && pixels[3] == 128);
+	EXPECT (pixels[4] == 255 && pixels[5] == 255 && pixels[6] == 255 && pixels[7] == 255);
+	EXPECT (pixels[8] == 0 && pixels[9] == 0 && pixels[10] == 0 && pixels[11] == 0);
+}
+
+TEST_CASE (PixelBufferTest, UnpremultiplyAlpha)
+{
+	uint8_t pixels[] = {128, 100, 50, 25, 255, 255, 255, 255, 0, 10, 20, 30};
+	unpremultiplyAlpha (pixels, sizeof (pixels), 3, 1, 0);
+	EXPECT (pixels[0] == 128 && pixels[1] == 199 && pixels[2] == 100 && pixels[3] == 50);
+	EXPECT (pixels[4] == 255 && pixels[5] == 255 && pixels[6] == 255 && pixels[7] == 255);
+	// zero alpha is left unchanged
+	EXPECT (pixels[8] == 0 && pixels[9] == 10 && pixels[10] == 20 && pixels[11] == 30);
+}
+
+TEST_CASE (PixelBufferTest, PremultipliedRoundTripIsLossless)
+{
+	for (auto alphaByteIndex : {0u, 3u})
+	{
+		// every valid premultiplied value for every alpha, the odd width covers the remainder
+		// of vectorized implementations
+		constexpr uint32_t width = 257;
+		std::vector<uint8_t> buffer;
+		for (uint32_t alpha = 0; alpha < 256; ++alpha)
+		{
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				auto value = static_cast<uint8_t> (x * alpha / (width - 1));
+				for (auto i = 0u; i < 4; ++i)
+					buffer.push_back (i == alphaByteIndex ? static_cast<uint8_t> (alpha) : value);
+			}
+		}
+		auto original = buffer;
+		unpremultiplyAlpha (buffer.data (), width * 4, width, 256, alphaByteIndex);
+		premultiplyAlpha (buffer.data (), width * 4, width, 256, alphaByteIndex);
+		EXPECT (buffer == original);
+	}
+}
+
+TEST_CASE (PixelBufferTest, StraightRoundTripPrecision)
+{
+	for (uint32_t alpha = 1; alpha < 256; ++alpha)
+	{
+		std::vector<uint8_t> buffer;
+		for (uint32_t value = 0; value < 256; ++value)
+		{
+			auto v = static_cast<uint8_t> (value);
+			buffer.insert (buffer.end (), {v, v, v, static_cast<uint8_t> (alpha)});
+		}
+		premultiplyAlpha (buffer.data (), 256 * 4, 256, 1, 3);
+		unpremultiplyAlpha (buffer.data (), 256 * 4, 256, 1, 3);
+		// the error is at most the half of a premultiplied step expressed in straight values
+		auto maxError = static_cast<int> (127.5 / alpha + 0.5);
+		for (uint32_t value = 0; value < 256; ++value)
+		{
+			EXPECT (std::abs (buffer[value * 4] - static_cast<int> (value)) <= maxError);
+			EXPECT (buffer[value * 4 + 3] == alpha);
+		}
+		if (alpha == 255)
+		{
+			for (uint32_t value = 0; value < 256; ++value)
+				EXPECT (buffer[value * 4] == value);
+		}
+	}
+}
+
 } // namespace VSTGUI
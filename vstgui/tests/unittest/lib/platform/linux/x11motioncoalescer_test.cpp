@@ -0,0 +1,170 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/x11motioncoalescer.h"
+#include "../../../../../lib/platform/linux/x11utils.h"
+#include "../../../unittests.h"
+#include <xcb/xcb.h>
+
+namespace VSTGUI {
+namespace X11 {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct TestMotionEvent
+{
+	uint32_t event;
+	uint16_t state;
+	int16_t event_x;
+	int16_t event_y;
+};
+
+//------------------------------------------------------------------------
+struct DispatchedEvent
+{
+	TestMotionEvent event;
+	MotionHistory history;
+};
+
+using Coalescer = MotionEventCoalescer<TestMotionEvent>;
+
+//------------------------------------------------------------------------
+struct Dispatcher
+{
+	std::vector<DispatchedEvent> events;
+
+	void operator() (const TestMotionEvent& event, const MotionHistory& history)
+	{
+		events.push_back ({event, history});
+	}
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, BurstIsDispatchedOnce)
+{
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	for (int16_t i = 0; i < 100; ++i)
+		coalescer.add ({1, 0, i, static_cast<int16_t> (i * 2)}, dispatcher);
+	EXPECT (dispatcher.events.empty ());
+	EXPECT (coalescer.hasPendingEvent ());
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 1u);
+	EXPECT_EQ (dispatcher.events[0].event.event_x, 99);
+	EXPECT_EQ (dispatcher.events[0].event.event_y, 198);
+	EXPECT_EQ (dispatcher.events[0].history.size (), 99u);
+	EXPECT_EQ (dispatcher.events[0].history.front (), CPoint (0, 0));
+	EXPECT_EQ (dispatcher.events[0].history.back (), CPoint (98, 196));
+	EXPECT_FALSE (coalescer.hasPendingEvent ());
+
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 1u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, SingleEventHasNoHistory)
+{
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	coalescer.add ({1, 0, 10, 20}, dispatcher);
+	coalescer.flush (dispatcher);
+	coalescer.add ({1, 0, 30, 40}, dispatcher);
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 2u);
+	EXPECT (dispatcher.events[0].history.empty ());
+	EXPECT (dispatcher.events[1].history.empty ());
+	EXPECT_EQ (dispatcher.events[1].event.event_x, 30);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, DifferentWindowsAreNotCoalesced)
+{
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	coalescer.add ({1, 0, 1, 1}, dispatcher);
+	coalescer.add ({1, 0, 2, 2}, dispatcher);
+	coalescer.add ({2, 0, 3, 3}, dispatcher);
+	coalescer.add ({2, 0, 4, 4}, dispatcher);
+	coalescer.add ({1, 0, 5, 5}, dispatcher);
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 3u);
+	EXPECT_EQ (dispatcher.events[0].event.event, 1u);
+	EXPECT_EQ (dispatcher.events[0].event.event_x, 2);
+	EXPECT_EQ (dispatcher.events[0].history.size (), 1u);
+	EXPECT_EQ (dispatcher.events[1].event.event, 2u);
+	EXPECT_EQ (dispatcher.events[1].event.event_x, 4);
+	EXPECT_EQ (dispatcher.events[2].event.event, 1u);
+	EXPECT_EQ (dispatcher.events[2].event.event_x, 5);
+	EXPECT (dispatcher.events[2].history.empty ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, StateChangeIsNotCoalesced)
+{
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	coalescer.add ({1, 0, 1, 1}, dispatcher);
+	coalescer.add ({1, 0x100, 2, 2}, dispatcher);
+	coalescer.add ({1, 0x100, 3, 3}, dispatcher);
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 2u);
+	EXPECT_EQ (dispatcher.events[0].event.state, 0u);
+	EXPECT_EQ (dispatcher.events[1].event.state, 0x100u);
+	EXPECT_EQ (dispatcher.events[1].event.event_x, 3);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, HistoryIsLimited)
+{
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	auto numEvents = static_cast<int16_t> (Coalescer::kMaxHistorySize + 10);
+	for (int16_t i = 0; i < numEvents; ++i)
+		coalescer.add ({1, 0, i, 0}, dispatcher);
+	coalescer.flush (dispatcher);
+	EXPECT_EQ (dispatcher.events.size (), 1u);
+	EXPECT_EQ (dispatcher.events[0].history.size (), Coalescer::kMaxHistorySize);
+	EXPECT_EQ (dispatcher.events[0].history.back (), CPoint (numEvents - 2, 0));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, HoverOnlyBurstsAreAllDispatched)
+{
+	// without any button pressed every burst until the queue is drained must reach the frame,
+	// there is no other event in between to trigger a dispatch
+	Coalescer coalescer;
+	Dispatcher dispatcher;
+	for (int16_t burst = 0; burst < 10; ++burst)
+	{
+		for (int16_t i = 0; i < 5; ++i)
+			coalescer.add ({1, 0, static_cast<int16_t> (burst * 5 + i), 7}, dispatcher);
+		coalescer.flush (dispatcher);
+	}
+	EXPECT_EQ (dispatcher.events.size (), 10u);
+	for (auto index = 0u; index < dispatcher.events.size (); ++index)
+	{
+		const auto& ev = dispatcher.events[index];
+		EXPECT_EQ (ev.event.state, 0u);
+		EXPECT_EQ (ev.event.event_x, static_cast<int16_t> (index * 5 + 4));
+		EXPECT_EQ (ev.history.size (), 4u);
+		EXPECT_EQ (ev.history.front (), CPoint (index * 5, 7));
+	}
+	EXPECT_FALSE (coalescer.hasPendingEvent ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11MotionEventCoalescerTest, WindowReceivesAllMotionEvents)
+{
+	// with motion hints the server only sends the next motion event after the pointer was
+	// queried, hover motion would stop after the first event
+	auto eventMask = ChildWindow::getEventMask ();
+	EXPECT_NE (eventMask & XCB_EVENT_MASK_POINTER_MOTION, 0u);
+	EXPECT_EQ (eventMask & XCB_EVENT_MASK_POINTER_MOTION_HINT, 0u);
+}
+
+} // X11
+} // VSTGUI
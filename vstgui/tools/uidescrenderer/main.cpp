@@ -0,0 +1,256 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmapcache.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/cstring.h"
+#include "vstgui/lib/platform/iplatformbitmap.h"
+#include "vstgui/lib/platform/iplatformfont.h"
+#include "vstgui/lib/platform/platformfactory.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/compresseduidescription.h"
+#include "vstgui/uidescription/cstream.h"
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#include <Shlobj.h>
+#elif LINUX
+#include "vstgui/lib/platform/linux/linuxfactory.h"
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+struct Job
+{
+	std::string templateName;
+	double scaleFactor {1.};
+	std::string outputPath;
+	bool success {false};
+};
+
+//------------------------------------------------------------------------
+std::mutex printMutex;
+
+//------------------------------------------------------------------------
+template <typename... Args>
+void print (const char* format, Args... args)
+{
+	std::lock_guard<std::mutex> guard (printMutex);
+	printf (format, args...);
+}
+
+//------------------------------------------------------------------------
+void printAndTerminate (const char* msg)
+{
+	if (msg)
+		printf ("%s\n", msg);
+	exit (-1);
+}
+
+//------------------------------------------------------------------------
+void printUsage ()
+{
+	printf ("usage: uidescrenderer -i file.uidesc -o outputDirectory [-t templateName]... "
+			"[-s scaleFactor]... [-j numThreads]\n");
+	printf ("renders all templates at scale factor 1 if no template or scale factor is given\n");
+}
+
+//------------------------------------------------------------------------
+std::string makeFileName (const std::string& templateName, double scaleFactor)
+{
+	std::string fileName (templateName);
+	std::replace_if (
+		fileName.begin (), fileName.end (),
+		[] (auto c) { return !(isalnum (static_cast<unsigned char> (c)) || c == '-' || c == '.'); },
+		'_');
+	if (scaleFactor != 1.)
+	{
+		char scaleStr[32];
+		snprintf (scaleStr, sizeof (scaleStr), "_%.1fx", scaleFactor);
+		fileName += scaleStr;
+	}
+	return fileName + ".png";
+}
+
+//------------------------------------------------------------------------
+bool writePNG (CBitmap* bitmap, const std::string& path)
+{
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	if (!platformBitmap)
+		return false;
+	auto buffer = getPlatformFactory ().createBitmapMemoryPNGRepresentation (platformBitmap);
+	if (buffer.empty ())
+		return false;
+	CFileStream stream;
+	if (!stream.open (path.data (), CFileStream::kBinaryMode | CFileStream::kWriteMode |
+										CFileStream::kTruncateMode))
+		return false;
+	return stream.writeRaw (buffer.data (), static_cast<uint32_t> (buffer.size ())) ==
+		   static_cast<uint32_t> (buffer.size ());
+}
+
+//------------------------------------------------------------------------
+bool render (const UIDescription& uiDesc, Job& job)
+{
+	auto view = uiDesc.createView (job.templateName.data (), nullptr);
+	if (!view)
+	{
+		print ("Could not create template %s\n", job.templateName.data ());
+		return false;
+	}
+	CRect size (CPoint (), view->getViewSize ().getSize ());
+	view->setViewSize (size);
+	view->setMouseableArea (size);
+
+	auto frame = new CFrame (size, nullptr);
+	frame->addView (view);
+	SharedPointer<CBitmap> bitmap;
+	if (frame->openHeadless (job.scaleFactor))
+		bitmap = frame->renderOffscreen ();
+	frame->close ();
+
+	if (!bitmap || !writePNG (bitmap, job.outputPath))
+	{
+		print ("Could not render %s\n", job.outputPath.data ());
+		return false;
+	}
+	print ("%s\n", job.outputPath.data ());
+	return true;
+}
+
+//------------------------------------------------------------------------
+void prepareSharedFonts ()
+{
+	// the global fonts are shared by all threads, create their platform fonts before the
+	// workers start so that they are not created concurrently
+	for (auto font : {kSystemFont, kNormalFontVeryBig, kNormalFontBig, kNormalFont,
+					  kNormalFontSmall, kNormalFontSmaller, kNormalFontVerySmall, kSymbolFont})
+		font->getPlatformFont ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main (int argv, char* argc[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	CoInitialize (nullptr);
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	std::string inputPath;
+	std::string outputPath;
+	std::vector<std::string> templateNames;
+	std::vector<double> scaleFactors;
+	uint32_t numThreads = std::max (1u, std::thread::hardware_concurrency ());
+	for (auto i = 1; i < argv; ++i)
+	{
+		UTF8StringView arg (argc[i]);
+		if (arg == "-i" && i + 1 < argv)
+			inputPath = argc[++i];
+		else if (arg == "-o" && i + 1 < argv)
+			outputPath = argc[++i];
+		else if (arg == "-t" && i + 1 < argv)
+			templateNames.emplace_back (argc[++i]);
+		else if (arg == "-s" && i + 1 < argv)
+			scaleFactors.emplace_back (UTF8StringView (argc[++i]).toDouble ());
+		else if (arg == "-j" && i + 1 < argv)
+			numThreads =
+				std::max<uint32_t> (1, static_cast<uint32_t> (UTF8StringView (argc[++i]).toInteger ()));
+		else
+		{
+			printUsage ();
+			return -1;
+		}
+	}
+	if (inputPath.empty () || outputPath.empty ())
+	{
+		printUsage ();
+		return -1;
+	}
+	if (outputPath.back () != '/' && outputPath.back () != '\\')
+		outputPath += '/';
+	if (scaleFactors.empty ())
+		scaleFactors.emplace_back (1.);
+	if (std::any_of (scaleFactors.begin (), scaleFactors.end (), [] (auto s) { return s <= 0.; }))
+		printAndTerminate ("Invalid scale factor!");
+
+#if LINUX
+	// bitmaps are loaded relative to the uidesc file
+	auto separatorPos = inputPath.find_last_of ('/');
+	getPlatformFactory ().asLinuxFactory ()->setResourcePath (
+		separatorPos == std::string::npos ? "./" : inputPath.substr (0, separatorPos + 1));
+#endif
+
+	{
+		CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
+		if (!uiDesc.parse ())
+			printAndTerminate ("Parsing failed!");
+		if (templateNames.empty ())
+		{
+			std::list<const std::string*> names;
+			uiDesc.collectTemplateViewNames (names);
+			for (auto name : names)
+				templateNames.emplace_back (*name);
+		}
+	}
+
+	std::vector<Job> jobs;
+	for (const auto& name : templateNames)
+	{
+		for (auto scaleFactor : scaleFactors)
+			jobs.push_back ({name, scaleFactor, outputPath + makeFileName (name, scaleFactor)});
+	}
+	numThreads = std::min (numThreads, static_cast<uint32_t> (jobs.size ()));
+
+	prepareSharedFonts ();
+	// the workers must not share decoded bitmaps, as the cache and the platform bitmaps are
+	// used from the thread of every worker
+	if (numThreads > 1)
+		CBitmapCache::instance ().setEnabled (false);
+
+	// views are not thread safe, so every worker parses its own copy of the ui description and
+	// renders the jobs it takes from the shared list
+	std::atomic<size_t> nextJob {0};
+	auto worker = [&] () {
+		CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
+		if (!uiDesc.parse ())
+			return;
+		for (auto index = nextJob++; index < jobs.size (); index = nextJob++)
+			jobs[index].success = render (uiDesc, jobs[index]);
+	};
+	std::vector<std::thread> threads;
+	for (auto i = 1u; i < numThreads; ++i)
+		threads.emplace_back (worker);
+	worker ();
+	for (auto& thread : threads)
+		thread.join ();
+
+	auto numFailed = std::count_if (jobs.begin (), jobs.end (), [] (const Job& job) {
+		return !job.success;
+	});
+	VSTGUI::exit ();
+	return numFailed ? -1 : 0;
+}
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../lib/cbitmap.h"
+#include "../../lib/cbitmapcache.h"
 #include "../../lib/cfont.h"
 #include "../../lib/cgradient.h"
 #include "../../lib/platform/platformfactory.h"
@@ -333,14 +334,34 @@ void UIBitmapNode::removeXMLData ()
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::createBitmap (const std::string& str,
-                                     CNinePartTiledDescription* partDesc) const
+CBitmap* UIBitmapNode::createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+                                     CMultiFrameBitmapDescription* multiFrameDesc) const
 {
 	if (partDesc)
 		return new CNinePartTiledBitmap (CResourceDescription (str.c_str ()), *partDesc);
+	if (multiFrameDesc)
+		return new CMultiFrameBitmap (CResourceDescription (str.c_str ()), *multiFrameDesc);
 	return new CBitmap (CResourceDescription (str.c_str ()));
 }
 
+//-----------------------------------------------------------------------------
+bool UIBitmapNode::getMultiFrameDesc (CMultiFrameBitmapDescription& desc) const
+{
+	int32_t numFrames;
+	CPoint frameSize;
+	if (!attributes->getIntegerAttribute ("frames", numFrames) ||
+	    !attributes->getPointAttribute ("frame-size", frameSize))
+		return false;
+	int32_t framesPerRow = 1;
+	attributes->getIntegerAttribute ("frames-per-row", framesPerRow);
+	if (numFrames <= 0 || framesPerRow <= 0)
+		return false;
+	desc.frameSize = frameSize;
+	desc.numFrames = static_cast<uint16_t> (numFrames);
+	desc.framesPerRow = static_cast<uint16_t> (framesPerRow);
+	return true;
+}
+
 //------------------------------------------------------------------------
 UINode* UIBitmapNode::dataNode () const
 {
@@ -357,12 +378,12 @@ PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 		if (codecStr && *codecStr == "base64")
 		{
 			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
-			        result.data.get (), result.dataSize))
+			// the scale factor is part of the cache key, the shared bitmap is not changed
+			double scaleFactor = 0.;
+			attributes->getDoubleAttribute ("scale-factor", scaleFactor);
+			if (auto platformBitmap = CBitmapCache::instance ().loadBitmapFromMemory (
+			        result.data.get (), result.dataSize, scaleFactor))
 			{
-				double scaleFactor = 1.;
-				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
-					platformBitmap->setScaleFactor (scaleFactor);
 				return platformBitmap;
 			}
 		}
@@ -380,6 +401,8 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 		{
 			CNinePartTiledDescription partDesc;
 			CNinePartTiledDescription* partDescPtr = nullptr;
+			CMultiFrameBitmapDescription multiFrameDesc;
+			CMultiFrameBitmapDescription* multiFrameDescPtr = nullptr;
 			CRect offsets;
 			if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
 			{
@@ -387,7 +410,11 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				                                      offsets.bottom);
 				partDescPtr = &partDesc;
 			}
-			bitmap = createBitmap (*path, partDescPtr);
+			else if (getMultiFrameDesc (multiFrameDesc))
+			{
+				multiFrameDescPtr = &multiFrameDesc;
+			}
+			bitmap = createBitmap (*path, partDescPtr, multiFrameDescPtr);
 			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
 			{
 				std::string absPath = pathHint;
@@ -395,7 +422,7 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				{
 					absPath += "/" + *path;
 					if (auto platformBitmap =
-					        getPlatformFactory ().createBitmapFromPath (absPath.c_str ()))
+					        CBitmapCache::instance ().loadBitmapFromPath (absPath.c_str ()))
 					{
 						bitmap->setPlatformBitmap (platformBitmap);
 					}
@@ -413,10 +440,17 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 			double scaleFactor = 1.;
 			if (Detail::decodeScaleFactorFromName (*path, scaleFactor))
 			{
-				bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
+				bitmap->setPlatformBitmapScaleFactor (scaleFactor);
 				attributes->setDoubleAttribute ("scale-factor", scaleFactor);
 			}
 		}
+		if (auto multiFrameBitmap = dynamic_cast<CMultiFrameBitmap*> (bitmap))
+		{
+			// the frame layout can only be verified once the platform bitmap is known
+			CMultiFrameBitmapDescription multiFrameDesc;
+			if (getMultiFrameDesc (multiFrameDesc))
+				multiFrameBitmap->setMultiFrameDesc (multiFrameDesc);
+		}
 	}
 	return bitmap;
 }
@@ -458,6 +492,32 @@ void UIBitmapNode::setNinePartTiledOffset (const CRect* offsets)
 		attributes->removeAttribute ("nineparttiled-offsets");
 }
 
+//-----------------------------------------------------------------------------
+void UIBitmapNode::setMultiFrameDesc (const CMultiFrameBitmapDescription* desc)
+{
+	if (bitmap)
+	{
+		auto* multiFrameBitmap = dynamic_cast<CMultiFrameBitmap*> (bitmap);
+		if (!(desc && multiFrameBitmap && multiFrameBitmap->setMultiFrameDesc (*desc)))
+		{
+			bitmap->forget ();
+			bitmap = nullptr;
+		}
+	}
+	if (desc)
+	{
+		attributes->setIntegerAttribute ("frames", desc->numFrames);
+		attributes->setIntegerAttribute ("frames-per-row", desc->framesPerRow);
+		attributes->setPointAttribute ("frame-size", desc->frameSize);
+	}
+	else
+	{
+		attributes->removeAttribute ("frames");
+		attributes->removeAttribute ("frames-per-row");
+		attributes->removeAttribute ("frame-size");
+	}
+}
+
 //-----------------------------------------------------------------------------
 void UIBitmapNode::invalidBitmap ()
 {
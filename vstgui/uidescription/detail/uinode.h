@@ -125,6 +125,7 @@ public:
 	CBitmap* getBitmap (const std::string& pathHint);
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setNinePartTiledOffset (const CRect* offsets);
+	void setMultiFrameDesc (const CMultiFrameBitmapDescription* desc);
 	void invalidBitmap ();
 	bool getFilterProcessed () const { return filterProcessed; }
 	void setFilterProcessed () { filterProcessed = true; }
@@ -139,7 +140,9 @@ public:
 
 protected:
 	~UIBitmapNode () noexcept override;
-	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc) const;
+	CBitmap* createBitmap (const std::string& str, CNinePartTiledDescription* partDesc,
+	                       CMultiFrameBitmapDescription* multiFrameDesc) const;
+	bool getMultiFrameDesc (CMultiFrameBitmapDescription& desc) const;
 	PlatformBitmapPtr createBitmapFromDataNode () const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
 	UINode* dataNode () const;
@@ -940,7 +940,7 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 		}
 		if (bitmap && bitmapNode->getFilterProcessed () == false)
 		{
-			std::list<SharedPointer<BitmapFilter::IFilter> > filters;
+			BitmapFilter::FilterList filters;
 			for (auto& childNode : bitmapNode->getChildren ())
 			{
 				const std::string* filterName = nullptr;
@@ -1010,18 +1010,7 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 					}
 				}
 			}
-			for (auto& filter : filters)
-			{
-				filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-				if (filter->run ())
-				{
-					auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
-					if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
-					{
-						bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
-					}
-				}
-			}
+			BitmapFilter::runFilters (bitmap, filters);
 			bitmapNode->setFilterProcessed ();
 		}
 		if (bitmap && bitmapNode->getScaledBitmapsAdded () == false)
@@ -1351,6 +1340,21 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIDescription::changeMultiFrameBitmap (UTF8StringPtr name,
+                                            const CMultiFrameBitmapDescription* desc)
+{
+	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
+	auto* node = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
+	if (node && !node->noExport ())
+	{
+		node->setMultiFrameDesc (desc);
+		impl->forEachListener ([this] (UIDescriptionListener* l) {
+			l->onUIDescBitmapChanged (this);
+		});
+	}
+}
+
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
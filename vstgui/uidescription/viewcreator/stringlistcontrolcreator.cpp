@@ -47,6 +47,7 @@ CView* StringListControlCreator::create (const UIAttributes& attributes,
 	auto drawer = makeOwned<StringListControlDrawer> ();
 	control->setDrawer (drawer);
 	auto configurator = makeOwned<StaticListControlConfigurator> (12.);
+	configurator->setUniformRowHeight (true);
 	control->setConfigurator (configurator);
 	return control;
 }
@@ -3,10 +3,12 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "lib/cbitmap.cpp"
+#include "lib/cbitmapcache.cpp"
 #include "lib/cbitmapfilter.cpp"
 #include "lib/ccolor.cpp"
 #include "lib/cdatabrowser.cpp"
 #include "lib/cdrawcontext.cpp"
+#include "lib/cdrawprofiler.cpp"
 #include "lib/cdrawmethods.cpp"
 #include "lib/cdropsource.cpp"
 #include "lib/cfileselector.cpp"
@@ -64,8 +66,10 @@
 #include "lib/animation/animations.cpp"
 #include "lib/animation/animator.cpp"
 #include "lib/animation/timingfunctions.cpp"
+#include "lib/animation/valueanimator.cpp"
 
 #include "lib/platform/platformfactory.cpp"
 #include "lib/platform/common/fileresourceinputstream.cpp"
 #include "lib/platform/common/genericoptionmenu.cpp"
 #include "lib/platform/common/generictextedit.cpp"
+#include "lib/platform/common/headlessframe.cpp"
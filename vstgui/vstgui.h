@@ -7,11 +7,13 @@
 
 #include "lib/vstguibase.h"
 #include "lib/cbitmap.h"
+#include "lib/cbitmapcache.h"
 #include "lib/cbitmapfilter.h"
 #include "lib/cbuttonstate.h"
 #include "lib/ccolor.h"
 #include "lib/cdatabrowser.h"
 #include "lib/cdrawcontext.h"
+#include "lib/cdrawprofiler.h"
 #include "lib/cdrawmethods.h"
 #include "lib/cdropsource.h"
 #include "lib/cfileselector.h"
@@ -65,5 +67,6 @@
 #include "lib/animation/animations.h"
 #include "lib/animation/animator.h"
 #include "lib/animation/timingfunctions.h"
+#include "lib/animation/valueanimator.h"
 
 #endif	// __vstgui__
@@ -7,11 +7,13 @@
 #include "lib/platform/linux/x11platform.cpp"
 #include "lib/platform/linux/x11timer.cpp"
 #include "lib/platform/linux/x11utils.cpp"
+#include "lib/platform/linux/x11viewlayer.cpp"
 
 #include "lib/platform/linux/cairobitmap.cpp"
 #include "lib/platform/linux/cairocontext.cpp"
 #include "lib/platform/linux/cairofont.cpp"
 #include "lib/platform/linux/cairogradient.cpp"
 #include "lib/platform/linux/cairopath.cpp"
+#include "lib/platform/linux/cairotilerenderer.cpp"
 
 #include "lib/platform/linux/linuxfactory.cpp"